@@ -0,0 +1,45 @@
+/*
+ * GeoJSON conversion of a large multipolygon, string round-trip vs direct object conversion
+ *
+ * node --expose-gc bench/geojson.js [polygons = 1000] [vertices per ring = 1000]
+ *
+ * The numbers are ops/s
+ */
+const gdal = require('../lib/gdal.js')
+
+const polygons = parseInt(process.argv[2], 10) || 1000
+const vertices = parseInt(process.argv[3], 10) || 1000
+
+const measure = (name, n, fn) => {
+  if (global.gc) global.gc()
+  const start = process.hrtime.bigint()
+  for (let i = 0; i < n; i++) fn()
+  const ns = Number(process.hrtime.bigint() - start)
+  console.log(`${name.padEnd(48)} ${(n / ns * 1e9).toFixed(2).padStart(10)} ops/s`)
+}
+
+const multipolygon = new gdal.MultiPolygon()
+for (let p = 0; p < polygons; p++) {
+  const ring = new gdal.LinearRing()
+  const cx = (p % 100) * 3
+  const cy = Math.floor(p / 100) * 3
+  for (let v = 0; v < vertices; v++) {
+    const a = 2 * Math.PI * v / vertices
+    ring.points.add(cx + Math.cos(a), cy + Math.sin(a))
+  }
+  ring.closeRings()
+  const polygon = new gdal.Polygon()
+  polygon.rings.add(ring)
+  multipolygon.children.add(polygon)
+}
+console.log(`MultiPolygon with ${polygons} polygons of ${vertices} vertices`)
+
+const iterations = 10
+measure('JSON.parse(geometry.toJSON())', iterations, () => JSON.parse(multipolygon.toJSON()))
+measure('geometry.toObject()', iterations, () => multipolygon.toObject())
+
+const geojson = multipolygon.toObject()
+if (parseFloat(gdal.version) >= 2.3) {
+  measure('Geometry.fromGeoJson()', iterations, () => gdal.Geometry.fromGeoJson(geojson))
+}
+measure('Geometry.fromGeoJsonObject()', iterations, () => gdal.Geometry.fromGeoJsonObject(geojson))
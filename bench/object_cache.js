@@ -0,0 +1,60 @@
+/*
+ * Wrapper creation throughput with a large number of live JS wrappers
+ *
+ * node --expose-gc bench/object_cache.js [live geometries = 1000000]
+ *
+ * Run it on two builds to compare them, the numbers are ops/s
+ */
+const gdal = require('../lib/gdal.js')
+
+const live = parseInt(process.argv[2], 10) || 1000000
+
+const measure = (name, n, fn) => {
+  if (global.gc) global.gc()
+  const start = process.hrtime.bigint()
+  fn(n)
+  const ns = Number(process.hrtime.bigint() - start)
+  console.log(`${name.padEnd(48)} ${String(Math.round(n / ns * 1e9)).padStart(10)} ops/s`)
+}
+
+const geometries = []
+measure(`create ${live} live geometries`, live, (n) => {
+  for (let i = 0; i < n; i++) geometries.push(new gdal.Point(i, i))
+})
+
+// SpatialReference wrappers of the geometries are tracked by the ObjectCache
+const srs = gdal.SpatialReference.fromEPSG(4326)
+const with_srs = Math.min(live, 100000)
+measure(`assign and get ${with_srs} geometry.srs`, with_srs, (n) => {
+  for (let i = 0; i < n; i++) {
+    geometries[i].srs = srs
+    if (!geometries[i].srs) throw new Error('srs was not assigned')
+  }
+})
+
+// Dataset, RasterBand and Layer wrappers, cached lookups and PtrManager registration
+const ds = gdal.open('bench', 'w', 'MEM', 16, 16, 64)
+measure('get cached bands', 1000000, (n) => {
+  for (let i = 0; i < n; i++) ds.bands.get(1 + (i % 64))
+})
+
+const vector = gdal.open('bench', 'w', 'Memory')
+measure('create layers', 10000, (n) => {
+  for (let i = 0; i < n; i++) vector.layers.create(`layer${i}`, null, gdal.Point)
+})
+measure('get cached layers', 1000000, (n) => {
+  for (let i = 0; i < n; i++) vector.layers.get(i % 10000)
+})
+measure('dispose a dataset with 10000 layers', 1, () => {
+  vector.close()
+})
+
+measure('open and close datasets', 10000, (n) => {
+  for (let i = 0; i < n; i++) {
+    const mem = gdal.open('bench', 'w', 'MEM', 1, 1, 4)
+    mem.bands.get(1)
+    mem.close()
+  }
+})
+
+console.log(`${geometries.length} geometries still alive`)
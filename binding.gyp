@@ -18,6 +18,9 @@
 				"src/utils/number_list.cpp",
 				"src/utils/warp_options.cpp",
 				"src/utils/ptr_manager.cpp",
+				"src/utils/reader_pool.cpp",
+				"src/utils/spatial_index.cpp",
+				"src/utils/raster_expression.cpp",
 				"src/node_gdal.cpp",
 				"src/gdal_common.cpp",
 				"src/gdal_dataset.cpp",
@@ -38,9 +41,11 @@
 				"src/gdal_multipolygon.cpp",
 				"src/gdal_layer.cpp",
 				"src/gdal_coordinate_transformation.cpp",
+				"src/gdal_prepared_geometry.cpp",
 				"src/gdal_spatial_reference.cpp",
 				"src/gdal_warper.cpp",
 				"src/gdal_algorithms.cpp",
+				"src/gdal_utils.cpp",
 				"src/collections/dataset_bands.cpp",
 				"src/collections/dataset_layers.cpp",
 				"src/collections/layer_features.cpp",
@@ -54,7 +59,9 @@
 				"src/collections/rasterband_pixels.cpp",
 				"src/collections/gdal_drivers.cpp",
 				"src/async/async_rasterio.cpp",
-				"src/async/async_open.cpp"
+				"src/async/async_open.cpp",
+				"src/async/async_features.cpp",
+				"src/async/async_worker.cpp"
 			],
 			"include_dirs": [
 				"<!(node -e \"require('nan')\")"
@@ -93,6 +100,7 @@
 								"deps/libgdal/arch/win",
 								"deps/libgdal/gdal",
 								"deps/libgdal/gdal/alg",
+								"deps/libgdal/gdal/apps",
 								"deps/libgdal/gdal/gcore",
 								"deps/libgdal/gdal/port",
 								"deps/libgdal/gdal/bridge",
@@ -234,17 +234,6 @@ gdal.FeatureFields.prototype.toJSON = function () {
   return JSON.stringify(this.toObject())
 }
 
-/**
- * Converts the geometry to a GeoJSON object representation.
- *
- * @for gdal.Geometry
- * @method toObject
- * @return {Object} GeoJSON
- */
-gdal.Geometry.prototype.toObject = function () {
-  return JSON.parse(this.toJSON())
-}
-
 /**
  * Iterates through all field definitions using a callback function.
  *
@@ -593,9 +582,59 @@ gdal.open = (function () {
  * @param {object} result result of the asynchronous operation or undefined on error
  */
 
+/**
+ * Progress callback of the asynchronous operations, called in the main thread
+ * @callback ProgressCb
+ * @param {number} complete completion ratio between 0 and 1
+ */
+
 const promisify = require('util').promisify
 const callbackify = require('util').callbackify
 
+const abortError = function () {
+  const err = new Error('Operation aborted')
+  err.name = 'AbortError'
+  return err
+}
+
+/*
+ * Calls a native cancellable async method, its three last arguments being
+ * the cancel flag, the progress callback and the callback. The cancel flag is
+ * an Int32Array set when the AbortSignal-like object `options.signal`
+ * (`aborted` and `addEventListener`) fires.
+ * Returns a Promise unless a callback is given.
+ */
+const callCancellable = function (self, fn, args, options, callback) {
+  const signal = options && options.signal
+  const progress = options && options.progress_cb
+  const promise = new Promise((resolve, reject) => {
+    const flag = new Int32Array(1)
+    const onAbort = () => {
+      flag[0] = 1
+    }
+    if (signal) {
+      if (signal.aborted) {
+        reject(abortError())
+        return
+      }
+      signal.addEventListener('abort', onAbort)
+    }
+    fn.apply(self, args.concat([ flag, progress, (err, result) => {
+      if (signal) signal.removeEventListener('abort', onAbort)
+      if (err) {
+        reject(flag[0] ? abortError() : err instanceof Error ? err : new Error(err))
+      } else {
+        resolve(result)
+      }
+    } ]))
+  })
+  if (callback) {
+    promise.then((r) => process.nextTick(callback, undefined, r), (e) => process.nextTick(callback, e))
+    return undefined
+  }
+  return promise
+}
+
 gdal.Driver.prototype.createAsync = (function () {
   const driverCreateCb = gdal.Driver.prototype.createAsync
   const driverCreatePromise = promisify(gdal.Driver.prototype.createAsync)
@@ -641,6 +680,21 @@ gdal.Driver.prototype.createCopyAsync = (function () {
   }
 })()
 
+gdal.openBufferAsync = (function () {
+  const openBufferCb = gdal.openBufferAsync
+  const openBufferPromise = promisify(gdal.openBufferAsync)
+  return function (buffer, options, callback) {
+    if (typeof arguments[arguments.length - 1] === 'function' && callback === undefined) {
+      callback = arguments[arguments.length - 1]
+      arguments[arguments.length - 1] = undefined
+    }
+    if (callback) {
+      return openBufferCb.call(gdal, buffer, options, callback)
+    }
+    return openBufferPromise.call(gdal, buffer, options)
+  }
+})()
+
 gdal.Driver.prototype.openAsync = (function () {
   const driverOpenCb = gdal.Driver.prototype.openAsync
   const driverOpenPromise = promisify(gdal.Driver.prototype.openAsync)
@@ -855,23 +909,10 @@ gdal.DatasetLayers.prototype.create = (function () {
   }
 })()
 
-function getTypedArrayType(array) {
-  if (array instanceof Uint8Array) return 1 // gdal.GDT_Byte
-  if (array instanceof Int8Array) return 1 // gdal.GDT_Byte
-  if (array instanceof Int16Array) return 3 // gdal.GDT_Int16
-  if (array instanceof Uint16Array) return 2 // gdal.GDT_UInt16
-  if (array instanceof Int32Array) return 5 // gdal.GDT_Int32
-  if (array instanceof Uint32Array) return 4 // gdal.GDT_UInt32
-  if (array instanceof Float32Array) return 6 // gdal.GDT_Float32
-  if (array instanceof Float64Array) return 7 // gdal.GDT_Float64
-  return 0 // gdal.GDT_Unknown
-}
-
 gdal.RasterBandPixels.prototype.read = (function () {
   const read = gdal.RasterBandPixels.prototype.read
   return function (x, y, width, height, data, options) {
     if (!options) options = {}
-    if (data) data._gdal_type = getTypedArrayType(data)
     return read.apply(this, [
       x,
       y,
@@ -880,9 +921,10 @@ gdal.RasterBandPixels.prototype.read = (function () {
       data,
       options.buffer_width,
       options.buffer_height,
-      options.type,
+      options.data_type || options.type,
       options.pixel_space,
-      options.line_space
+      options.line_space,
+      options.offset
     ])
   }
 })()
@@ -897,7 +939,6 @@ gdal.RasterBandPixels.prototype.readAsync = (function () {
       arguments[arguments.length - 1] = undefined
     }
     if (!options) options = {}
-    if (data) data._gdal_type = getTypedArrayType(data)
     if (cb) {
       return readCb.apply(this, [
         x,
@@ -907,9 +948,10 @@ gdal.RasterBandPixels.prototype.readAsync = (function () {
         data,
         options.buffer_width,
         options.buffer_height,
-        options.type,
+        options.data_type || options.type,
         options.pixel_space,
         options.line_space,
+        options.offset,
         cb
       ])
     }
@@ -921,9 +963,10 @@ gdal.RasterBandPixels.prototype.readAsync = (function () {
       data,
       options.buffer_width,
       options.buffer_height,
-      options.type,
+      options.data_type || options.type,
       options.pixel_space,
-      options.line_space
+      options.line_space,
+      options.offset
     ])
   }
 })()
@@ -932,7 +975,6 @@ gdal.RasterBandPixels.prototype.write = (function () {
   const write = gdal.RasterBandPixels.prototype.write
   return function (x, y, width, height, data, options) {
     if (!options) options = {}
-    if (data) data._gdal_type = getTypedArrayType(data)
     return write.apply(this, [
       x,
       y,
@@ -956,7 +998,6 @@ gdal.RasterBandPixels.prototype.writeAsync = (function () {
       arguments[arguments.length - 1] = undefined
     }
     if (!options) options = {}
-    if (data) data._gdal_type = getTypedArrayType(data)
     if (cb) {
       return writeCb.apply(this, [
         x,
@@ -985,18 +1026,233 @@ gdal.RasterBandPixels.prototype.writeAsync = (function () {
   }
 })()
 
-gdal.RasterBandPixels.prototype.readBlock = (function () {
-  const readBlock = gdal.RasterBandPixels.prototype.readBlock
-  return function (x, y, data) {
-    if (data) data._gdal_type = getTypedArrayType(data)
-    return readBlock.apply(this, arguments)
+gdal.LayerFeatures.prototype.nextAsync = (function () {
+  const nextCb = gdal.LayerFeatures.prototype.nextAsync
+  const nextPromise = promisify(gdal.LayerFeatures.prototype.nextAsync)
+  return function (count, cb) {
+    if (typeof arguments[arguments.length - 1] === 'function' && cb === undefined) {
+      cb = arguments[arguments.length - 1]
+      arguments[arguments.length - 1] = undefined
+    }
+    if (cb) {
+      return nextCb.call(this, count, cb)
+    }
+    return nextPromise.call(this, count)
+  }
+})()
+
+gdal.reprojectImageAsync = (function () {
+  const reprojectImageAsync = gdal.reprojectImageAsync
+  return function (options, callback) {
+    return callCancellable(gdal, reprojectImageAsync, [ options ], options, callback)
+  }
+})()
+
+gdal.buildTilePyramidAsync = (function () {
+  const buildTilePyramidAsync = gdal.buildTilePyramidAsync
+  return function (src, options, callback) {
+    return callCancellable(gdal, buildTilePyramidAsync, [ src, options ], options, callback)
+  }
+})()
+
+gdal.polygonizeAsync = (function () {
+  const polygonizeAsync = gdal.polygonizeAsync
+  return function (options, callback) {
+    return callCancellable(gdal, polygonizeAsync, [ options ], options, callback)
+  }
+})()
+
+gdal.fillNodataAsync = (function () {
+  const fillNodataAsync = gdal.fillNodataAsync
+  return function (options, callback) {
+    return callCancellable(gdal, fillNodataAsync, [ options ], options, callback)
+  }
+})()
+
+gdal.contourGenerateAsync = (function () {
+  const contourGenerateAsync = gdal.contourGenerateAsync
+  return function (options, callback) {
+    return callCancellable(gdal, contourGenerateAsync, [ options ], options, callback)
+  }
+})()
+
+gdal.sieveFilterAsync = (function () {
+  const sieveFilterAsync = gdal.sieveFilterAsync
+  return function (options, callback) {
+    return callCancellable(gdal, sieveFilterAsync, [ options ], options, callback)
+  }
+})()
+
+gdal.zonalStatsAsync = (function () {
+  const zonalStatsAsync = gdal.zonalStatsAsync
+  return function (band, layer, options, callback) {
+    if (typeof arguments[arguments.length - 1] === 'function' && callback === undefined) {
+      callback = arguments[arguments.length - 1]
+      arguments[arguments.length - 1] = undefined
+    }
+    return callCancellable(gdal, zonalStatsAsync, [ band, layer, options ], options, callback)
+  }
+})()
+
+gdal.calcAsync = (function () {
+  const calcAsync = gdal.calcAsync
+  return function (inputs, expression, dst, options, callback) {
+    if (typeof arguments[arguments.length - 1] === 'function' && callback === undefined) {
+      callback = arguments[arguments.length - 1]
+      arguments[arguments.length - 1] = undefined
+    }
+    return callCancellable(gdal, calcAsync, [ inputs, expression, dst, options ], options, callback)
+  }
+})()
+
+gdal.rasterizeAsync = (function () {
+  const rasterizeAsync = gdal.rasterizeAsync
+  return function (dst, layer, options, callback) {
+    if (typeof arguments[arguments.length - 1] === 'function' && callback === undefined) {
+      callback = arguments[arguments.length - 1]
+      arguments[arguments.length - 1] = undefined
+    }
+    return callCancellable(gdal, rasterizeAsync, [ dst, layer, options ], options, callback)
+  }
+})()
+
+gdal.gridAsync = (function () {
+  const gridAsync = gdal.gridAsync
+  return function (source, options, dst, callback) {
+    if (typeof arguments[arguments.length - 1] === 'function' && callback === undefined) {
+      callback = arguments[arguments.length - 1]
+      arguments[arguments.length - 1] = undefined
+    }
+    return callCancellable(gdal, gridAsync, [ source, options, dst ], options, callback)
+  }
+})()
+
+gdal.translateAsync = (function () {
+  const translateAsync = gdal.translateAsync
+  return function (destination, source, args, options, callback) {
+    if (typeof arguments[arguments.length - 1] === 'function' && callback === undefined) {
+      callback = arguments[arguments.length - 1]
+      arguments[arguments.length - 1] = undefined
+    }
+    return callCancellable(gdal, translateAsync, [ destination, source, args ], options, callback)
+  }
+})()
+
+gdal.warpAsync = (function () {
+  const warpAsync = gdal.warpAsync
+  return function (destination, sources, args, options, callback) {
+    if (typeof arguments[arguments.length - 1] === 'function' && callback === undefined) {
+      callback = arguments[arguments.length - 1]
+      arguments[arguments.length - 1] = undefined
+    }
+    return callCancellable(gdal, warpAsync, [ destination, sources, args ], options, callback)
+  }
+})()
+
+gdal.buildVRTAsync = (function () {
+  const buildVRTAsync = gdal.buildVRTAsync
+  return function (destination, sources, args, options, callback) {
+    if (typeof arguments[arguments.length - 1] === 'function' && callback === undefined) {
+      callback = arguments[arguments.length - 1]
+      arguments[arguments.length - 1] = undefined
+    }
+    return callCancellable(gdal, buildVRTAsync, [ destination, sources, args ], options, callback)
+  }
+})()
+
+gdal.vectorTranslateAsync = (function () {
+  const vectorTranslateAsync = gdal.vectorTranslateAsync
+  return function (destination, source, args, options, callback) {
+    if (typeof arguments[arguments.length - 1] === 'function' && callback === undefined) {
+      callback = arguments[arguments.length - 1]
+      arguments[arguments.length - 1] = undefined
+    }
+    return callCancellable(gdal, vectorTranslateAsync, [ destination, source, args ], options, callback)
+  }
+})()
+
+gdal.demAsync = (function () {
+  const demAsync = gdal.demAsync
+  return function (destination, source, mode, args, color_file, options, callback) {
+    if (typeof arguments[arguments.length - 1] === 'function' && callback === undefined) {
+      callback = arguments[arguments.length - 1]
+      arguments[arguments.length - 1] = undefined
+    }
+    if (typeof color_file === 'object' && color_file !== null) {
+      options = color_file
+      color_file = undefined
+    }
+    return callCancellable(gdal, demAsync, [ destination, source, mode, args, color_file ], options, callback)
   }
 })()
 
-gdal.RasterBandPixels.prototype.writeBlock = (function () {
-  const writeBlock = gdal.RasterBandPixels.prototype.writeBlock
-  return function (x, y, data) {
-    data._gdal_type = getTypedArrayType(data)
-    return writeBlock.apply(this, arguments)
+gdal.demWindowAsync = (function () {
+  const demWindowAsync = gdal.demWindowAsync
+  return function (source, mode, x, y, width, height, args, color_file, options, callback) {
+    if (typeof arguments[arguments.length - 1] === 'function' && callback === undefined) {
+      callback = arguments[arguments.length - 1]
+      arguments[arguments.length - 1] = undefined
+    }
+    if (typeof color_file === 'object' && color_file !== null) {
+      options = color_file
+      color_file = undefined
+    }
+    return callCancellable(gdal, demWindowAsync,
+      [ source, mode, x, y, width, height, args, color_file ], options, callback)
+  }
+})()
+
+gdal.Dataset.prototype.buildOverviewsAsync = (function () {
+  const buildOverviewsAsync = gdal.Dataset.prototype.buildOverviewsAsync
+  return function (resampling, overviews, bands, options, callback) {
+    if (typeof arguments[arguments.length - 1] === 'function' && callback === undefined) {
+      callback = arguments[arguments.length - 1]
+      arguments[arguments.length - 1] = undefined
+    }
+    return callCancellable(this, buildOverviewsAsync, [ resampling, overviews, bands ], options, callback)
+  }
+})()
+
+gdal.Dataset.prototype.rasterIOAsync = (function () {
+  const rasterIOAsync = gdal.Dataset.prototype.rasterIOAsync
+  return function (x, y, width, height, data, options, callback) {
+    if (typeof arguments[arguments.length - 1] === 'function' && callback === undefined) {
+      callback = arguments[arguments.length - 1]
+      arguments[arguments.length - 1] = undefined
+    }
+    return callCancellable(this, rasterIOAsync, [ x, y, width, height, data, options ], options, callback)
+  }
+})()
+
+gdal.RasterBand.prototype.computeStatisticsAsync = (function () {
+  const computeStatisticsAsync = gdal.RasterBand.prototype.computeStatisticsAsync
+  return function (allow_approximation, options, callback) {
+    if (typeof arguments[arguments.length - 1] === 'function' && callback === undefined) {
+      callback = arguments[arguments.length - 1]
+      arguments[arguments.length - 1] = undefined
+    }
+    return callCancellable(this, computeStatisticsAsync, [ allow_approximation ], options, callback)
+  }
+})()
+
+gdal.RasterBand.prototype.getHistogramAsync = (function () {
+  const getHistogramAsync = gdal.RasterBand.prototype.getHistogramAsync
+  return function (options, callback) {
+    if (typeof arguments[arguments.length - 1] === 'function' && callback === undefined) {
+      callback = arguments[arguments.length - 1]
+      arguments[arguments.length - 1] = undefined
+    }
+    return callCancellable(this, getHistogramAsync, [ options ], options, callback)
+  }
+})()
+
+gdal.RasterBand.prototype.getDefaultHistogramAsync = (function () {
+  const getDefaultHistogramAsync = gdal.RasterBand.prototype.getDefaultHistogramAsync
+  return function (options, callback) {
+    if (typeof arguments[arguments.length - 1] === 'function' && callback === undefined) {
+      callback = arguments[arguments.length - 1]
+      arguments[arguments.length - 1] = undefined
+    }
+    return callCancellable(this, getDefaultHistogramAsync, [ options ], options, callback)
   }
 })()
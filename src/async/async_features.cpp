@@ -0,0 +1,57 @@
+#include "../gdal_common.hpp"
+#include "../gdal_feature.hpp"
+#include "../gdal_layer.hpp"
+
+#include "async_features.hpp"
+
+namespace node_gdal {
+
+const char AsyncNextFeaturesLabel[] = "node-gdal:NextFeatures";
+
+AsyncNextFeatures::AsyncNextFeatures(Nan::Callback *pCallback, Layer *pLayer, int nCount)
+  : Nan::AsyncWorker(pCallback, AsyncNextFeaturesLabel),
+    async_lock(pLayer->async_lock),
+    hLayerPersistentHandle(pLayer->handle()),
+    pLayer(pLayer),
+    nCount(nCount),
+    features() {
+  features.reserve(nCount);
+}
+
+AsyncNextFeatures::~AsyncNextFeatures() {
+  // features that were not handed over to JS (ie on error)
+  for (OGRFeature *feature : features) OGRFeature::DestroyFeature(feature);
+}
+
+void AsyncNextFeatures::Execute() {
+  /* V8 objects are not acessible here */
+  uv_mutex_lock(async_lock);
+  for (int i = 0; i < nCount; i++) {
+    OGRFeature *feature = pLayer->nextFeature();
+    if (!feature) break;
+    features.push_back(feature);
+  }
+  uv_mutex_unlock(async_lock);
+}
+
+void AsyncNextFeatures::HandleOKCallback() {
+  Nan::HandleScope scope;
+
+  Local<Array> results = Nan::New<Array>(features.size());
+  for (unsigned int i = 0; i < features.size(); i++) { Nan::Set(results, i, Feature::New(features[i])); }
+  // the features are now owned by their JS wrappers
+  features.clear();
+
+  hLayerPersistentHandle.Reset();
+  Local<v8::Value> argv[] = {Nan::Undefined(), results};
+  Nan::Call(callback->GetFunction(), Nan::GetCurrentContext()->Global(), 2, argv);
+}
+
+void AsyncNextFeatures::HandleErrorCallback() {
+  Nan::HandleScope scope;
+  hLayerPersistentHandle.Reset();
+  v8::Local<v8::Value> argv[] = {Nan::New(this->ErrorMessage()).ToLocalChecked(), Nan::Undefined()};
+  Nan::Call(callback->GetFunction(), Nan::GetCurrentContext()->Global(), 2, argv);
+}
+
+} // namespace node_gdal
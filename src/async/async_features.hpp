@@ -0,0 +1,50 @@
+#ifndef __NODE_GDAL_ASYNC_FEATURES_H__
+#define __NODE_GDAL_ASYNC_FEATURES_H__
+
+#include <vector>
+
+// node
+#include <node.h>
+#include <node_object_wrap.h>
+
+// nan
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#include <nan.h>
+#pragma GCC diagnostic pop
+
+// ogr
+#include <ogrsf_frmts.h>
+
+#include "../gdal_layer.hpp"
+
+namespace node_gdal {
+
+/**
+ * This class handles async feature iteration
+ *
+ * It reads up to nCount features from the layer's
+ * current reading position and returns them as an array
+ *
+ * It keeps a strong reference on the parent layer
+ * in hLayerPersistentHandle
+ * to protect it from the garbage collector
+ */
+class AsyncNextFeatures : public Nan::AsyncWorker {
+    private:
+  uv_mutex_t *async_lock;
+  Nan::Persistent<v8::Object> hLayerPersistentHandle;
+  Layer *pLayer;
+  int nCount;
+  std::vector<OGRFeature *> features;
+
+    public:
+  explicit AsyncNextFeatures(Nan::Callback *pCallback, Layer *pLayer, int nCount);
+  ~AsyncNextFeatures();
+
+  void Execute();
+  void HandleOKCallback();
+  void HandleErrorCallback();
+};
+} // namespace node_gdal
+#endif
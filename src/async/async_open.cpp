@@ -6,8 +6,11 @@ namespace node_gdal {
 
 const char AsyncOpenLabel[] = "node-gdal:OpenDataset";
 
-AsyncOpen::AsyncOpen(Nan::Callback *pCallback, const std::function<GDALDataset *()> doit)
-  : Nan::AsyncWorker(pCallback, AsyncOpenLabel), doit(doit) {
+AsyncOpen::AsyncOpen(
+  Nan::Callback *pCallback,
+  const std::function<GDALDataset *()> doit,
+  const std::function<v8::Local<v8::Value>(GDALDataset *)> wrap)
+  : Nan::AsyncWorker(pCallback, AsyncOpenLabel), doit(doit), wrap(wrap) {
 }
 
 void AsyncOpen::Execute() {
@@ -19,7 +22,7 @@ void AsyncOpen::Execute() {
 void AsyncOpen::HandleOKCallback() {
   Nan::HandleScope scope;
 
-  Local<v8::Value> argv[] = {Nan::Undefined(), Dataset::New(raw)};
+  Local<v8::Value> argv[] = {Nan::Undefined(), wrap ? wrap(raw) : Dataset::New(raw)};
   Nan::Call(callback->GetFunction(), Nan::GetCurrentContext()->Global(), 2, argv);
 }
 
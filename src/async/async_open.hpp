@@ -29,10 +29,15 @@ namespace node_gdal {
 class AsyncOpen : public Nan::AsyncWorker {
     private:
   std::function<GDALDataset *()> doit;
+  std::function<v8::Local<v8::Value>(GDALDataset *)> wrap;
   GDALDataset *raw;
 
     public:
-  explicit AsyncOpen(Nan::Callback *pCallback, const std::function<GDALDataset *()> doit);
+  // wrap replaces Dataset::New when the new dataset needs more than a wrapper
+  explicit AsyncOpen(
+    Nan::Callback *pCallback,
+    const std::function<GDALDataset *()> doit,
+    const std::function<v8::Local<v8::Value>(GDALDataset *)> wrap = nullptr);
 
   void Execute();
   void HandleOKCallback();
@@ -32,6 +32,8 @@ AsyncRasterIO::AsyncRasterIO(
   )
   : Nan::AsyncWorker(pCallback, AsyncRasterIOLabel),
     async_lock(pBand->async_lock),
+    reader_pool(eRWFlag == GF_Read ? pBand->reader_pool : nullptr),
+    nBand(pBand->get()->GetBand()),
     hDataPersistentHandle(*pObjectData),
     hBandPersistentHandle(pBand->handle()),
     pBand(pBand),
@@ -60,8 +62,10 @@ AsyncRasterIO::AsyncRasterIO(
  * their backing stores are not allocated on the heap
  */
 void AsyncRasterIO::Execute() {
-  uv_mutex_lock(async_lock);
-  eErr = this->pBand->get()->RasterIO(
+  GDALDataset *reader = reader_pool ? reader_pool->acquire() : NULL;
+  GDALRasterBand *band = reader ? reader->GetRasterBand(nBand) : this->pBand->get();
+  if (!reader) uv_mutex_lock(async_lock);
+  eErr = band->RasterIO(
     eRWFlag,
     nXOff,
     nYOff,
@@ -80,7 +84,10 @@ void AsyncRasterIO::Execute() {
   );
 
   if (eErr != CE_None) { this->SetErrorMessage(std::to_string((int)eErr).c_str()); }
-  uv_mutex_unlock(async_lock);
+  if (reader)
+    reader_pool->release(reader);
+  else
+    uv_mutex_unlock(async_lock);
 }
 
 void AsyncRasterIO::HandleOKCallback() {
@@ -14,6 +14,10 @@
 // gdal
 #include <gdal_priv.h>
 
+#include <memory>
+
+#include "../utils/reader_pool.hpp"
+
 namespace node_gdal {
 
 /**
@@ -23,10 +27,15 @@ namespace node_gdal {
  * data and the parent band
  * in hDataPersistentHandle and hBandPersistentHandle
  * to protect them from the garbage collector
+ *
+ * The reads from a dataset opened read-only use a handle
+ * from its ReaderPool when one is available and run in parallel
  */
 class AsyncRasterIO : public Nan::AsyncWorker {
     private:
   uv_mutex_t *async_lock;
+  std::shared_ptr<ReaderPool> reader_pool;
+  int nBand;
   Nan::Persistent<v8::Object> hDataPersistentHandle;
   Nan::Persistent<v8::Object> hBandPersistentHandle;
   RasterBand *pBand;
@@ -0,0 +1,119 @@
+#include "../gdal_common.hpp"
+#include "async_worker.hpp"
+
+#include <algorithm>
+
+namespace node_gdal {
+
+AsyncGDALWorker::AsyncGDALWorker(
+  Nan::Callback *pCallback,
+  const char *label,
+  Local<Value> cancelFlag,
+  Nan::Callback *pProgressCallback,
+  const Job doit,
+  const Result rval)
+  : Nan::AsyncProgressWorkerBase<double>(pCallback, label),
+    doit(doit),
+    rval(rval),
+    cancel_flag(NULL),
+    progress_callback(pProgressCallback),
+    execution_progress(NULL),
+    last_progress(-1),
+    persistent_count(0),
+    eErr(CE_None) {
+  if (cancelFlag->IsInt32Array()) {
+    Nan::TypedArrayContents<GInt32> contents(cancelFlag);
+    if (contents.length() > 0) {
+      persist(cancelFlag);
+      cancel_flag = *contents;
+    }
+  }
+}
+
+AsyncGDALWorker::~AsyncGDALWorker() {
+  if (progress_callback) delete progress_callback;
+}
+
+void AsyncGDALWorker::persist(Local<Value> obj) {
+  SaveToPersistent(persistent_count++, obj);
+}
+
+/*
+ * The flag is written by the JS thread and polled by the worker,
+ * a stale read only delays the cancellation until the next progress report
+ */
+bool AsyncGDALWorker::isCancelled() const {
+  return cancel_flag != NULL && *cancel_flag != 0;
+}
+
+/*
+ * Called by GDAL in the worker thread, or in several threads for a multithreaded warp:
+ * ExecutionProgress::Send is thread-safe and last_progress is atomic,
+ * only the thread that advances it sends the report
+ */
+int CPL_STDCALL AsyncGDALWorker::progress(double dfComplete, const char *, void *pProgressArg) {
+  AsyncGDALWorker *worker = static_cast<AsyncGDALWorker *>(pProgressArg);
+  if (worker->progress_callback && worker->execution_progress) {
+    double last = worker->last_progress.load();
+    while (dfComplete - last >= 0.001 || (dfComplete >= 1 && last < 1)) {
+      if (worker->last_progress.compare_exchange_weak(last, dfComplete)) {
+        worker->execution_progress->Send(&dfComplete, 1);
+        break;
+      }
+    }
+  }
+  return worker->isCancelled() ? FALSE : TRUE;
+}
+
+/*
+ * An operation can involve several datasets sharing or not the same lock,
+ * they are always acquired in the same order to avoid deadlocks
+ */
+void AsyncGDALWorker::lock(std::vector<uv_mutex_t *> &locks) {
+  std::sort(locks.begin(), locks.end());
+  locks.erase(std::unique(locks.begin(), locks.end()), locks.end());
+  for (uv_mutex_t *async_lock : locks) uv_mutex_lock(async_lock);
+}
+
+void AsyncGDALWorker::unlock(std::vector<uv_mutex_t *> &locks) {
+  for (auto it = locks.rbegin(); it != locks.rend(); it++) uv_mutex_unlock(*it);
+}
+
+void AsyncGDALWorker::Execute(const ExecutionProgress &progress) {
+  /* V8 objects are not acessible here */
+  execution_progress = &progress;
+  eErr = doit(AsyncGDALWorker::progress, this);
+  execution_progress = NULL;
+  // an operation that has completed despite a late cancellation still delivers its result
+  if (eErr != CE_None && isCancelled()) {
+    this->SetErrorMessage("Operation aborted");
+  } else if (eErr != CE_None) {
+    const char *msg = CPLGetLastErrorMsg();
+    this->SetErrorMessage(*msg ? msg : "Operation failed");
+  }
+}
+
+void AsyncGDALWorker::HandleProgressCallback(const double *data, size_t count) {
+  Nan::HandleScope scope;
+
+  // only the last report matters
+  if (!progress_callback || data == NULL || count == 0) return;
+  Local<v8::Value> argv[] = {Nan::New<Number>(data[count - 1])};
+  Nan::Call(progress_callback->GetFunction(), Nan::GetCurrentContext()->Global(), 1, argv);
+}
+
+void AsyncGDALWorker::HandleOKCallback() {
+  Nan::HandleScope scope;
+
+  Local<v8::Value> argv[] = {Nan::Undefined(), rval ? rval() : Nan::Undefined().As<Value>()};
+  Nan::Call(callback->GetFunction(), Nan::GetCurrentContext()->Global(), 2, argv);
+}
+
+void AsyncGDALWorker::HandleErrorCallback() {
+  Nan::HandleScope scope;
+
+  v8::Local<v8::Value> argv[] = {Nan::New(this->ErrorMessage()).ToLocalChecked(), Nan::Undefined()};
+  Nan::Call(callback->GetFunction(), Nan::GetCurrentContext()->Global(), 2, argv);
+}
+
+} // namespace node_gdal
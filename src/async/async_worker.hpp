@@ -0,0 +1,80 @@
+#ifndef __NODE_GDAL_ASYNC_WORKER_H__
+#define __NODE_GDAL_ASYNC_WORKER_H__
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+// node
+#include <node.h>
+#include <node_object_wrap.h>
+
+// nan
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#include <nan.h>
+#pragma GCC diagnostic pop
+
+// gdal
+#include <gdal_priv.h>
+
+namespace node_gdal {
+
+/**
+ * This class is the common base of the cancellable async operations
+ *
+ * The caller must provide a lambda that can be executed in
+ * another thread, it receives the GDALProgressFunc and its
+ * argument that must be passed to the GDAL operation,
+ * and optionally a lambda that builds the result in the main thread
+ *
+ * The JS side can pass an Int32Array as cancel flag,
+ * setting its first element to a non-zero value makes the
+ * progress function return FALSE which aborts the GDAL operation
+ *
+ * An optional JS progress callback receives the completion ratio,
+ * the reports from the worker thread are coalesced and delivered
+ * asynchronously in the main thread
+ *
+ * The cancel flag and the JS objects registered with persist()
+ * are protected from the garbage collector until completion
+ */
+class AsyncGDALWorker : public Nan::AsyncProgressWorkerBase<double> {
+    public:
+  typedef std::function<CPLErr(GDALProgressFunc, void *)> Job;
+  typedef std::function<Local<Value>()> Result;
+
+    private:
+  Job doit;
+  Result rval;
+  volatile GInt32 *cancel_flag;
+  Nan::Callback *progress_callback;
+  const ExecutionProgress *execution_progress;
+  std::atomic<double> last_progress;
+  uint32_t persistent_count;
+  CPLErr eErr;
+
+    public:
+  explicit AsyncGDALWorker(
+    Nan::Callback *pCallback,
+    const char *label,
+    Local<Value> cancelFlag,
+    Nan::Callback *pProgressCallback,
+    const Job doit,
+    const Result rval = nullptr);
+  ~AsyncGDALWorker();
+
+  void persist(Local<Value> obj);
+  bool isCancelled() const;
+
+  static int CPL_STDCALL progress(double dfComplete, const char *pszMessage, void *pProgressArg);
+  static void lock(std::vector<uv_mutex_t *> &locks);
+  static void unlock(std::vector<uv_mutex_t *> &locks);
+
+  void Execute(const ExecutionProgress &progress);
+  void HandleProgressCallback(const double *data, size_t count);
+  void HandleOKCallback();
+  void HandleErrorCallback();
+};
+} // namespace node_gdal
+#endif
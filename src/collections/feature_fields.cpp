@@ -80,7 +80,7 @@ NAN_METHOD(FeatureFields::toString) {
   info.GetReturnValue().Set(Nan::New("FeatureFields").ToLocalChecked());
 }
 
-inline bool setField(OGRFeature *f, int field_index, Local<Value> val) {
+bool FeatureFields::set(OGRFeature *f, int field_index, Local<Value> val) {
   if (val->IsInt32()) {
     f->SetField(field_index, Nan::To<int32_t>(val).ToChecked());
   } else if (val->IsNumber()) {
@@ -138,7 +138,7 @@ NAN_METHOD(FeatureFields::set) {
 
       for (i = 0; i < n; i++) {
         Local<Value> val = Nan::Get(values, i).ToLocalChecked();
-        if (setField(f->get(), i, val)) {
+        if (set(f->get(), i, val)) {
           Nan::ThrowError("Unsupported type of field value");
           return;
         }
@@ -170,7 +170,7 @@ NAN_METHOD(FeatureFields::set) {
         }
 
         Local<Value> val = Nan::Get(values, Nan::New(field_name).ToLocalChecked()).ToLocalChecked();
-        if (setField(f->get(), field_index, val)) {
+        if (set(f->get(), field_index, val)) {
           Nan::ThrowError("Unsupported type of field value");
           return;
         }
@@ -190,7 +190,7 @@ NAN_METHOD(FeatureFields::set) {
     ARG_FIELD_ID(0, f->get(), field_index);
 
     // set field value
-    if (setField(f->get(), field_index, info[1])) {
+    if (set(f->get(), field_index, info[1])) {
       Nan::ThrowError("Unsupported type of field value");
       return;
     }
@@ -255,7 +255,7 @@ NAN_METHOD(FeatureFields::reset) {
     if (field_index == -1) continue;
 
     Local<Value> val = Nan::Get(values, Nan::New(field_name).ToLocalChecked()).ToLocalChecked();
-    if (setField(f->get(), field_index, val)) {
+    if (set(f->get(), field_index, val)) {
       Nan::ThrowError("Unsupported type of field value");
       return;
     }
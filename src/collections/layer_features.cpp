@@ -1,7 +1,16 @@
 #include "layer_features.hpp"
 #include "../gdal_common.hpp"
 #include "../gdal_feature.hpp"
+#include "../gdal_geometry.hpp"
 #include "../gdal_layer.hpp"
+#include "feature_fields.hpp"
+#include "../async/async_features.hpp"
+#include "../utils/typed_array.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
 
 namespace node_gdal {
 
@@ -17,10 +26,13 @@ void LayerFeatures::Initialize(Local<Object> target) {
   Nan::SetPrototypeMethod(lcons, "toString", toString);
   Nan::SetPrototypeMethod(lcons, "count", count);
   Nan::SetPrototypeMethod(lcons, "add", add);
+  Nan::SetPrototypeMethod(lcons, "addBatch", addBatch);
   Nan::SetPrototypeMethod(lcons, "get", get);
   Nan::SetPrototypeMethod(lcons, "set", set);
   Nan::SetPrototypeMethod(lcons, "first", first);
   Nan::SetPrototypeMethod(lcons, "next", next);
+  Nan::SetPrototypeMethod(lcons, "nextAsync", nextAsync);
+  Nan::SetPrototypeMethod(lcons, "readBatch", readBatch);
   Nan::SetPrototypeMethod(lcons, "remove", remove);
 
   ATTR_DONT_ENUM(lcons, "layer", layerGetter, READ_ONLY_SETTER);
@@ -104,7 +116,9 @@ NAN_METHOD(LayerFeatures::get) {
 
   int feature_id;
   NODE_ARG_INT(0, "feature id", feature_id);
+  uv_mutex_lock(layer->async_lock);
   OGRFeature *feature = layer->get()->GetFeature(feature_id);
+  uv_mutex_unlock(layer->async_lock);
 
   info.GetReturnValue().Set(Feature::New(feature));
 }
@@ -127,8 +141,11 @@ NAN_METHOD(LayerFeatures::first) {
     return;
   }
 
+  uv_mutex_lock(layer->async_lock);
   layer->get()->ResetReading();
+  layer->dropPendingFeature();
   OGRFeature *feature = layer->get()->GetNextFeature();
+  uv_mutex_unlock(layer->async_lock);
 
   info.GetReturnValue().Set(Feature::New(feature));
 }
@@ -154,11 +171,361 @@ NAN_METHOD(LayerFeatures::next) {
     return;
   }
 
-  OGRFeature *feature = layer->get()->GetNextFeature();
+  uv_mutex_lock(layer->async_lock);
+  OGRFeature *feature = layer->nextFeature();
+  uv_mutex_unlock(layer->async_lock);
 
   info.GetReturnValue().Set(Feature::New(feature));
 }
 
+/**
+ * Asynchronously reads the next features in the layer.
+ * The features are fetched in a background thread and returned as an array
+ * of up to `count` features. An empty array means there are no more features.
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ *
+ * @example
+ * ```
+ * let features;
+ * while ((features = await layer.features.nextAsync(1000)).length) { ... }```
+ *
+ * @method nextAsync
+ * @param {Integer} [count=1] Maximum number of features to read
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter, can be specified even if
+ * certain optional parameters are omitted
+ * @return {gdal.Feature[]}
+ */
+NAN_METHOD(LayerFeatures::nextAsync) {
+  Nan::HandleScope scope;
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(parent);
+  if (!layer->isAlive()) {
+    Nan::ThrowError("Layer object already destroyed");
+    return;
+  }
+
+  int count = 1;
+  Nan::Callback *callback;
+  NODE_ARG_INT_OPT(0, "count", count);
+  if (count < 1) {
+    Nan::ThrowRangeError("count must be greater than 0");
+    return;
+  }
+  NODE_ARG_CB(1, "callback", callback);
+
+  Nan::AsyncQueueWorker(new AsyncNextFeatures(callback, layer, count));
+}
+
+// column accumulated by readBatch() before being handed over to V8
+struct BatchColumn {
+  int index;
+  OGRFieldType type;
+  std::vector<GInt32> integers;
+  std::vector<double> reals;
+  std::vector<GUInt32> offsets;
+  std::string bytes;
+  std::vector<GByte> valid;
+};
+
+/*
+ * Whether the variable-length values of a feature can be appended to the batch,
+ * the offsets are 32-bit
+ */
+static bool fitsInBatch(OGRFeature *feature, const std::vector<BatchColumn> &columns, size_t geom_size) {
+  for (const BatchColumn &column : columns) {
+    if (column.type == OFTInteger || column.type == OFTReal) continue;
+#if GDAL_VERSION_MAJOR > 1
+    if (column.type == OFTInteger64) continue;
+#endif
+    if (!feature->IsFieldSet(column.index)) continue;
+    size_t size;
+    if (column.type == OFTBinary) {
+      int binary_size;
+      feature->GetFieldAsBinary(column.index, &binary_size);
+      size = binary_size;
+    } else {
+      size = strlen(feature->GetFieldAsString(column.index));
+    }
+    if (column.bytes.size() + size > UINT32_MAX) return false;
+  }
+  OGRGeometry *geom = feature->GetGeometryRef();
+  return geom == NULL || geom_size + geom->WkbSize() <= UINT32_MAX;
+}
+
+static Local<Value> copyToTypedArray(GDALDataType type, const void *data, size_t length) {
+  Nan::EscapableHandleScope scope;
+
+  Local<Value> array = TypedArray::New(type, length);
+  if (array.IsEmpty() || !array->IsObject()) return scope.Escape(array);
+  if (length > 0) {
+    void *dst = TypedArray::Validate(array.As<Object>(), type, length);
+    if (dst == NULL) return scope.Escape(Nan::Undefined());
+    memcpy(dst, data, length * GDALGetDataTypeSize(type) / 8);
+  }
+
+  return scope.Escape(array);
+}
+
+/**
+ * Reads up to `batchSize` features starting at the current reading position
+ * and returns them in columnar form, without creating a {{#crossLink
+ * "gdal.Feature"}}Feature{{/crossLink}} object per row. The reading position is
+ * shared with {{#crossLink "gdal.LayerFeatures/next:method"}}next(){{/crossLink}},
+ * so consecutive calls return consecutive batches; a batch with a `count` of 0
+ * means there are no more features.
+ *
+ * Every field column is an object with a `type` and a `valid` Uint8Array
+ * (0 for unset fields):
+ * - `integer` fields are returned in an Int32Array `data`
+ * - `integer64` and `real` fields are returned in a Float64Array `data`
+ *   (64-bit integers above 2^53 lose precision)
+ * - `binary` fields and all other field types (`string`, dates, lists), formatted
+ *   as strings, are returned as a Buffer `data` and a Uint32Array `offsets` of
+ *   `count + 1` elements, the value of row `i` being
+ *   `data.slice(offsets[i], offsets[i + 1])`
+ *
+ * The geometries are returned as little-endian WKB using the same `offsets` /
+ * `data` layout, a row without a geometry having a zero length.
+ *
+ * A batch holds fewer than `batchSize` features when the `data` of a column would
+ * exceed 4 GB, the next call continues with the feature that did not fit.
+ *
+ * @example
+ * ```
+ * layer.features.first();
+ * let batch;
+ * while ((batch = layer.features.readBatch({batchSize: 10000, fields: ['name', 'pop']})).count) {
+ *   const name = batch.fields.name, pop = batch.fields.pop.data;
+ *   for (let i = 0; i < batch.count; i++) {
+ *     console.log(name.data.toString('utf8', name.offsets[i], name.offsets[i + 1]), pop[i]);
+ *   }
+ * }```
+ *
+ * @method readBatch
+ * @throws Error
+ * @param {Object} [options]
+ * @param {Integer} [options.batchSize=1000] Maximum number of features to read
+ * @param {String[]} [options.fields] Names of the fields to export, all fields by default
+ * @param {Boolean} [options.geometry=true] Export the geometries
+ * @return {Object} `{count: Integer, fids: Float64Array, fields: Object,
+ * geometry: {offsets: Uint32Array, data: Buffer}}`
+ */
+NAN_METHOD(LayerFeatures::readBatch) {
+  Nan::HandleScope scope;
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(parent);
+  if (!layer->isAlive()) {
+    Nan::ThrowError("Layer object already destroyed");
+    return;
+  }
+
+  int batch_size = 1000;
+  bool with_geometry = true;
+  Local<Array> field_names;
+  bool all_fields = true;
+
+  if (info.Length() > 0 && !info[0]->IsUndefined() && !info[0]->IsNull()) {
+    Local<Object> options;
+    NODE_ARG_OBJECT(0, "options", options);
+    NODE_INT_FROM_OBJ_OPT(options, "batchSize", batch_size);
+    NODE_BOOL_FROM_OBJ_OPT(options, "geometry", with_geometry);
+
+    Local<String> sym = Nan::New("fields").ToLocalChecked();
+    if (Nan::HasOwnProperty(options, sym).FromMaybe(false)) {
+      Local<Value> val = Nan::Get(options, sym).ToLocalChecked();
+      if (val->IsArray()) {
+        field_names = val.As<Array>();
+        all_fields = false;
+      } else if (!val->IsNull() && !val->IsUndefined()) {
+        Nan::ThrowTypeError("Property \"fields\" must be an array of field names");
+        return;
+      }
+    }
+  }
+  if (batch_size < 1) {
+    Nan::ThrowRangeError("batchSize must be greater than 0");
+    return;
+  }
+
+  OGRLayer *ogr_layer = layer->get();
+  OGRFeatureDefn *defn = ogr_layer->GetLayerDefn();
+  // batchSize can be huge to read everything, the vectors grow past this
+  int reserved = std::min(batch_size, 65536);
+
+  std::vector<BatchColumn> columns;
+  std::vector<std::string> names;
+  int n_columns = all_fields ? defn->GetFieldCount() : field_names->Length();
+  columns.resize(n_columns);
+  for (int i = 0; i < n_columns; i++) {
+    if (all_fields) {
+      columns[i].index = i;
+    } else {
+      Local<Value> name = Nan::Get(field_names, i).ToLocalChecked();
+      if (!name->IsString()) {
+        Nan::ThrowTypeError("Field names must be strings");
+        return;
+      }
+      columns[i].index = defn->GetFieldIndex(*Nan::Utf8String(name));
+      if (columns[i].index < 0) {
+        std::string err = std::string("Specified field name does not exist: ") + *Nan::Utf8String(name);
+        Nan::ThrowError(err.c_str());
+        return;
+      }
+    }
+    OGRFieldDefn *field_defn = defn->GetFieldDefn(columns[i].index);
+    names.push_back(field_defn->GetNameRef());
+    columns[i].type = field_defn->GetType();
+    columns[i].valid.reserve(reserved);
+    switch (columns[i].type) {
+      case OFTInteger: columns[i].integers.reserve(reserved); break;
+#if GDAL_VERSION_MAJOR > 1
+      case OFTInteger64:
+#endif
+      case OFTReal: columns[i].reals.reserve(reserved); break;
+      default:
+        columns[i].offsets.reserve(reserved + 1);
+        columns[i].offsets.push_back(0);
+        break;
+    }
+  }
+
+  std::vector<double> fids;
+  std::vector<GUInt32> geom_offsets;
+  std::vector<GByte> geom_data;
+  fids.reserve(reserved);
+  if (with_geometry) {
+    geom_offsets.reserve(reserved + 1);
+    geom_offsets.push_back(0);
+  }
+
+  bool too_large = false;
+  uv_mutex_lock(layer->async_lock);
+  for (int n = 0; n < batch_size; n++) {
+    OGRFeature *feature = layer->nextFeature();
+    if (feature == NULL) break;
+
+    // the batch stops before its data exceeds 4 GB, the feature is kept for the next read
+    if (!fitsInBatch(feature, columns, with_geometry ? geom_data.size() : 0)) {
+      layer->pending_feature = feature;
+      too_large = n == 0;
+      break;
+    }
+
+    fids.push_back((double)feature->GetFID());
+
+    for (int i = 0; i < n_columns; i++) {
+      BatchColumn &column = columns[i];
+      bool is_set = feature->IsFieldSet(column.index);
+      column.valid.push_back(is_set ? 1 : 0);
+      switch (column.type) {
+        case OFTInteger: column.integers.push_back(is_set ? feature->GetFieldAsInteger(column.index) : 0); break;
+#if GDAL_VERSION_MAJOR > 1
+        case OFTInteger64:
+          column.reals.push_back(is_set ? (double)feature->GetFieldAsInteger64(column.index) : 0);
+          break;
+#endif
+        case OFTReal: column.reals.push_back(is_set ? feature->GetFieldAsDouble(column.index) : 0); break;
+        case OFTBinary:
+          if (is_set) {
+            int size;
+            GByte *data = feature->GetFieldAsBinary(column.index, &size);
+            column.bytes.append((const char *)data, size);
+          }
+          column.offsets.push_back(column.bytes.size());
+          break;
+        default:
+          if (is_set) column.bytes.append(feature->GetFieldAsString(column.index));
+          column.offsets.push_back(column.bytes.size());
+          break;
+      }
+    }
+
+    if (with_geometry) {
+      OGRGeometry *geom = feature->GetGeometryRef();
+      if (geom != NULL) {
+        size_t offset = geom_data.size();
+        geom_data.resize(offset + geom->WkbSize());
+        geom->exportToWkb(wkbNDR, &geom_data[offset]);
+      }
+      geom_offsets.push_back(geom_data.size());
+    }
+
+    OGRFeature::DestroyFeature(feature);
+  }
+  uv_mutex_unlock(layer->async_lock);
+  if (too_large) {
+    Nan::ThrowRangeError("The data of the next feature exceeds 4 GB");
+    return;
+  }
+
+  size_t count = fids.size();
+
+  Local<Object> result = Nan::New<Object>();
+  Nan::Set(result, Nan::New("count").ToLocalChecked(), Nan::New<Integer>((uint32_t)count));
+  Nan::Set(result, Nan::New("fids").ToLocalChecked(), copyToTypedArray(GDT_Float64, fids.data(), count));
+
+  Local<Object> fields = Nan::New<Object>();
+  for (int i = 0; i < n_columns; i++) {
+    BatchColumn &column = columns[i];
+    Local<Object> obj = Nan::New<Object>();
+    const char *type;
+    switch (column.type) {
+      case OFTInteger:
+        type = "integer";
+        Nan::Set(obj, Nan::New("data").ToLocalChecked(), copyToTypedArray(GDT_Int32, column.integers.data(), count));
+        break;
+#if GDAL_VERSION_MAJOR > 1
+      case OFTInteger64:
+#endif
+      case OFTReal:
+#if GDAL_VERSION_MAJOR > 1
+        type = column.type == OFTInteger64 ? "integer64" : "real";
+#else
+        type = "real";
+#endif
+        Nan::Set(obj, Nan::New("data").ToLocalChecked(), copyToTypedArray(GDT_Float64, column.reals.data(), count));
+        break;
+      default:
+        type = column.type == OFTBinary ? "binary" : "string";
+        Nan::Set(
+          obj,
+          Nan::New("offsets").ToLocalChecked(),
+          copyToTypedArray(GDT_UInt32, column.offsets.data(), column.offsets.size()));
+        Nan::Set(
+          obj,
+          Nan::New("data").ToLocalChecked(),
+          Nan::CopyBuffer(column.bytes.data(), column.bytes.size()).ToLocalChecked());
+        break;
+    }
+    Nan::Set(obj, Nan::New("type").ToLocalChecked(), Nan::New(type).ToLocalChecked());
+    Nan::Set(obj, Nan::New("valid").ToLocalChecked(), copyToTypedArray(GDT_Byte, column.valid.data(), count));
+    Nan::Set(fields, Nan::New(names[i]).ToLocalChecked(), obj);
+  }
+  Nan::Set(result, Nan::New("fields").ToLocalChecked(), fields);
+
+  if (with_geometry) {
+    Local<Object> geometry = Nan::New<Object>();
+    Nan::Set(
+      geometry,
+      Nan::New("offsets").ToLocalChecked(),
+      copyToTypedArray(GDT_UInt32, geom_offsets.data(), geom_offsets.size()));
+    Nan::Set(
+      geometry,
+      Nan::New("data").ToLocalChecked(),
+      Nan::CopyBuffer((const char *)geom_data.data(), geom_data.size()).ToLocalChecked());
+    Nan::Set(result, Nan::New("geometry").ToLocalChecked(), geometry);
+  } else {
+    Nan::Set(result, Nan::New("geometry").ToLocalChecked(), Nan::Null());
+  }
+
+  info.GetReturnValue().Set(result);
+}
+
 /**
  * Adds a feature to the layer. The feature should be created using the current
  * layer as the definition.
@@ -188,7 +555,10 @@ NAN_METHOD(LayerFeatures::add) {
   Feature *f;
   NODE_ARG_WRAPPED(0, "feature", Feature, f)
 
+  uv_mutex_lock(layer->async_lock);
   int err = layer->get()->CreateFeature(f->get());
+  uv_mutex_unlock(layer->async_lock);
+  layer->spatial_index.reset();
   if (err) {
     NODE_THROW_OGRERR(err);
     return;
@@ -217,7 +587,434 @@ NAN_METHOD(LayerFeatures::count) {
   int force = 1;
   NODE_ARG_BOOL_OPT(0, "force", force);
 
-  info.GetReturnValue().Set(Nan::New<Number>(layer->get()->GetFeatureCount(force)));
+  uv_mutex_lock(layer->async_lock);
+  GIntBig count = layer->get()->GetFeatureCount(force);
+  uv_mutex_unlock(layer->async_lock);
+
+  info.GetReturnValue().Set(Nan::New<Number>(count));
+}
+
+// column of values consumed by addBatch()
+struct BatchSource {
+  enum Kind { JS_ARRAY, FLOAT64, FLOAT32, INT32, UINT32, INT16, UINT16, UINT8, BYTES };
+
+  Kind kind;
+  Local<Array> array;
+  const void *data;
+  const GUInt32 *offsets;
+  const GByte *valid;
+  size_t length;
+  // set when a getter has thrown, the exception is left pending
+  bool exception;
+
+  BatchSource() : kind(JS_ARRAY), data(NULL), offsets(NULL), valid(NULL), length(0), exception(false) {
+  }
+
+  // returns false if the value cannot be used as a column
+  bool parse(Local<Value> val) {
+    if (val->IsArray()) {
+      kind = JS_ARRAY;
+      array = val.As<Array>();
+      length = array->Length();
+    } else if (val->IsFloat64Array()) {
+      useContents<double>(val, FLOAT64);
+    } else if (val->IsFloat32Array()) {
+      useContents<float>(val, FLOAT32);
+    } else if (val->IsInt32Array()) {
+      useContents<GInt32>(val, INT32);
+    } else if (val->IsUint32Array()) {
+      useContents<GUInt32>(val, UINT32);
+    } else if (val->IsInt16Array()) {
+      useContents<GInt16>(val, INT16);
+    } else if (val->IsUint16Array()) {
+      useContents<GUInt16>(val, UINT16);
+    } else if (val->IsUint8Array()) {
+      useContents<GByte>(val, UINT8);
+    } else if (val->IsObject() && !val->IsNull()) {
+      // {data, offsets, valid} as returned by readBatch()
+      Local<Object> obj = val.As<Object>();
+      Local<Value> valid_val, offsets_val, data_val;
+      if (
+        !Nan::Get(obj, Nan::New("valid").ToLocalChecked()).ToLocal(&valid_val) ||
+        !Nan::Get(obj, Nan::New("offsets").ToLocalChecked()).ToLocal(&offsets_val) ||
+        !Nan::Get(obj, Nan::New("data").ToLocalChecked()).ToLocal(&data_val)) {
+        exception = true;
+        return false;
+      }
+      if (offsets_val->IsUint32Array()) {
+        if (!data_val->IsUint8Array()) return false;
+        Nan::TypedArrayContents<GUInt32> offsets_contents(offsets_val);
+        Nan::TypedArrayContents<GByte> data_contents(data_val);
+        if (offsets_contents.length() < 1) return false;
+        kind = BYTES;
+        offsets = *offsets_contents;
+        data = *data_contents;
+        length = offsets_contents.length() - 1;
+        // the values are read as data[offsets[i]] to data[offsets[i + 1]]
+        for (size_t i = 0; i < length; i++) {
+          if (offsets[i] > offsets[i + 1]) return false;
+        }
+        if (offsets[length] > data_contents.length()) return false;
+      } else if (data_val->IsArray() || data_val->IsTypedArray()) {
+        if (!parse(data_val)) return false;
+      } else {
+        return false;
+      }
+      if (valid_val->IsUint8Array()) {
+        Nan::TypedArrayContents<GByte> valid_contents(valid_val);
+        if (valid_contents.length() < length) return false;
+        valid = *valid_contents;
+      }
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  template <typename T> void useContents(Local<Value> val, Kind k) {
+    Nan::TypedArrayContents<T> contents(val);
+    kind = k;
+    data = *contents;
+    length = contents.length();
+  }
+
+  double number(size_t i) {
+    switch (kind) {
+      case FLOAT64: return static_cast<const double *>(data)[i];
+      case FLOAT32: return static_cast<const float *>(data)[i];
+      case INT32: return static_cast<const GInt32 *>(data)[i];
+      case UINT32: return static_cast<const GUInt32 *>(data)[i];
+      case INT16: return static_cast<const GInt16 *>(data)[i];
+      case UINT16: return static_cast<const GUInt16 *>(data)[i];
+      case UINT8: return static_cast<const GByte *>(data)[i];
+      default: return 0;
+    }
+  }
+
+  // returns false if the value has an unsupported type
+  bool setField(OGRFeature *feature, int field_index, size_t i) {
+    if (valid != NULL && !valid[i]) return true;
+
+    switch (kind) {
+      case JS_ARRAY: {
+        Local<Value> val;
+        if (!Nan::Get(array, i).ToLocal(&val)) {
+          exception = true;
+          return false;
+        }
+        return !FeatureFields::set(feature, field_index, val);
+      }
+      case BYTES: {
+        const char *bytes = static_cast<const char *>(data) + offsets[i];
+        int size = offsets[i + 1] - offsets[i];
+        if (feature->GetFieldDefnRef(field_index)->GetType() == OFTBinary) {
+          feature->SetField(field_index, size, (GByte *)bytes);
+        } else {
+          feature->SetField(field_index, std::string(bytes, size).c_str());
+        }
+        return true;
+      }
+      default: {
+        double value = number(i);
+        switch (feature->GetFieldDefnRef(field_index)->GetType()) {
+          case OFTInteger: feature->SetField(field_index, (int)value); break;
+#if GDAL_VERSION_MAJOR > 1
+          case OFTInteger64: feature->SetField(field_index, (GIntBig)value); break;
+#endif
+          default: feature->SetField(field_index, value); break;
+        }
+        return true;
+      }
+    }
+  }
+};
+
+/**
+ * Creates many features at once from columnar arrays or from an array of
+ * plain objects, without creating a {{#crossLink "gdal.Feature"}}Feature{{/crossLink}}
+ * object per row.
+ *
+ * The columnar form is an object with a `fields` object holding one column per
+ * field name and an optional `geometry` column:
+ * - a field column is an Array, a TypedArray, or an object with `offsets` and
+ *   `data` (strings or binary data), optionally with a `valid` Uint8Array
+ *   (0 to leave the field unset), the offsets must not decrease and must be within `data`
+ * - the geometry column is an Array of {{#crossLink "gdal.Geometry"}}Geometry{{/crossLink}}
+ *   objects (or `null`) or WKB in the `offsets` / `data` layout
+ *
+ * This is the layout returned by {{#crossLink "gdal.LayerFeatures/readBatch:method"}}readBatch(){{/crossLink}},
+ * so a batch read from one layer can be written to another layer with the same fields.
+ * In the array form, each element is a plain object of field values and an
+ * optional `geometry` property holding a {{#crossLink "gdal.Geometry"}}Geometry{{/crossLink}}
+ * object (or `null`).
+ *
+ * The features are created in transactions of `transactionSize` features.
+ * If a feature cannot be created, the current transaction is rolled back and an
+ * error is thrown, the features of the previously committed transactions are kept.
+ *
+ * @example
+ * ```
+ * layer.features.addBatch({
+ *   fields: {name: ['a', 'b'], pop: new Int32Array([1, 2])},
+ *   geometry: [new gdal.Point(0, 0), new gdal.Point(1, 1)]
+ * });
+ * layer.features.addBatch([{name: 'c', pop: 3, geometry: new gdal.Point(2, 2)}]);```
+ *
+ * @method addBatch
+ * @throws Error
+ * @param {Object|Object[]} features
+ * @param {Object} [options]
+ * @param {Integer} [options.transactionSize=1000] Number of features per transaction, `0` to disable transactions
+ * @return {Integer} Number of features created
+ */
+NAN_METHOD(LayerFeatures::addBatch) {
+  Nan::HandleScope scope;
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(parent);
+  if (!layer->isAlive()) {
+    Nan::ThrowError("Layer object already destroyed");
+    return;
+  }
+
+  Local<Object> features;
+  NODE_ARG_OBJECT(0, "features", features);
+
+  int transaction_size = 1000;
+  if (info.Length() > 1 && !info[1]->IsUndefined() && !info[1]->IsNull()) {
+    Local<Object> options;
+    NODE_ARG_OBJECT(1, "options", options);
+    NODE_INT_FROM_OBJ_OPT(options, "transactionSize", transaction_size);
+  }
+  if (transaction_size < 0) {
+    Nan::ThrowRangeError("transactionSize must not be negative");
+    return;
+  }
+
+  OGRLayer *ogr_layer = layer->get();
+  OGRFeatureDefn *defn = ogr_layer->GetLayerDefn();
+  int n_fields = defn->GetFieldCount();
+
+  bool rows = features->IsArray();
+  Local<Array> row_array;
+  std::vector<Local<String>> field_keys;
+  Local<String> geometry_key = Nan::New("geometry").ToLocalChecked();
+
+  std::vector<int> column_indices;
+  std::vector<BatchSource> columns;
+  BatchSource geometry;
+  bool has_geometry = false;
+  size_t count;
+
+  if (rows) {
+    row_array = features.As<Array>();
+    count = row_array->Length();
+    for (int i = 0; i < n_fields; i++) {
+      field_keys.push_back(Nan::New(defn->GetFieldDefn(i)->GetNameRef()).ToLocalChecked());
+    }
+  } else {
+    Local<Value> fields_val, geometry_val, count_val;
+    if (
+      !Nan::Get(features, Nan::New("fields").ToLocalChecked()).ToLocal(&fields_val) ||
+      !Nan::Get(features, geometry_key).ToLocal(&geometry_val) ||
+      !Nan::Get(features, Nan::New("count").ToLocalChecked()).ToLocal(&count_val)) {
+      return; // a getter has thrown
+    }
+
+    if (!fields_val->IsUndefined() && !fields_val->IsNull()) {
+      if (!fields_val->IsObject()) {
+        Nan::ThrowTypeError("Property \"fields\" must be an object");
+        return;
+      }
+      Local<Object> fields = fields_val.As<Object>();
+      Local<Array> names = Nan::GetOwnPropertyNames(fields).ToLocalChecked();
+      for (unsigned int i = 0; i < names->Length(); i++) {
+        Local<Value> name = Nan::Get(names, i).ToLocalChecked();
+        int field_index = defn->GetFieldIndex(*Nan::Utf8String(name));
+        if (field_index < 0) {
+          std::string err = std::string("Specified field name does not exist: ") + *Nan::Utf8String(name);
+          Nan::ThrowError(err.c_str());
+          return;
+        }
+        BatchSource column;
+        Local<Value> column_val;
+        if (!Nan::Get(fields, name).ToLocal(&column_val)) return;
+        if (!column.parse(column_val)) {
+          if (column.exception) return;
+          std::string err = std::string("Invalid column for field: ") + *Nan::Utf8String(name);
+          Nan::ThrowTypeError(err.c_str());
+          return;
+        }
+        column_indices.push_back(field_index);
+        columns.push_back(column);
+      }
+    }
+
+    if (!geometry_val->IsUndefined() && !geometry_val->IsNull()) {
+      if (
+        !geometry.parse(geometry_val) ||
+        (geometry.kind != BatchSource::JS_ARRAY && geometry.kind != BatchSource::BYTES)) {
+        if (geometry.exception) return;
+        Nan::ThrowTypeError("Geometry column must be an array of Geometry objects or WKB offsets and data");
+        return;
+      }
+      has_geometry = true;
+    }
+
+    if (count_val->IsNumber()) {
+      count = Nan::To<uint32_t>(count_val).ToChecked();
+    } else if (!columns.empty()) {
+      count = columns[0].length;
+    } else {
+      count = has_geometry ? geometry.length : 0;
+    }
+    for (size_t i = 0; i < columns.size(); i++) {
+      if (columns[i].length < count) {
+        Nan::ThrowRangeError("All columns must contain at least count values");
+        return;
+      }
+    }
+    if (has_geometry && geometry.length < count) {
+      Nan::ThrowRangeError("All columns must contain at least count values");
+      return;
+    }
+  }
+
+  // the features are built from the JS values before locking the layer:
+  // a getter may throw or use the layer, which would deadlock on its async_lock
+  std::string err_msg;
+  size_t created = 0;
+  size_t chunk_size = transaction_size > 0 ? transaction_size : 1000;
+  std::vector<OGRFeature *> chunk;
+  // set when a getter has thrown, the exception is left pending
+  bool exception = false;
+
+  for (size_t start = 0; start < count && err_msg.empty(); start += chunk_size) {
+    size_t end = std::min(count, start + chunk_size);
+    for (size_t i = start; i < end && err_msg.empty() && !exception; i++) {
+      OGRFeature *feature = new OGRFeature(defn);
+      chunk.push_back(feature);
+
+      if (rows) {
+        Local<Value> row_val;
+        if (!Nan::Get(row_array, i).ToLocal(&row_val)) {
+          exception = true;
+          break;
+        }
+        if (!row_val->IsObject() || row_val->IsNull()) {
+          err_msg = "Array elements must be objects";
+          break;
+        }
+        Local<Object> row = row_val.As<Object>();
+        for (int j = 0; j < n_fields && err_msg.empty(); j++) {
+          if (!Nan::HasOwnProperty(row, field_keys[j]).FromMaybe(false)) continue;
+          Local<Value> val;
+          if (!Nan::Get(row, field_keys[j]).ToLocal(&val)) {
+            exception = true;
+            break;
+          }
+          if (FeatureFields::set(feature, j, val)) err_msg = "Unsupported type of field value";
+        }
+        if (err_msg.empty() && !exception && Nan::HasOwnProperty(row, geometry_key).FromMaybe(false)) {
+          Local<Value> geom;
+          if (!Nan::Get(row, geometry_key).ToLocal(&geom)) {
+            exception = true;
+            break;
+          }
+          if (IS_WRAPPED(geom, Geometry)) {
+            feature->SetGeometry(Nan::ObjectWrap::Unwrap<Geometry>(geom.As<Object>())->get());
+          } else if (!geom->IsNull() && !geom->IsUndefined()) {
+            err_msg = "Property \"geometry\" must be a Geometry object";
+          }
+        }
+      } else {
+        for (size_t j = 0; j < columns.size() && err_msg.empty() && !exception; j++) {
+          if (!columns[j].setField(feature, column_indices[j], i)) {
+            if (columns[j].exception) {
+              exception = true;
+            } else {
+              err_msg = "Unsupported type of field value";
+            }
+          }
+        }
+        if (has_geometry && err_msg.empty() && !exception) {
+          if (geometry.kind == BatchSource::JS_ARRAY) {
+            Local<Value> geom;
+            if (!Nan::Get(geometry.array, i).ToLocal(&geom)) {
+              exception = true;
+              break;
+            }
+            if (IS_WRAPPED(geom, Geometry)) {
+              feature->SetGeometry(Nan::ObjectWrap::Unwrap<Geometry>(geom.As<Object>())->get());
+            } else if (!geom->IsNull() && !geom->IsUndefined()) {
+              err_msg = "Geometry column must contain Geometry objects";
+            }
+          } else if (geometry.offsets[i + 1] > geometry.offsets[i]) {
+            OGRGeometry *geom = NULL;
+            OGRErr err = OGRGeometryFactory::createFromWkb(
+              (unsigned char *)geometry.data + geometry.offsets[i],
+              NULL,
+              &geom,
+              geometry.offsets[i + 1] - geometry.offsets[i]);
+            if (err) {
+              err_msg = getOGRErrMsg(err);
+            } else {
+              feature->SetGeometryDirectly(geom);
+            }
+          }
+        }
+      }
+    }
+
+    if (err_msg.empty() && !exception && !layer->isAlive()) err_msg = "Layer object already destroyed";
+
+    if (err_msg.empty() && !exception) {
+      size_t chunk_created = 0;
+      bool in_transaction = false;
+      uv_mutex_lock(layer->async_lock);
+      if (transaction_size > 0) {
+        OGRErr err = ogr_layer->StartTransaction();
+        if (err) {
+          err_msg = getOGRErrMsg(err);
+        } else {
+          in_transaction = true;
+        }
+      }
+      for (size_t i = 0; i < chunk.size() && err_msg.empty(); i++) {
+        OGRErr err = ogr_layer->CreateFeature(chunk[i]);
+        if (err) {
+          err_msg = getOGRErrMsg(err);
+        } else {
+          chunk_created++;
+        }
+      }
+      if (in_transaction) {
+        if (err_msg.empty()) {
+          OGRErr err = ogr_layer->CommitTransaction();
+          if (err) err_msg = getOGRErrMsg(err);
+        } else {
+          ogr_layer->RollbackTransaction();
+          chunk_created = 0;
+        }
+      }
+      uv_mutex_unlock(layer->async_lock);
+      created += chunk_created;
+    }
+
+    for (OGRFeature *feature : chunk) OGRFeature::DestroyFeature(feature);
+    chunk.clear();
+    if (exception) break;
+  }
+  if (created > 0 && layer->isAlive()) layer->spatial_index.reset();
+
+  if (exception) return;
+  if (!err_msg.empty()) {
+    Nan::ThrowError(err_msg.c_str());
+    return;
+  }
+
+  info.GetReturnValue().Set(Nan::New<Integer>((uint32_t)created));
 }
 
 /**
@@ -263,7 +1060,10 @@ NAN_METHOD(LayerFeatures::set) {
     Nan::ThrowError("Feature already destroyed");
     return;
   }
+  uv_mutex_lock(layer->async_lock);
   err = layer->get()->SetFeature(f->get());
+  uv_mutex_unlock(layer->async_lock);
+  layer->spatial_index.reset();
   if (err) {
     NODE_THROW_OGRERR(err);
     return;
@@ -291,7 +1091,10 @@ NAN_METHOD(LayerFeatures::remove) {
 
   int i;
   NODE_ARG_INT(0, "feature id", i);
+  uv_mutex_lock(layer->async_lock);
   int err = layer->get()->DeleteFeature(i);
+  uv_mutex_unlock(layer->async_lock);
+  layer->spatial_index.reset();
   if (err) {
     NODE_THROW_OGRERR(err);
     return;
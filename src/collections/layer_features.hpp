@@ -28,8 +28,11 @@ class LayerFeatures : public Nan::ObjectWrap {
   static NAN_METHOD(get);
   static NAN_METHOD(first);
   static NAN_METHOD(next);
+  static NAN_METHOD(nextAsync);
+  static NAN_METHOD(readBatch);
   static NAN_METHOD(count);
   static NAN_METHOD(add);
+  static NAN_METHOD(addBatch);
   static NAN_METHOD(set);
   static NAN_METHOD(remove);
 
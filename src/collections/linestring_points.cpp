@@ -3,6 +3,9 @@
 #include "../gdal_geometry.hpp"
 #include "../gdal_linestring.hpp"
 #include "../gdal_point.hpp"
+#include "../utils/typed_array.hpp"
+
+#include <vector>
 
 namespace node_gdal {
 
@@ -22,6 +25,8 @@ void LineStringPoints::Initialize(Local<Object> target) {
   Nan::SetPrototypeMethod(lcons, "add", add);
   Nan::SetPrototypeMethod(lcons, "reverse", reverse);
   Nan::SetPrototypeMethod(lcons, "resize", resize);
+  Nan::SetPrototypeMethod(lcons, "setFromArray", setFromArray);
+  Nan::SetPrototypeMethod(lcons, "toArray", toArray);
 
   Nan::Set(target, Nan::New("LineStringPoints").ToLocalChecked(), Nan::GetFunction(lcons).ToLocalChecked());
 
@@ -366,4 +371,100 @@ NAN_METHOD(LineStringPoints::add) {
   return;
 }
 
+/**
+ * Replaces all the points with the coordinates of a flat array
+ * (`x0, y0, x1, y1, ...` or `x0, y0, z0, x1, y1, z1, ...`).
+ *
+ * @example
+ * ```
+ * lineString.points.setFromArray(new Float64Array([0, 0, 10, 10, 20, 0]), 2);```
+ *
+ * @method setFromArray
+ * @throws Error
+ * @param {Float64Array} coordinates
+ * @param {Integer} [dimensions=2] `2` or `3`
+ */
+NAN_METHOD(LineStringPoints::setFromArray) {
+  Nan::HandleScope scope;
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  LineString *geom = Nan::ObjectWrap::Unwrap<LineString>(parent);
+
+  if (info.Length() < 1 || !info[0]->IsFloat64Array()) {
+    Nan::ThrowTypeError("coordinates must be a Float64Array");
+    return;
+  }
+  int dimensions = 2;
+  NODE_ARG_INT_OPT(1, "dimensions", dimensions);
+  if (dimensions != 2 && dimensions != 3) {
+    Nan::ThrowRangeError("dimensions must be 2 or 3");
+    return;
+  }
+
+  Nan::TypedArrayContents<double> contents(info[0]);
+  size_t length = contents.length();
+  if (length % dimensions) {
+    Nan::ThrowRangeError("The length of coordinates must be a multiple of dimensions");
+    return;
+  }
+  int n = length / dimensions;
+
+  if (dimensions == 2) {
+    // OGRRawPoint has the same layout as a pair of doubles
+    geom->get()->setPoints(n, reinterpret_cast<OGRRawPoint *>(*contents));
+  } else {
+    std::vector<double> x(n), y(n), z(n);
+    for (int i = 0; i < n; i++) {
+      x[i] = (*contents)[i * 3];
+      y[i] = (*contents)[i * 3 + 1];
+      z[i] = (*contents)[i * 3 + 2];
+    }
+    geom->get()->setPoints(n, x.data(), y.data(), z.data());
+  }
+
+  return;
+}
+
+/**
+ * Returns the coordinates of all the points as a flat array
+ * (`x0, y0, x1, y1, ...` or `x0, y0, z0, x1, y1, z1, ...`).
+ *
+ * @method toArray
+ * @param {Integer} [dimensions] `2` or `3`, defaults to the coordinate dimension of the line string
+ * @return {Float64Array}
+ */
+NAN_METHOD(LineStringPoints::toArray) {
+  Nan::HandleScope scope;
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  LineString *geom = Nan::ObjectWrap::Unwrap<LineString>(parent);
+
+  int dimensions = geom->get()->getCoordinateDimension() == 3 ? 3 : 2;
+  NODE_ARG_INT_OPT(0, "dimensions", dimensions);
+  if (dimensions != 2 && dimensions != 3) {
+    Nan::ThrowRangeError("dimensions must be 2 or 3");
+    return;
+  }
+
+  int n = geom->get()->getNumPoints();
+  Local<Value> array = TypedArray::New(GDT_Float64, n * dimensions);
+  if (array.IsEmpty() || !array->IsObject()) return;
+  double *data = (double *)TypedArray::Validate(array.As<Object>(), GDT_Float64, n * dimensions);
+  if (!data) return;
+
+  if (n > 0) {
+    if (dimensions == 2) {
+      geom->get()->getPoints(reinterpret_cast<OGRRawPoint *>(data));
+    } else {
+      // z is 0 for 2D line strings
+      int stride = 3 * sizeof(double);
+      geom->get()->getPoints(data, stride, data + 1, stride, data + 2, stride);
+    }
+  }
+
+  info.GetReturnValue().Set(array);
+}
+
 } // namespace node_gdal
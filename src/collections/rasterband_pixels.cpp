@@ -200,7 +200,10 @@ void RasterBandPixels::_do_read(const Nan::FunctionCallbackInfo<v8::Value> &info
   NODE_ARG_OPT_STR(7, "data_type", type_name);
   if (!type_name.empty()) { type = GDALGetDataTypeByName(type_name.c_str()); }
 
-  if (!info[4]->IsUndefined() && !info[4]->IsNull()) {
+  // an ArrayBuffer or a SharedArrayBuffer is read into in place,
+  // using the band data type or data_type
+  bool raw_buffer = info[4]->IsArrayBuffer() || info[4]->IsSharedArrayBuffer();
+  if (!raw_buffer && !info[4]->IsUndefined() && !info[4]->IsNull()) {
     NODE_ARG_OBJECT(4, "data", obj);
     type = TypedArray::Identify(obj);
     if (type == GDT_Unknown) {
@@ -231,7 +234,19 @@ void RasterBandPixels::_do_read(const Nan::FunctionCallbackInfo<v8::Value> &info
   min_length = (min_size + bytes_per_pixel - 1) / bytes_per_pixel;
 
   // create array if no array was passed
-  if (obj.IsEmpty()) {
+  if (raw_buffer) {
+    int offset = 0;
+    NODE_ARG_INT_OPT(10, "offset", offset);
+    if (offset < 0) {
+      Nan::ThrowRangeError("offset must be greater than or equal to 0");
+      return;
+    }
+    array = TypedArray::New(type, info[4], offset, length);
+    if (array.IsEmpty() || !array->IsObject()) {
+      return; // TypedArray::New threw an error
+    }
+    obj = array.As<Object>();
+  } else if (obj.IsEmpty()) {
     array = TypedArray::New(type, length);
     if (array.IsEmpty() || !array->IsObject()) {
       return; // TypedArray::New threw an error
@@ -246,7 +261,7 @@ void RasterBandPixels::_do_read(const Nan::FunctionCallbackInfo<v8::Value> &info
 
   if (async) {
     Nan::Callback *callback;
-    NODE_ARG_CB(10, "callback", callback);
+    NODE_ARG_CB(11, "callback", callback);
     Nan::AsyncQueueWorker(new AsyncRasterIO(
       callback, band, GF_Read, x, y, w, h, &obj, data, buffer_w, buffer_h, type, pixel_space, line_space));
   } else {
@@ -270,9 +285,10 @@ void RasterBandPixels::_do_read(const Nan::FunctionCallbackInfo<v8::Value> &info
  * @param {Integer} y
  * @param {Integer} width
  * @param {Integer} height
- * @param {TypedArray} [data] The
+ * @param {TypedArray|ArrayBuffer|SharedArrayBuffer} [data] The
  * [TypedArray](https://developer.mozilla.org/en-US/docs/Web/API/ArrayBufferView#Typed_array_subclasses)
- * to put the data in. A new array is created if not given.
+ * to put the data in. A new array is created if not given. When an `ArrayBuffer` or a `SharedArrayBuffer` is given,
+ * the data is read in place into a view of the band data type (or `options.data_type`) starting at `options.offset`.
  * @param {Object} [options]
  * @param {Integer} [options.buffer_width=x_size]
  * @param {Integer} [options.buffer_height=y_size]
@@ -280,6 +296,8 @@ void RasterBandPixels::_do_read(const Nan::FunctionCallbackInfo<v8::Value> &info
  * constants{{/crossLink}}.
  * @param {Integer} [options.pixel_space]
  * @param {Integer} [options.line_space]
+ * @param {Integer} [options.offset=0] Byte offset in the `ArrayBuffer` or `SharedArrayBuffer`, must be a multiple of
+ * the size of the data type
  * @return {TypedArray} A
  * [TypedArray](https://developer.mozilla.org/en-US/docs/Web/API/ArrayBufferView#Typed_array_subclasses)
  * of values.
@@ -299,9 +317,10 @@ NAN_METHOD(RasterBandPixels::read) {
  * @param {Integer} y
  * @param {Integer} width
  * @param {Integer} height
- * @param {TypedArray} [data] The
+ * @param {TypedArray|ArrayBuffer|SharedArrayBuffer} [data] The
  * [TypedArray](https://developer.mozilla.org/en-US/docs/Web/API/ArrayBufferView#Typed_array_subclasses)
- * to put the data in. A new array is created if not given.
+ * to put the data in. A new array is created if not given. When an `ArrayBuffer` or a `SharedArrayBuffer` is given,
+ * the data is read in place into a view of the band data type (or `options.data_type`) starting at `options.offset`.
  * @param {Object} [options]
  * @param {Integer} [options.buffer_width=x_size]
  * @param {Integer} [options.buffer_height=y_size]
@@ -309,6 +328,8 @@ NAN_METHOD(RasterBandPixels::read) {
  * constants{{/crossLink}}.
  * @param {Integer} [options.pixel_space]
  * @param {Integer} [options.line_space]
+ * @param {Integer} [options.offset=0] Byte offset in the `ArrayBuffer` or `SharedArrayBuffer`, must be a multiple of
+ * the size of the data type
  * @param {requestCallback} [callback] Promisifiable callback, always the last parameter, can be specified even if
  * certain optional parameters are omitted
  * @return {TypedArray} A
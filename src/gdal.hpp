@@ -3,6 +3,7 @@
 
 // node
 #include <node.h>
+#include <node_buffer.h>
 
 // nan
 #include "nan-wrapper.h"
@@ -18,6 +19,10 @@
 
 #include "async/async_open.hpp"
 
+#include <memory>
+#include <string>
+#include <vector>
+
 using namespace v8;
 using namespace node;
 
@@ -101,6 +106,170 @@ static NAN_METHOD(openAsync) {
   _do_open(info, true);
 }
 
+#if GDAL_VERSION_MAJOR >= 2
+/*
+ * Wraps a dataset opened on the memory of a Buffer
+ */
+static Local<Value> bufferDataset(GDALDataset *raw, Local<Object> buffer, const std::string &filename) {
+  Nan::EscapableHandleScope scope;
+
+  Local<Value> ds = Dataset::New(raw);
+  Dataset *wrapped = Nan::ObjectWrap::Unwrap<Dataset>(ds.As<Object>());
+  ptr_manager.attachBuffer(wrapped->uid, buffer, filename);
+  // the async operations still reading through a pooled handle when the dataset
+  // is closed keep the Buffer alive through the dataset
+  Nan::SetPrivate(ds.As<Object>(), Nan::New("buffer_").ToLocalChecked(), buffer);
+
+  return scope.Escape(ds);
+}
+#endif
+
+/*
+ * Common code for sync and async opening of a Buffer
+ */
+static void _do_open_buffer(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async) {
+  Nan::HandleScope scope;
+
+#if GDAL_VERSION_MAJOR < 2
+  Nan::ThrowError("Opening a Buffer is not supported on GDAL 1.x");
+  return;
+#else
+  if (info.Length() < 1 || !node::Buffer::HasInstance(info[0])) {
+    Nan::ThrowTypeError("buffer must be a Buffer");
+    return;
+  }
+  Local<Object> buffer = info[0].As<Object>();
+
+  std::vector<std::string> drivers;
+  if (info.Length() > 1 && !info[1]->IsUndefined() && !info[1]->IsNull()) {
+    Local<Object> options;
+    NODE_ARG_OBJECT(1, "options", options);
+    Local<Value> driver = Nan::Get(options, Nan::New("driver").ToLocalChecked()).ToLocalChecked();
+    if (driver->IsString()) {
+      drivers.push_back(*Nan::Utf8String(driver));
+    } else if (driver->IsArray()) {
+      Local<Array> array = driver.As<Array>();
+      for (unsigned i = 0; i < array->Length(); i++) {
+        Local<Value> name = Nan::Get(array, i).ToLocalChecked();
+        if (!name->IsString()) {
+          Nan::ThrowTypeError("driver(s) must be a string or list of strings");
+          return;
+        }
+        drivers.push_back(*Nan::Utf8String(name));
+      }
+    } else if (!driver->IsUndefined() && !driver->IsNull()) {
+      Nan::ThrowTypeError("driver(s) must be a string or list of strings");
+      return;
+    }
+  }
+  for (const std::string &name : drivers) {
+    if (!GetGDALDriverManager()->GetDriverByName(name.c_str())) {
+      Nan::ThrowError(("Cannot find driver: " + name).c_str());
+      return;
+    }
+  }
+
+  // the callback is checked first, an early return must not leave the file behind
+  Nan::Callback *callback = nullptr;
+  if (async) { NODE_ARG_CB(2, "callback", callback); }
+
+  // the file is created over the memory of the Buffer, without copying it
+  static unsigned long buffer_count = 0;
+  std::string filename = "/vsimem/node-gdal/buffer." + std::to_string(++buffer_count);
+  VSILFILE *file = VSIFileFromMemBuffer(
+    filename.c_str(), (GByte *)node::Buffer::Data(buffer), (vsi_l_offset)node::Buffer::Length(buffer), FALSE);
+  if (!file) {
+    delete callback;
+    Nan::ThrowError("Error creating the in-memory file");
+    return;
+  }
+  VSIFCloseL(file);
+
+  std::function<GDALDataset *()> doit = [filename, drivers]() {
+    std::vector<const char *> driver_list;
+    for (const std::string &name : drivers) driver_list.push_back(name.c_str());
+    driver_list.push_back(nullptr);
+    GDALDataset *ds = (GDALDataset *)GDALOpenEx(
+      filename.c_str(), GDAL_OF_READONLY, drivers.empty() ? NULL : driver_list.data(), NULL, NULL);
+    if (!ds) VSIUnlink(filename.c_str());
+    return ds;
+  };
+
+  if (async) {
+    // the Buffer must outlive the opening
+    std::shared_ptr<Nan::Persistent<Object>> persistent(
+      new Nan::Persistent<Object>(buffer), [](Nan::Persistent<Object> *p) {
+        p->Reset();
+        delete p;
+      });
+    std::function<Local<Value>(GDALDataset *)> wrap = [persistent, filename](GDALDataset *raw) {
+      return bufferDataset(raw, Nan::New(*persistent), filename);
+    };
+    Nan::AsyncQueueWorker(new AsyncOpen(callback, doit, wrap));
+    return;
+  }
+
+  GDALDataset *ds = doit();
+  if (ds) {
+    info.GetReturnValue().Set(bufferDataset(ds, buffer, filename));
+    return;
+  }
+
+  Nan::ThrowError("Error opening dataset");
+#endif
+}
+
+/**
+ * Opens a dataset from the content of a Buffer, for example an image received in
+ * an HTTP request, without writing it to a file.
+ *
+ * The Buffer is not copied: it is used as an in-memory `/vsimem/` file kept alive
+ * until the dataset is closed, its content must not be modified meanwhile.
+ * The dataset is opened read-only.
+ *
+ * @example
+ * ```
+ * var ds = gdal.openBuffer(fs.readFileSync('image.png'));
+ * var ds = gdal.openBuffer(body, {driver: 'GTiff'});```
+ *
+ * @for gdal
+ * @throws Error
+ * @method openBuffer
+ * @static
+ * @param {Buffer} buffer
+ * @param {Object} [options]
+ * @param {String|String[]} [options.driver] Driver name, or list of driver names to attempt to use
+ * @return {gdal.Dataset}
+ */
+static NAN_METHOD(openBuffer) {
+  _do_open_buffer(info, false);
+}
+
+/**
+ * Asynchronously opens a dataset from the content of a Buffer, for example an image received in
+ * an HTTP request, without writing it to a file.
+ *
+ * The Buffer is not copied: it is used as an in-memory `/vsimem/` file kept alive
+ * until the dataset is closed, its content must not be modified meanwhile.
+ * The dataset is opened read-only.
+ *
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ *
+ * @for gdal
+ * @method openBufferAsync
+ * @static
+ * @param {Buffer} buffer
+ * @param {Object} [options]
+ * @param {String|String[]} [options.driver] Driver name, or list of driver names to attempt to use
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter, can be specified even if
+ * certain optional parameters are omitted
+ * @return {Promise<gdal.Dataset>}
+ */
+static NAN_METHOD(openBufferAsync) {
+  _do_open_buffer(info, true);
+}
+
 static NAN_METHOD(setConfigOption) {
   Nan::HandleScope scope;
 
@@ -4,34 +4,43 @@
 #include "gdal_layer.hpp"
 #include "gdal_rasterband.hpp"
 #include "utils/number_list.hpp"
+#include "utils/raster_expression.hpp"
+#include "async/async_worker.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string.h>
+#include <thread>
 
 namespace node_gdal {
 
 void Algorithms::Initialize(Local<Object> target) {
   Nan::SetMethod(target, "fillNodata", fillNodata);
+  Nan::SetMethod(target, "fillNodataAsync", fillNodataAsync);
   Nan::SetMethod(target, "contourGenerate", contourGenerate);
+  Nan::SetMethod(target, "contourGenerateAsync", contourGenerateAsync);
   Nan::SetMethod(target, "sieveFilter", sieveFilter);
+  Nan::SetMethod(target, "sieveFilterAsync", sieveFilterAsync);
   Nan::SetMethod(target, "checksumImage", checksumImage);
   Nan::SetMethod(target, "polygonize", polygonize);
+  Nan::SetMethod(target, "polygonizeAsync", polygonizeAsync);
+  Nan::SetMethod(target, "zonalStats", zonalStats);
+  Nan::SetMethod(target, "zonalStatsAsync", zonalStatsAsync);
+  Nan::SetMethod(target, "calc", calc);
+  Nan::SetMethod(target, "calcAsync", calcAsync);
+  Nan::SetMethod(target, "rasterize", rasterize);
+  Nan::SetMethod(target, "rasterizeAsync", rasterizeAsync);
+  Nan::SetMethod(target, "grid", grid);
+  Nan::SetMethod(target, "gridAsync", gridAsync);
 }
 
 /**
- * Fill raster regions by interpolation from edges.
- *
- * @throws Error
- * @method fillNodata
- * @static
- * @for gdal
- * @param {Object} options
- * @param {gdal.RasterBand} options.src This band to be updated in-place.
- * @param {gdal.RasterBand} [options.mask] Mask band
- * @param {Number} options.searchDist The maximum distance (in pixels) that the
- * algorithm will search out for values to interpolate.
- * @param {integer} [options.smoothingIterations=0] The number of 3x3 average
- * filter smoothing iterations to run after the interpolation to dampen
- * artifacts.
+ * Low level fillNodata for both synchronous and asynchronous execution.
  */
-NAN_METHOD(Algorithms::fillNodata) {
+static void _do_fill_nodata(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async) {
   Nan::HandleScope scope;
 
   Local<Object> obj;
@@ -47,9 +56,32 @@ NAN_METHOD(Algorithms::fillNodata) {
   NODE_DOUBLE_FROM_OBJ(obj, "searchDist", search_dist);
   NODE_INT_FROM_OBJ_OPT(obj, "smoothIterations", smooth_iterations)
 
-  CPLErr err =
-    GDALFillNodata(src->get(), mask ? mask->get() : NULL, search_dist, 0, smooth_iterations, NULL, NULL, NULL);
+  GDALRasterBand *gdal_src = src->get();
+  GDALRasterBand *gdal_mask = mask ? mask->get() : NULL;
+  std::vector<uv_mutex_t *> locks = {src->async_lock};
+  if (mask) locks.push_back(mask->async_lock);
+
+  AsyncGDALWorker::Job doit = [gdal_src, gdal_mask, search_dist, smooth_iterations, locks](
+                                GDALProgressFunc pfnProgress, void *pProgressArg) mutable {
+    AsyncGDALWorker::lock(locks);
+    CPLErr err =
+      GDALFillNodata(gdal_src, gdal_mask, search_dist, 0, smooth_iterations, NULL, pfnProgress, pProgressArg);
+    AsyncGDALWorker::unlock(locks);
+    return err;
+  };
+
+  if (async) {
+    Nan::Callback *callback, *progress_cb = NULL;
+    NODE_ARG_CB(3, "callback", callback);
+    NODE_ARG_CB_OPT(2, "progress_cb", progress_cb);
+    AsyncGDALWorker *worker = new AsyncGDALWorker(callback, "node-gdal:FillNodata", info[1], progress_cb, doit);
+    worker->persist(src->handle());
+    if (mask) worker->persist(mask->handle());
+    Nan::AsyncQueueWorker(worker);
+    return;
+  }
 
+  CPLErr err = doit(NULL, NULL);
   if (err) {
     NODE_THROW_CPLERR(err);
     return;
@@ -59,36 +91,60 @@ NAN_METHOD(Algorithms::fillNodata) {
 }
 
 /**
- * Create vector contours from raster DEM.
+ * Fill raster regions by interpolation from edges.
  *
- * This algorithm will generate contour vectors for the input raster band on the
- * requested set of contour levels. The vector contours are written to the
- * passed in vector layer. Also, a NODATA value may be specified to identify
- * pixels that should not be considered in contour line generation.
+ * @throws Error
+ * @method fillNodata
+ * @static
+ * @for gdal
+ * @param {Object} options
+ * @param {gdal.RasterBand} options.src This band to be updated in-place.
+ * @param {gdal.RasterBand} [options.mask] Mask band
+ * @param {Number} options.searchDist The maximum distance (in pixels) that the
+ * algorithm will search out for values to interpolate.
+ * @param {integer} [options.smoothingIterations=0] The number of 3x3 average
+ * filter smoothing iterations to run after the interpolation to dampen
+ * artifacts.
+ */
+NAN_METHOD(Algorithms::fillNodata) {
+  _do_fill_nodata(info, false);
+}
+
+/**
+ * Asynchronously fill raster regions by interpolation from edges.
+ *
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved on completion.
+ * The operation can be aborted with an
+ * [AbortSignal](https://developer.mozilla.org/en-US/docs/Web/API/AbortSignal), the Promise is then
+ * rejected with an `AbortError`.
  *
  * @throws Error
- * @method contourGenerate
+ * @method fillNodataAsync
  * @static
  * @for gdal
  * @param {Object} options
- * @param {gdal.RasterBand} options.src
- * @param {gdal.Layer} options.dst
- * @param {Number} [options.offset=0] The "offset" relative to which contour
- * intervals are applied. This is normally zero, but could be different. To
- * generate 10m contours at 5, 15, 25, ... the offset would be 5.
- * @param {Number} [options.interval=100] The elevation interval between
- * contours generated.
- * @param {Number[]} [options.fixedLevels] A list of fixed contour levels at
- * which contours should be generated. Overrides interval/base options if set.
- * @param {Number} [options.nodata] The value to use as a "nodata" value. That
- * is, a pixel value which should be ignored in generating contours as if the
- * value of the pixel were not known.
- * @param {integer} [options.idField] A field index to indicate where a unique
- * id should be written for each feature (contour) written.
- * @param {integer} [options.elevField] A field index to indicate where the
- * elevation value of the contour should be written.
+ * @param {gdal.RasterBand} options.src This band to be updated in-place.
+ * @param {gdal.RasterBand} [options.mask] Mask band
+ * @param {Number} options.searchDist The maximum distance (in pixels) that the
+ * algorithm will search out for values to interpolate.
+ * @param {integer} [options.smoothingIterations=0] The number of 3x3 average
+ * filter smoothing iterations to run after the interpolation to dampen
+ * artifacts.
+ * @param {AbortSignal} [options.signal] Aborts the operation when signaled
+ * @param {ProgressCb} [options.progress_cb] Called with the completion ratio, between 0 and 1
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter, can be specified even if
+ * certain optional parameters are omitted
+ * @return {Promise<void>}
  */
-NAN_METHOD(Algorithms::contourGenerate) {
+NAN_METHOD(Algorithms::fillNodataAsync) {
+  _do_fill_nodata(info, true);
+}
+
+/**
+ * Low level contourGenerate for both synchronous and asynchronous execution.
+ */
+static void _do_contour_generate(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async) {
   Nan::HandleScope scope;
 
   Local<Object> obj;
@@ -96,9 +152,8 @@ NAN_METHOD(Algorithms::contourGenerate) {
   RasterBand *src;
   Layer *dst;
   double interval = 100, base = 0;
-  double *fixed_levels = NULL;
   DoubleList fixed_level_array;
-  int n_fixed_levels = 0;
+  std::vector<double> fixed_levels;
   int use_nodata = 0;
   double nodata = 0;
   int id_field = -1, elev_field = -1;
@@ -115,8 +170,7 @@ NAN_METHOD(Algorithms::contourGenerate) {
     if (fixed_level_array.parse(Nan::Get(obj, Nan::New("fixedLevels").ToLocalChecked()).ToLocalChecked())) {
       return; // error parsing double list
     } else {
-      fixed_levels = fixed_level_array.get();
-      n_fixed_levels = fixed_level_array.length();
+      fixed_levels.assign(fixed_level_array.get(), fixed_level_array.get() + fixed_level_array.length());
     }
   }
   if (Nan::HasOwnProperty(obj, Nan::New("nodata").ToLocalChecked()).FromMaybe(false)) {
@@ -126,23 +180,55 @@ NAN_METHOD(Algorithms::contourGenerate) {
       nodata = Nan::To<double>(prop).ToChecked();
     } else if (!prop->IsNull() && !prop->IsUndefined()) {
       Nan::ThrowTypeError("nodata property must be a number");
+      return;
     }
   }
 
-  CPLErr err = GDALContourGenerate(
-    src->get(),
-    interval,
-    base,
-    n_fixed_levels,
-    fixed_levels,
-    use_nodata,
-    nodata,
-    dst->get(),
-    id_field,
-    elev_field,
-    NULL,
-    NULL);
+  GDALRasterBand *gdal_src = src->get();
+  OGRLayer *ogr_dst = dst->get();
+  std::vector<uv_mutex_t *> locks = {src->async_lock, dst->async_lock};
+
+  AsyncGDALWorker::Job doit =
+    [gdal_src, ogr_dst, interval, base, fixed_levels, use_nodata, nodata, id_field, elev_field, locks](
+      GDALProgressFunc pfnProgress, void *pProgressArg) mutable {
+      AsyncGDALWorker::lock(locks);
+      CPLErr err = GDALContourGenerate(
+        gdal_src,
+        interval,
+        base,
+        fixed_levels.size(),
+        fixed_levels.empty() ? NULL : fixed_levels.data(),
+        use_nodata,
+        nodata,
+        ogr_dst,
+        id_field,
+        elev_field,
+        pfnProgress,
+        pProgressArg);
+      AsyncGDALWorker::unlock(locks);
+      return err;
+    };
+
+  if (async) {
+    Nan::Callback *callback, *progress_cb = NULL;
+    NODE_ARG_CB(3, "callback", callback);
+    NODE_ARG_CB_OPT(2, "progress_cb", progress_cb);
+    // the features written into the layer make its spatial index stale
+    dst->spatial_index.reset();
+    AsyncGDALWorker::Result rval = [dst]() {
+      if (dst->isAlive()) dst->spatial_index.reset();
+      return Nan::Undefined().As<Value>();
+    };
+    AsyncGDALWorker *worker =
+      new AsyncGDALWorker(callback, "node-gdal:ContourGenerate", info[1], progress_cb, doit, rval);
+    worker->persist(src->handle());
+    worker->persist(dst->handle());
+    Nan::AsyncQueueWorker(worker);
+    return;
+  }
 
+  CPLErr err = doit(NULL, NULL);
+  dst->spatial_index.reset();
   if (err) {
     NODE_THROW_CPLERR(err);
     return;
@@ -152,25 +238,88 @@ NAN_METHOD(Algorithms::contourGenerate) {
 }
 
 /**
- * Removes small raster polygons.
+ * Create vector contours from raster DEM.
+ *
+ * This algorithm will generate contour vectors for the input raster band on the
+ * requested set of contour levels. The vector contours are written to the
+ * passed in vector layer. Also, a NODATA value may be specified to identify
+ * pixels that should not be considered in contour line generation.
  *
  * @throws Error
- * @method sieveFilter
+ * @method contourGenerate
  * @static
  * @for gdal
  * @param {Object} options
  * @param {gdal.RasterBand} options.src
- * @param {gdal.RasterBand} options.dst Output raster band. It may be the same
- * as src band to update the source in place.
- * @param {gdal.RasterBand} [options.mask] All pixels in the mask band with a
- * value other than zero will be considered suitable for inclusion in polygons.
- * @param {Number} options.threshold Raster polygons with sizes smaller than
- * this will be merged into their largest neighbour.
- * @param {integer} [options.connectedness=4] Either 4 indicating that diagonal
- * pixels are not considered directly adjacent for polygon membership purposes
- * or 8 indicating they are.
+ * @param {gdal.Layer} options.dst
+ * @param {Number} [options.offset=0] The "offset" relative to which contour
+ * intervals are applied. This is normally zero, but could be different. To
+ * generate 10m contours at 5, 15, 25, ... the offset would be 5.
+ * @param {Number} [options.interval=100] The elevation interval between
+ * contours generated.
+ * @param {Number[]} [options.fixedLevels] A list of fixed contour levels at
+ * which contours should be generated. Overrides interval/base options if set.
+ * @param {Number} [options.nodata] The value to use as a "nodata" value. That
+ * is, a pixel value which should be ignored in generating contours as if the
+ * value of the pixel were not known.
+ * @param {integer} [options.idField] A field index to indicate where a unique
+ * id should be written for each feature (contour) written.
+ * @param {integer} [options.elevField] A field index to indicate where the
+ * elevation value of the contour should be written.
  */
-NAN_METHOD(Algorithms::sieveFilter) {
+NAN_METHOD(Algorithms::contourGenerate) {
+  _do_contour_generate(info, false);
+}
+
+/**
+ * Asynchronously create vector contours from raster DEM.
+ *
+ * This algorithm will generate contour vectors for the input raster band on the
+ * requested set of contour levels. The vector contours are written to the
+ * passed in vector layer. Also, a NODATA value may be specified to identify
+ * pixels that should not be considered in contour line generation.
+ *
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved on completion.
+ * The operation can be aborted with an
+ * [AbortSignal](https://developer.mozilla.org/en-US/docs/Web/API/AbortSignal), the Promise is then
+ * rejected with an `AbortError`.
+ *
+ * @throws Error
+ * @method contourGenerateAsync
+ * @static
+ * @for gdal
+ * @param {Object} options
+ * @param {gdal.RasterBand} options.src
+ * @param {gdal.Layer} options.dst
+ * @param {Number} [options.offset=0] The "offset" relative to which contour
+ * intervals are applied. This is normally zero, but could be different. To
+ * generate 10m contours at 5, 15, 25, ... the offset would be 5.
+ * @param {Number} [options.interval=100] The elevation interval between
+ * contours generated.
+ * @param {Number[]} [options.fixedLevels] A list of fixed contour levels at
+ * which contours should be generated. Overrides interval/base options if set.
+ * @param {Number} [options.nodata] The value to use as a "nodata" value. That
+ * is, a pixel value which should be ignored in generating contours as if the
+ * value of the pixel were not known.
+ * @param {integer} [options.idField] A field index to indicate where a unique
+ * id should be written for each feature (contour) written.
+ * @param {integer} [options.elevField] A field index to indicate where the
+ * elevation value of the contour should be written.
+ * @param {AbortSignal} [options.signal] Aborts the operation when signaled
+ * @param {ProgressCb} [options.progress_cb] Called with the completion ratio, between 0 and 1
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter, can be specified even if
+ * certain optional parameters are omitted
+ * @return {Promise<void>}
+ */
+NAN_METHOD(Algorithms::contourGenerateAsync) {
+  _do_contour_generate(info, true);
+}
+
+/**
+ * Low level sieveFilter for both synchronous and asynchronous execution.
+ */
+static void _do_sieve_filter(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async) {
   Nan::HandleScope scope;
 
   Local<Object> obj;
@@ -193,9 +342,34 @@ NAN_METHOD(Algorithms::sieveFilter) {
     return;
   }
 
-  CPLErr err =
-    GDALSieveFilter(src->get(), mask ? mask->get() : NULL, dst->get(), threshold, connectedness, NULL, NULL, NULL);
+  GDALRasterBand *gdal_src = src->get();
+  GDALRasterBand *gdal_dst = dst->get();
+  GDALRasterBand *gdal_mask = mask ? mask->get() : NULL;
+  std::vector<uv_mutex_t *> locks = {src->async_lock, dst->async_lock};
+  if (mask) locks.push_back(mask->async_lock);
+
+  AsyncGDALWorker::Job doit = [gdal_src, gdal_dst, gdal_mask, threshold, connectedness, locks](
+                                GDALProgressFunc pfnProgress, void *pProgressArg) mutable {
+    AsyncGDALWorker::lock(locks);
+    CPLErr err =
+      GDALSieveFilter(gdal_src, gdal_mask, gdal_dst, threshold, connectedness, NULL, pfnProgress, pProgressArg);
+    AsyncGDALWorker::unlock(locks);
+    return err;
+  };
+
+  if (async) {
+    Nan::Callback *callback, *progress_cb = NULL;
+    NODE_ARG_CB(3, "callback", callback);
+    NODE_ARG_CB_OPT(2, "progress_cb", progress_cb);
+    AsyncGDALWorker *worker = new AsyncGDALWorker(callback, "node-gdal:SieveFilter", info[1], progress_cb, doit);
+    worker->persist(src->handle());
+    worker->persist(dst->handle());
+    if (mask) worker->persist(mask->handle());
+    Nan::AsyncQueueWorker(worker);
+    return;
+  }
 
+  CPLErr err = doit(NULL, NULL);
   if (err) {
     NODE_THROW_CPLERR(err);
     return;
@@ -204,6 +378,63 @@ NAN_METHOD(Algorithms::sieveFilter) {
   return;
 }
 
+/**
+ * Removes small raster polygons.
+ *
+ * @throws Error
+ * @method sieveFilter
+ * @static
+ * @for gdal
+ * @param {Object} options
+ * @param {gdal.RasterBand} options.src
+ * @param {gdal.RasterBand} options.dst Output raster band. It may be the same
+ * as src band to update the source in place.
+ * @param {gdal.RasterBand} [options.mask] All pixels in the mask band with a
+ * value other than zero will be considered suitable for inclusion in polygons.
+ * @param {Number} options.threshold Raster polygons with sizes smaller than
+ * this will be merged into their largest neighbour.
+ * @param {integer} [options.connectedness=4] Either 4 indicating that diagonal
+ * pixels are not considered directly adjacent for polygon membership purposes
+ * or 8 indicating they are.
+ */
+NAN_METHOD(Algorithms::sieveFilter) {
+  _do_sieve_filter(info, false);
+}
+
+/**
+ * Asynchronously removes small raster polygons.
+ *
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved on completion.
+ * The operation can be aborted with an
+ * [AbortSignal](https://developer.mozilla.org/en-US/docs/Web/API/AbortSignal), the Promise is then
+ * rejected with an `AbortError`.
+ *
+ * @throws Error
+ * @method sieveFilterAsync
+ * @static
+ * @for gdal
+ * @param {Object} options
+ * @param {gdal.RasterBand} options.src
+ * @param {gdal.RasterBand} options.dst Output raster band. It may be the same
+ * as src band to update the source in place.
+ * @param {gdal.RasterBand} [options.mask] All pixels in the mask band with a
+ * value other than zero will be considered suitable for inclusion in polygons.
+ * @param {Number} options.threshold Raster polygons with sizes smaller than
+ * this will be merged into their largest neighbour.
+ * @param {integer} [options.connectedness=4] Either 4 indicating that diagonal
+ * pixels are not considered directly adjacent for polygon membership purposes
+ * or 8 indicating they are.
+ * @param {AbortSignal} [options.signal] Aborts the operation when signaled
+ * @param {ProgressCb} [options.progress_cb] Called with the completion ratio, between 0 and 1
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter, can be specified even if
+ * certain optional parameters are omitted
+ * @return {Promise<void>}
+ */
+NAN_METHOD(Algorithms::sieveFilterAsync) {
+  _do_sieve_filter(info, true);
+}
+
 /**
  * Compute checksum for image region.
  *
@@ -253,29 +484,9 @@ NAN_METHOD(Algorithms::checksumImage) {
 }
 
 /**
- * Creates vector polygons for all connected regions of pixels in the raster
- * sharing a common pixel value. Each polygon is created with an attribute
- * indicating the pixel value of that polygon. A raster mask may also be
- * provided to determine which pixels are eligible for processing.
- *
- * @throws Error
- * @method polygonize
- * @static
- * @for gdal
- * @param {Object} options
- * @param {gdal.RasterBand} options.src
- * @param {gdal.Layer} options.dst
- * @param {gdal.RasterBand} [options.mask]
- * @param {integer} options.pixValField The attribute field index indicating the
- * feature attribute into which the pixel value of the polygon should be
- * written.
- * @param {integer} [options.connectedness=4] Either 4 indicating that diagonal
- * pixels are not considered directly adjacent for polygon membership purposes
- * or 8 indicating they are.
- * @param {Boolean} [options.useFloats=false] Use floating point buffers instead
- * of int buffers.
+ * Low level polygonization for both synchronous and asynchronous execution.
  */
-NAN_METHOD(Algorithms::polygonize) {
+static void _do_polygonize(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async) {
   Nan::HandleScope scope;
 
   Local<Object> obj;
@@ -284,7 +495,7 @@ NAN_METHOD(Algorithms::polygonize) {
   Layer *dst;
   int connectedness = 4;
   int pix_val_field = 0;
-  char **papszOptions = NULL;
+  bool use_floats = false;
 
   NODE_ARG_OBJECT(0, "options", obj);
 
@@ -294,38 +505,74 @@ NAN_METHOD(Algorithms::polygonize) {
   NODE_INT_FROM_OBJ_OPT(obj, "connectedness", connectedness)
   NODE_INT_FROM_OBJ(obj, "pixValField", pix_val_field);
 
-  if (connectedness == 8) {
-    papszOptions = CSLSetNameValue(papszOptions, "8CONNECTED", "8");
-  } else if (connectedness != 4) {
+  if (connectedness != 4 && connectedness != 8) {
     Nan::ThrowError("connectedness must be 4 or 8");
     return;
   }
-
-  CPLErr err;
   if (
     Nan::HasOwnProperty(obj, Nan::New("useFloats").ToLocalChecked()).FromMaybe(false) &&
     Nan::To<bool>(Nan::Get(obj, Nan::New("useFloats").ToLocalChecked()).ToLocalChecked()).ToChecked()) {
-    err = GDALFPolygonize(
-      src->get(),
-      mask ? mask->get() : NULL,
-      reinterpret_cast<OGRLayerH>(dst->get()),
-      pix_val_field,
-      papszOptions,
-      NULL,
-      NULL);
-  } else {
-    err = GDALPolygonize(
-      src->get(),
-      mask ? mask->get() : NULL,
-      reinterpret_cast<OGRLayerH>(dst->get()),
-      pix_val_field,
-      papszOptions,
-      NULL,
-      NULL);
+    use_floats = true;
   }
 
-  if (papszOptions) CSLDestroy(papszOptions);
+  GDALRasterBand *gdal_src = src->get();
+  GDALRasterBand *gdal_mask = mask ? mask->get() : NULL;
+  OGRLayer *ogr_dst = dst->get();
+  std::vector<uv_mutex_t *> locks = {src->async_lock, dst->async_lock};
+  if (mask) locks.push_back(mask->async_lock);
+
+  AsyncGDALWorker::Job doit = [gdal_src, gdal_mask, ogr_dst, pix_val_field, connectedness, use_floats, locks](
+                                GDALProgressFunc pfnProgress, void *pProgressArg) mutable {
+    char **papszOptions = NULL;
+    if (connectedness == 8) papszOptions = CSLSetNameValue(papszOptions, "8CONNECTED", "8");
+
+    CPLErr err;
+    AsyncGDALWorker::lock(locks);
+    if (use_floats) {
+      err = GDALFPolygonize(
+        gdal_src,
+        gdal_mask,
+        reinterpret_cast<OGRLayerH>(ogr_dst),
+        pix_val_field,
+        papszOptions,
+        pfnProgress,
+        pProgressArg);
+    } else {
+      err = GDALPolygonize(
+        gdal_src,
+        gdal_mask,
+        reinterpret_cast<OGRLayerH>(ogr_dst),
+        pix_val_field,
+        papszOptions,
+        pfnProgress,
+        pProgressArg);
+    }
+    AsyncGDALWorker::unlock(locks);
+
+    if (papszOptions) CSLDestroy(papszOptions);
+    return err;
+  };
+
+  if (async) {
+    Nan::Callback *callback, *progress_cb = NULL;
+    NODE_ARG_CB(3, "callback", callback);
+    NODE_ARG_CB_OPT(2, "progress_cb", progress_cb);
+    // the features written into the layer make its spatial index stale
+    dst->spatial_index.reset();
+    AsyncGDALWorker::Result rval = [dst]() {
+      if (dst->isAlive()) dst->spatial_index.reset();
+      return Nan::Undefined().As<Value>();
+    };
+    AsyncGDALWorker *worker = new AsyncGDALWorker(callback, "node-gdal:Polygonize", info[1], progress_cb, doit, rval);
+    worker->persist(src->handle());
+    worker->persist(dst->handle());
+    if (mask) worker->persist(mask->handle());
+    Nan::AsyncQueueWorker(worker);
+    return;
+  }
 
+  CPLErr err = doit(NULL, NULL);
+  dst->spatial_index.reset();
   if (err) {
     NODE_THROW_CPLERR(err);
     return;
@@ -334,4 +581,1296 @@ NAN_METHOD(Algorithms::polygonize) {
   return;
 }
 
+/**
+ * Creates vector polygons for all connected regions of pixels in the raster
+ * sharing a common pixel value. Each polygon is created with an attribute
+ * indicating the pixel value of that polygon. A raster mask may also be
+ * provided to determine which pixels are eligible for processing.
+ *
+ * @throws Error
+ * @method polygonize
+ * @static
+ * @for gdal
+ * @param {Object} options
+ * @param {gdal.RasterBand} options.src
+ * @param {gdal.Layer} options.dst
+ * @param {gdal.RasterBand} [options.mask]
+ * @param {integer} options.pixValField The attribute field index indicating the
+ * feature attribute into which the pixel value of the polygon should be
+ * written.
+ * @param {integer} [options.connectedness=4] Either 4 indicating that diagonal
+ * pixels are not considered directly adjacent for polygon membership purposes
+ * or 8 indicating they are.
+ * @param {Boolean} [options.useFloats=false] Use floating point buffers instead
+ * of int buffers.
+ */
+NAN_METHOD(Algorithms::polygonize) {
+  _do_polygonize(info, false);
+}
+
+/**
+ * Asynchronously creates vector polygons for all connected regions of pixels in the raster
+ * sharing a common pixel value. Each polygon is created with an attribute
+ * indicating the pixel value of that polygon. A raster mask may also be
+ * provided to determine which pixels are eligible for processing.
+ *
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved on completion.
+ * The operation can be aborted with an
+ * [AbortSignal](https://developer.mozilla.org/en-US/docs/Web/API/AbortSignal), the Promise is then
+ * rejected with an `AbortError`.
+ *
+ * @throws Error
+ * @method polygonizeAsync
+ * @static
+ * @for gdal
+ * @param {Object} options
+ * @param {gdal.RasterBand} options.src
+ * @param {gdal.Layer} options.dst
+ * @param {gdal.RasterBand} [options.mask]
+ * @param {integer} options.pixValField The attribute field index indicating the
+ * feature attribute into which the pixel value of the polygon should be
+ * written.
+ * @param {integer} [options.connectedness=4] Either 4 indicating that diagonal
+ * pixels are not considered directly adjacent for polygon membership purposes
+ * or 8 indicating they are.
+ * @param {Boolean} [options.useFloats=false] Use floating point buffers instead
+ * of int buffers.
+ * @param {AbortSignal} [options.signal] Aborts the operation when signaled
+ * @param {ProgressCb} [options.progress_cb] Called with the completion ratio, between 0 and 1
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter, can be specified even if
+ * certain optional parameters are omitted
+ * @return {Promise<void>}
+ */
+NAN_METHOD(Algorithms::polygonizeAsync) {
+  _do_polygonize(info, true);
+}
+
+enum ZonalStat { ZONAL_COUNT = 1, ZONAL_SUM = 2, ZONAL_MEAN = 4, ZONAL_MIN = 8, ZONAL_MAX = 16 };
+
+struct Zone {
+  GIntBig fid;
+  std::unique_ptr<OGRGeometry> geometry;
+  int x, y, width, height;
+  double count, sum, min, max;
+};
+
+/*
+ * Converts the envelope of a geometry to a pixel window clipped to the raster,
+ * the window is empty when the geometry is outside of the raster
+ */
+static void zoneWindow(Zone &zone, const double *inv_gt, int x_size, int y_size) {
+  zone.x = zone.y = zone.width = zone.height = 0;
+  if (!zone.geometry || zone.geometry->IsEmpty()) return;
+
+  OGREnvelope envelope;
+  zone.geometry->getEnvelope(&envelope);
+  double corners[4][2] = {
+    {envelope.MinX, envelope.MinY},
+    {envelope.MinX, envelope.MaxY},
+    {envelope.MaxX, envelope.MinY},
+    {envelope.MaxX, envelope.MaxY}};
+  double min_x = std::numeric_limits<double>::infinity(), min_y = min_x;
+  double max_x = -min_x, max_y = -min_x;
+  for (auto &corner : corners) {
+    double px, py;
+    GDALApplyGeoTransform(const_cast<double *>(inv_gt), corner[0], corner[1], &px, &py);
+    min_x = std::min(min_x, px);
+    max_x = std::max(max_x, px);
+    min_y = std::min(min_y, py);
+    max_y = std::max(max_y, py);
+  }
+
+  // one extra pixel on each side for the pixels touched by the boundary
+  double x0 = std::max(0.0, std::floor(min_x) - 1), y0 = std::max(0.0, std::floor(min_y) - 1);
+  double x1 = std::min((double)x_size, std::ceil(max_x) + 1), y1 = std::min((double)y_size, std::ceil(max_y) + 1);
+  if (x1 <= x0 || y1 <= y0) return;
+  zone.x = (int)x0;
+  zone.y = (int)y0;
+  zone.width = (int)(x1 - x0);
+  zone.height = (int)(y1 - y0);
+}
+
+/*
+ * Rasterizes the geometry of a zone on its window and accumulates the values of
+ * the pixels it covers, only the RasterIO on the shared band is serialized
+ */
+static bool accumulateZone(
+  Zone &zone,
+  GDALRasterBand *band,
+  const double *gt,
+  bool all_touched,
+  bool has_nodata,
+  double nodata,
+  std::mutex &io_lock,
+  std::vector<GByte> &mask,
+  std::vector<double> &values) {
+  if (zone.width == 0) return true;
+
+  size_t n = (size_t)zone.width * zone.height;
+  mask.assign(n, 0);
+  values.resize(n);
+
+  GDALDriver *mem_driver = GetGDALDriverManager()->GetDriverByName("MEM");
+  if (!mem_driver) {
+    CPLError(CE_Failure, CPLE_AppDefined, "MEM driver is not available");
+    return false;
+  }
+  std::unique_ptr<GDALDataset> mask_ds(mem_driver->Create("", zone.width, zone.height, 1, GDT_Byte, NULL));
+  if (!mask_ds) return false;
+  double window_gt[6] = {
+    gt[0] + zone.x * gt[1] + zone.y * gt[2],
+    gt[1],
+    gt[2],
+    gt[3] + zone.x * gt[4] + zone.y * gt[5],
+    gt[4],
+    gt[5]};
+  mask_ds->SetGeoTransform(window_gt);
+
+  int band_list = 1;
+  double burn_value = 1;
+  OGRGeometryH geometry = reinterpret_cast<OGRGeometryH>(zone.geometry.get());
+  char **options = NULL;
+  if (all_touched) options = CSLSetNameValue(options, "ALL_TOUCHED", "TRUE");
+  GDALDatasetH mask_hds = reinterpret_cast<GDALDatasetH>(mask_ds.get());
+  CPLErr err =
+    GDALRasterizeGeometries(mask_hds, 1, &band_list, 1, &geometry, NULL, NULL, &burn_value, options, NULL, NULL);
+  CSLDestroy(options);
+  if (err != CE_None) return false;
+  err = mask_ds->GetRasterBand(1)->RasterIO(
+    GF_Read, 0, 0, zone.width, zone.height, mask.data(), zone.width, zone.height, GDT_Byte, 0, 0, NULL);
+  if (err != CE_None) return false;
+
+  {
+    std::lock_guard<std::mutex> guard(io_lock);
+    err = band->RasterIO(
+      GF_Read,
+      zone.x,
+      zone.y,
+      zone.width,
+      zone.height,
+      values.data(),
+      zone.width,
+      zone.height,
+      GDT_Float64,
+      0,
+      0,
+      NULL);
+  }
+  if (err != CE_None) return false;
+
+  double count = 0, sum = 0, min = zone.min, max = zone.max;
+  for (size_t i = 0; i < n; i++) {
+    double v = values[i];
+    if (!mask[i] || std::isnan(v) || (has_nodata && v == nodata)) continue;
+    count++;
+    sum += v;
+    if (v < min) min = v;
+    if (v > max) max = v;
+  }
+  zone.count = count;
+  zone.sum = sum;
+  zone.min = min;
+  zone.max = max;
+  return true;
+}
+
+static int parseZonalStats(Local<Array> stats) {
+  int flags = 0;
+  for (unsigned i = 0; i < stats->Length(); i++) {
+    Local<Value> val = Nan::Get(stats, i).ToLocalChecked();
+    std::string name = val->IsString() ? *Nan::Utf8String(val) : "";
+    if (name == "count")
+      flags |= ZONAL_COUNT;
+    else if (name == "sum")
+      flags |= ZONAL_SUM;
+    else if (name == "mean")
+      flags |= ZONAL_MEAN;
+    else if (name == "min")
+      flags |= ZONAL_MIN;
+    else if (name == "max")
+      flags |= ZONAL_MAX;
+    else {
+      Nan::ThrowRangeError("stats must contain only \"count\", \"sum\", \"mean\", \"min\" or \"max\"");
+      return -1;
+    }
+  }
+  return flags;
+}
+
+/**
+ * Low level zonal statistics for both synchronous and asynchronous execution.
+ */
+static void _do_zonal_stats(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async) {
+  Nan::HandleScope scope;
+
+  RasterBand *band;
+  Layer *layer;
+  Local<Object> options;
+  int flags = ZONAL_COUNT | ZONAL_SUM | ZONAL_MEAN | ZONAL_MIN | ZONAL_MAX;
+  bool all_touched = false;
+  int threads = 1;
+
+  NODE_ARG_WRAPPED(0, "band", RasterBand, band);
+  NODE_ARG_WRAPPED(1, "layer", Layer, layer);
+  if (info.Length() > 2 && !info[2]->IsUndefined() && !info[2]->IsNull()) {
+    NODE_ARG_OBJECT(2, "options", options);
+    NODE_BOOL_FROM_OBJ_OPT(options, "allTouched", all_touched);
+    NODE_INT_FROM_OBJ_OPT(options, "threads", threads);
+    Local<String> sym = Nan::New("stats").ToLocalChecked();
+    if (Nan::HasOwnProperty(options, sym).FromMaybe(false)) {
+      Local<Value> stats = Nan::Get(options, sym).ToLocalChecked();
+      if (!stats->IsArray()) {
+        Nan::ThrowTypeError("Property \"stats\" must be an array");
+        return;
+      }
+      if ((flags = parseZonalStats(stats.As<Array>())) < 0) return;
+    }
+  }
+  if (threads < 1) {
+    Nan::ThrowRangeError("threads must be a positive integer");
+    return;
+  }
+
+  GDALRasterBand *gdal_band = band->get();
+  OGRLayer *ogr_layer = layer->get();
+  std::vector<uv_mutex_t *> locks = {band->async_lock, layer->async_lock};
+  std::shared_ptr<std::vector<Zone>> zones = std::make_shared<std::vector<Zone>>();
+
+  AsyncGDALWorker::Job doit = [gdal_band, layer, ogr_layer, all_touched, threads, zones, locks](
+                                GDALProgressFunc pfnProgress, void *pProgressArg) mutable {
+    AsyncGDALWorker::lock(locks);
+
+    GDALDataset *ds = gdal_band->GetDataset();
+    double gt[6], inv_gt[6];
+    if (!ds || ds->GetGeoTransform(gt) != CE_None) {
+      AsyncGDALWorker::unlock(locks);
+      CPLError(CE_Failure, CPLE_AppDefined, "The raster has no geotransform");
+      return CE_Failure;
+    }
+    int x_size = gdal_band->GetXSize(), y_size = gdal_band->GetYSize();
+    // overview bands share the geotransform of their dataset at a lower resolution
+    double x_ratio = (double)ds->GetRasterXSize() / x_size, y_ratio = (double)ds->GetRasterYSize() / y_size;
+    gt[1] *= x_ratio;
+    gt[4] *= x_ratio;
+    gt[2] *= y_ratio;
+    gt[5] *= y_ratio;
+    if (!GDALInvGeoTransform(gt, inv_gt)) {
+      AsyncGDALWorker::unlock(locks);
+      CPLError(CE_Failure, CPLE_AppDefined, "The geotransform of the raster is not invertible");
+      return CE_Failure;
+    }
+    int has_nodata;
+    double nodata = gdal_band->GetNoDataValue(&has_nodata);
+
+    ogr_layer->ResetReading();
+    layer->dropPendingFeature();
+    OGRFeature *feature;
+    while ((feature = ogr_layer->GetNextFeature()) != NULL) {
+      Zone zone;
+      zone.fid = feature->GetFID();
+      zone.geometry.reset(feature->StealGeometry());
+      zone.count = zone.sum = 0;
+      zone.min = std::numeric_limits<double>::infinity();
+      zone.max = -zone.min;
+      zoneWindow(zone, inv_gt, x_size, y_size);
+      zones->push_back(std::move(zone));
+      OGRFeature::DestroyFeature(feature);
+    }
+
+    std::mutex io_lock, err_lock;
+    std::atomic<size_t> next(0), done(0);
+    std::atomic<bool> failed(false);
+    std::string err_msg;
+    size_t total = zones->size();
+
+    auto scan = [&](bool report) {
+      std::vector<GByte> mask;
+      std::vector<double> values;
+      size_t i;
+      while (!failed && (i = next++) < total) {
+        if (!accumulateZone((*zones)[i], gdal_band, gt, all_touched, has_nodata, nodata, io_lock, mask, values)) {
+          std::lock_guard<std::mutex> guard(err_lock);
+          if (!failed) err_msg = CPLGetLastErrorNo() ? CPLGetLastErrorMsg() : "Failed computing zonal statistics";
+          failed = true;
+        }
+        (*zones)[i].geometry.reset();
+        done++;
+        if (report && pfnProgress && !pfnProgress((double)done / total, NULL, pProgressArg)) {
+          std::lock_guard<std::mutex> guard(err_lock);
+          if (!failed) err_msg = "User terminated";
+          failed = true;
+        }
+      }
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads && (size_t)t < total; t++) workers.push_back(std::thread(scan, false));
+    scan(true);
+    for (std::thread &worker : workers) worker.join();
+
+    AsyncGDALWorker::unlock(locks);
+    if (failed) {
+      // CPL errors are thread-local, the message of the failed thread is raised again in this one
+      CPLError(CE_Failure, CPLE_AppDefined, "%s", err_msg.c_str());
+      return CE_Failure;
+    }
+    return CE_None;
+  };
+
+  AsyncGDALWorker::Result rval = [zones, flags]() {
+    Nan::EscapableHandleScope scope;
+    Local<Array> result = Nan::New<Array>(zones->size());
+    for (size_t i = 0; i < zones->size(); i++) {
+      const Zone &zone = (*zones)[i];
+      Local<Object> obj = Nan::New<Object>();
+      double nan = std::numeric_limits<double>::quiet_NaN();
+      double mean = zone.count ? zone.sum / zone.count : nan;
+      Nan::Set(obj, Nan::New("fid").ToLocalChecked(), Nan::New<Number>(zone.fid));
+      if (flags & ZONAL_COUNT) Nan::Set(obj, Nan::New("count").ToLocalChecked(), Nan::New<Number>(zone.count));
+      if (flags & ZONAL_SUM) Nan::Set(obj, Nan::New("sum").ToLocalChecked(), Nan::New<Number>(zone.sum));
+      if (flags & ZONAL_MEAN) Nan::Set(obj, Nan::New("mean").ToLocalChecked(), Nan::New<Number>(mean));
+      if (flags & ZONAL_MIN)
+        Nan::Set(obj, Nan::New("min").ToLocalChecked(), Nan::New<Number>(zone.count ? zone.min : nan));
+      if (flags & ZONAL_MAX)
+        Nan::Set(obj, Nan::New("max").ToLocalChecked(), Nan::New<Number>(zone.count ? zone.max : nan));
+      Nan::Set(result, i, obj);
+    }
+    return scope.Escape(result.As<Value>());
+  };
+
+  if (async) {
+    Nan::Callback *callback, *progress_cb = NULL;
+    NODE_ARG_CB(5, "callback", callback);
+    NODE_ARG_CB_OPT(4, "progress_cb", progress_cb);
+    AsyncGDALWorker *worker = new AsyncGDALWorker(callback, "node-gdal:ZonalStats", info[3], progress_cb, doit, rval);
+    worker->persist(band->handle());
+    worker->persist(layer->handle());
+    Nan::AsyncQueueWorker(worker);
+    return;
+  }
+
+  CPLErr err = doit(NULL, NULL);
+  if (err) {
+    NODE_THROW_LAST_CPLERR();
+    return;
+  }
+
+  info.GetReturnValue().Set(rval());
+}
+
+/**
+ * Computes the statistics of the pixels of a raster band covered by each
+ * feature of a layer.
+ *
+ * The geometry of each feature matching the filters of the layer is rasterized
+ * on its window of the band, the pixels set to the nodata value of the band are ignored. The layer must be
+ * in the spatial reference system of the raster. The features can be
+ * processed by several threads, only the reading of the band is serialized.
+ *
+ * @example
+ * ```
+ * var results = gdal.zonalStats(band, layer, {stats: ['mean', 'max']});
+ * results.forEach(function(r) {
+ *   console.log(r.fid, r.mean, r.max);
+ * });```
+ *
+ * @throws Error
+ * @method zonalStats
+ * @static
+ * @for gdal
+ * @param {gdal.RasterBand} band
+ * @param {gdal.Layer} layer
+ * @param {Object} [options]
+ * @param {String[]} [options.stats=["count","sum","mean","min","max"]] the statistics to compute
+ * @param {Boolean} [options.allTouched=false] include all the pixels touched by the geometries
+ * instead of only the pixels whose center is inside
+ * @param {Integer} [options.threads=1] the number of threads
+ * @return {Object[]} One object per feature with `fid` and the requested statistics,
+ * `mean`, `min` and `max` are `NaN` when the feature covers no valid pixel
+ */
+NAN_METHOD(Algorithms::zonalStats) {
+  _do_zonal_stats(info, false);
+}
+
+/**
+ * Asynchronously computes the statistics of the pixels of a raster band
+ * covered by each feature of a layer.
+ *
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ * The operation can be aborted with an
+ * [AbortSignal](https://developer.mozilla.org/en-US/docs/Web/API/AbortSignal), the Promise is then
+ * rejected with an `AbortError`.
+ *
+ * @throws Error
+ * @method zonalStatsAsync
+ * @static
+ * @for gdal
+ * @param {gdal.RasterBand} band
+ * @param {gdal.Layer} layer
+ * @param {Object} [options]
+ * @param {String[]} [options.stats=["count","sum","mean","min","max"]] the statistics to compute
+ * @param {Boolean} [options.allTouched=false] include all the pixels touched by the geometries
+ * instead of only the pixels whose center is inside
+ * @param {Integer} [options.threads=1] the number of threads
+ * @param {AbortSignal} [options.signal] Aborts the operation when signaled
+ * @param {ProgressCb} [options.progress_cb] Called with the completion ratio, between 0 and 1
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter, can be specified even if
+ * certain optional parameters are omitted
+ * @return {Promise<Object[]>}
+ */
+NAN_METHOD(Algorithms::zonalStatsAsync) {
+  _do_zonal_stats(info, true);
+}
+
+struct CalcInput {
+  GDALRasterBand *band;
+  bool has_nodata;
+  double nodata;
+};
+
+/**
+ * Low level calc for both synchronous and asynchronous execution.
+ */
+static void _do_calc(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async) {
+  Nan::HandleScope scope;
+
+  Local<Object> inputs_obj;
+  std::string expression;
+  RasterBand *dst;
+  Local<Object> options;
+  int threads = 1;
+
+  NODE_ARG_OBJECT(0, "inputs", inputs_obj);
+  NODE_ARG_STR(1, "expression", expression);
+  NODE_ARG_WRAPPED(2, "dst", RasterBand, dst);
+  if (info.Length() > 3 && !info[3]->IsUndefined() && !info[3]->IsNull()) {
+    NODE_ARG_OBJECT(3, "options", options);
+    NODE_INT_FROM_OBJ_OPT(options, "threads", threads);
+  }
+  if (threads < 1) {
+    Nan::ThrowRangeError("threads must be a positive integer");
+    return;
+  }
+
+  GDALRasterBand *gdal_dst = dst->get();
+  int x_size = gdal_dst->GetXSize(), y_size = gdal_dst->GetYSize();
+  std::vector<uv_mutex_t *> locks = {dst->async_lock};
+  std::vector<Local<Object>> persistent = {dst->handle()};
+  std::vector<std::string> names;
+  std::vector<CalcInput> inputs;
+
+  Local<Array> keys = Nan::GetOwnPropertyNames(inputs_obj).ToLocalChecked();
+  for (unsigned i = 0; i < keys->Length(); i++) {
+    Local<Value> key = Nan::Get(keys, i).ToLocalChecked();
+    Local<Value> val = Nan::Get(inputs_obj, key).ToLocalChecked();
+    std::string name = *Nan::Utf8String(key);
+    if (!IS_WRAPPED(val, RasterBand)) {
+      Nan::ThrowTypeError(("inputs." + name + " must be an instance of RasterBand").c_str());
+      return;
+    }
+    RasterBand *band = Nan::ObjectWrap::Unwrap<RasterBand>(val.As<Object>());
+    if (!band->isAlive()) {
+      Nan::ThrowError(("inputs." + name + " has already been destroyed").c_str());
+      return;
+    }
+    GDALRasterBand *gdal_band = band->get();
+    if (gdal_band->GetXSize() != x_size || gdal_band->GetYSize() != y_size) {
+      Nan::ThrowError(("inputs." + name + " must have the same size as dst").c_str());
+      return;
+    }
+    int has_nodata;
+    double nodata = gdal_band->GetNoDataValue(&has_nodata);
+    inputs.push_back({gdal_band, has_nodata != 0, nodata});
+    names.push_back(name);
+    locks.push_back(band->async_lock);
+    persistent.push_back(band->handle());
+  }
+
+  int dst_has_nodata;
+  double dst_nodata = gdal_dst->GetNoDataValue(&dst_has_nodata);
+  if (!dst_has_nodata) dst_nodata = std::numeric_limits<double>::quiet_NaN();
+
+  std::string error;
+  std::shared_ptr<RasterExpression> kernel(RasterExpression::compile(expression, names, dst_nodata, error));
+  if (!kernel) {
+    Nan::ThrowError(error.c_str());
+    return;
+  }
+
+  AsyncGDALWorker::Job doit = [gdal_dst, inputs, kernel, dst_nodata, threads, locks](
+                                GDALProgressFunc pfnProgress, void *pProgressArg) mutable {
+    int x_size = gdal_dst->GetXSize(), y_size = gdal_dst->GetYSize();
+    int block_x, block_y;
+    gdal_dst->GetBlockSize(&block_x, &block_y);
+    // windows are aligned on the blocks of dst, small blocks such as
+    // single line strips are grouped to amortize the cost of the I/O
+    int rows = block_y * std::max(1, 65536 / std::max(1, block_x * block_y));
+    std::vector<std::pair<int, int>> windows;
+    for (int y = 0; y < y_size; y += rows)
+      for (int x = 0; x < x_size; x += block_x) windows.push_back(std::make_pair(x, y));
+
+    std::mutex io_lock, err_lock;
+    std::atomic<size_t> next(0), done(0);
+    std::atomic<bool> failed(false);
+    std::string err_msg;
+    size_t total = windows.size();
+
+    auto scan = [&](bool report) {
+      std::vector<double> in_buffers(inputs.size() * block_x * rows), out(block_x * rows);
+      std::vector<double> scratch(kernel->scratchSize());
+      std::vector<const double *> chunk_inputs(inputs.size());
+      size_t i;
+      while (!failed && (i = next++) < total) {
+        int x = windows[i].first, y = windows[i].second;
+        int w = std::min(block_x, x_size - x), h = std::min(rows, y_size - y);
+        size_t n = (size_t)w * h;
+
+        CPLErr err = CE_None;
+        {
+          std::lock_guard<std::mutex> guard(io_lock);
+          for (size_t j = 0; j < inputs.size() && err == CE_None; j++) {
+            err = inputs[j].band->RasterIO(
+              GF_Read, x, y, w, h, &in_buffers[j * n], w, h, GDT_Float64, 0, 0, NULL);
+          }
+        }
+
+        if (err == CE_None) {
+          for (size_t offset = 0; offset < n; offset += RasterExpression::CHUNK_SIZE) {
+            size_t len = std::min(RasterExpression::CHUNK_SIZE, n - offset);
+            for (size_t j = 0; j < inputs.size(); j++) chunk_inputs[j] = &in_buffers[j * n + offset];
+            kernel->evaluate(chunk_inputs.data(), len, scratch.data(), &out[offset]);
+          }
+          for (size_t j = 0; j < inputs.size(); j++) {
+            if (!inputs[j].has_nodata) continue;
+            const double *values = &in_buffers[j * n];
+            double nodata = inputs[j].nodata;
+            for (size_t k = 0; k < n; k++) {
+              if (values[k] == nodata) out[k] = dst_nodata;
+            }
+          }
+          std::lock_guard<std::mutex> guard(io_lock);
+          err = gdal_dst->RasterIO(GF_Write, x, y, w, h, out.data(), w, h, GDT_Float64, 0, 0, NULL);
+        }
+
+        if (err != CE_None) {
+          std::lock_guard<std::mutex> guard(err_lock);
+          if (!failed) err_msg = CPLGetLastErrorNo() ? CPLGetLastErrorMsg() : "Failed evaluating the expression";
+          failed = true;
+        }
+        done++;
+        if (report && pfnProgress && !pfnProgress((double)done / total, NULL, pProgressArg)) {
+          std::lock_guard<std::mutex> guard(err_lock);
+          if (!failed) err_msg = "User terminated";
+          failed = true;
+        }
+      }
+    };
+
+    AsyncGDALWorker::lock(locks);
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads && (size_t)t < total; t++) workers.push_back(std::thread(scan, false));
+    scan(true);
+    for (std::thread &worker : workers) worker.join();
+    AsyncGDALWorker::unlock(locks);
+
+    if (failed) {
+      // CPL errors are thread-local, the message of the failed thread is raised again in this one
+      CPLError(CE_Failure, CPLE_AppDefined, "%s", err_msg.c_str());
+      return CE_Failure;
+    }
+    return CE_None;
+  };
+
+  if (async) {
+    Nan::Callback *callback, *progress_cb = NULL;
+    NODE_ARG_CB(6, "callback", callback);
+    NODE_ARG_CB_OPT(5, "progress_cb", progress_cb);
+    AsyncGDALWorker *worker = new AsyncGDALWorker(callback, "node-gdal:Calc", info[4], progress_cb, doit);
+    for (Local<Object> &obj : persistent) worker->persist(obj);
+    Nan::AsyncQueueWorker(worker);
+    return;
+  }
+
+  CPLErr err = doit(NULL, NULL);
+  if (err) {
+    NODE_THROW_LAST_CPLERR();
+    return;
+  }
+
+  return;
+}
+
+/**
+ * Computes a raster band from an expression evaluated on each pixel of the
+ * input bands.
+ *
+ * The expression is compiled once and evaluated natively on windows aligned
+ * on the blocks of `dst`, the windows can be processed by several threads.
+ * The values are computed in double precision and converted to the data type
+ * of `dst` when written. The pixels where one of the inputs is set to its
+ * nodata value are set to the nodata value of `dst`, or to `NaN` if it has none.
+ *
+ * The expression supports numbers, the names of the inputs, `nodata` (the
+ * nodata value of `dst`), `pi`, the operators `+ - * / % ^`, `< <= > >= == !=`,
+ * `&& || !`, parentheses and the functions `where(condition, a, b)`, `abs`,
+ * `sqrt`, `exp`, `log`, `log10`, `sin`, `cos`, `tan`, `asin`, `acos`, `atan`,
+ * `atan2`, `floor`, `ceil`, `round`, `min`, `max`, `pow` and `isnan`.
+ * Comparisons and logical operators return `1` or `0`.
+ *
+ * @example
+ * ```
+ * // NDVI
+ * gdal.calc({a: nir, b: red}, 'where(a+b>0,(a-b)/(a+b),nodata)', ndvi);```
+ *
+ * @throws Error
+ * @method calc
+ * @static
+ * @for gdal
+ * @param {Object} inputs an object whose properties are the input bands
+ * ({{#crossLink "gdal.RasterBand"}}gdal.RasterBand{{/crossLink}}), all of the size of `dst`
+ * @param {String} expression
+ * @param {gdal.RasterBand} dst
+ * @param {Object} [options]
+ * @param {Integer} [options.threads=1] the number of threads
+ */
+NAN_METHOD(Algorithms::calc) {
+  _do_calc(info, false);
+}
+
+/**
+ * Asynchronously computes a raster band from an expression evaluated on each
+ * pixel of the input bands.
+ *
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved on completion.
+ * The operation can be aborted with an
+ * [AbortSignal](https://developer.mozilla.org/en-US/docs/Web/API/AbortSignal), the Promise is then
+ * rejected with an `AbortError`.
+ *
+ * @throws Error
+ * @method calcAsync
+ * @static
+ * @for gdal
+ * @param {Object} inputs an object whose properties are the input bands
+ * ({{#crossLink "gdal.RasterBand"}}gdal.RasterBand{{/crossLink}}), all of the size of `dst`
+ * @param {String} expression
+ * @param {gdal.RasterBand} dst
+ * @param {Object} [options]
+ * @param {Integer} [options.threads=1] the number of threads
+ * @param {AbortSignal} [options.signal] Aborts the operation when signaled
+ * @param {ProgressCb} [options.progress_cb] Called with the completion ratio, between 0 and 1
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter, can be specified even if
+ * certain optional parameters are omitted
+ * @return {Promise<void>}
+ */
+NAN_METHOD(Algorithms::calcAsync) {
+  _do_calc(info, true);
+}
+
+/**
+ * Low level rasterize for both synchronous and asynchronous execution.
+ */
+static void _do_rasterize(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async) {
+  Nan::HandleScope scope;
+
+  Dataset *dst;
+  Local<Object> obj;
+  std::vector<Local<Value>> layer_values;
+  std::vector<OGRLayerH> layers;
+  IntegerList band_array;
+  DoubleList burn_array;
+  std::vector<int> bands;
+  std::vector<double> burn_values;
+  std::string attribute, merge_alg;
+  bool all_touched = false;
+  int chunk_y_size = 0;
+
+  NODE_ARG_WRAPPED(0, "dst", Dataset, dst);
+  if (info.Length() < 2) {
+    Nan::ThrowError("layer must be given");
+    return;
+  }
+  if (info[1]->IsArray()) {
+    Local<Array> array = info[1].As<Array>();
+    for (unsigned i = 0; i < array->Length(); i++) layer_values.push_back(Nan::Get(array, i).ToLocalChecked());
+  } else {
+    layer_values.push_back(info[1]);
+  }
+  if (info.Length() > 2 && !info[2]->IsUndefined() && !info[2]->IsNull()) {
+    NODE_ARG_OBJECT(2, "options", obj);
+    if (Nan::HasOwnProperty(obj, Nan::New("bands").ToLocalChecked()).FromMaybe(false)) {
+      if (band_array.parse(Nan::Get(obj, Nan::New("bands").ToLocalChecked()).ToLocalChecked())) return;
+      bands.assign(band_array.get(), band_array.get() + band_array.length());
+    }
+    if (Nan::HasOwnProperty(obj, Nan::New("burnValues").ToLocalChecked()).FromMaybe(false)) {
+      if (burn_array.parse(Nan::Get(obj, Nan::New("burnValues").ToLocalChecked()).ToLocalChecked())) return;
+      burn_values.assign(burn_array.get(), burn_array.get() + burn_array.length());
+    }
+    NODE_STR_FROM_OBJ_OPT(obj, "attribute", attribute);
+    NODE_BOOL_FROM_OBJ_OPT(obj, "allTouched", all_touched);
+    NODE_STR_FROM_OBJ_OPT(obj, "mergeAlg", merge_alg);
+    NODE_INT_FROM_OBJ_OPT(obj, "chunkYSize", chunk_y_size);
+  }
+
+  GDALDataset *gdal_dst = dst->getDataset();
+  if (!gdal_dst) {
+    Nan::ThrowError("Dataset object has already been destroyed");
+    return;
+  }
+  std::vector<uv_mutex_t *> locks = {dst->async_lock};
+  // the layers are persisted one by one, the array may be emptied while the worker runs
+  std::vector<Local<Object>> persistent = {dst->handle()};
+  for (Local<Value> val : layer_values) {
+    if (!IS_WRAPPED(val, Layer)) {
+      Nan::ThrowTypeError("layer must be a Layer or an array of Layers");
+      return;
+    }
+    Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(val.As<Object>());
+    if (!layer->isAlive()) {
+      Nan::ThrowError("Layer object has already been destroyed");
+      return;
+    }
+    layers.push_back(reinterpret_cast<OGRLayerH>(layer->get()));
+    locks.push_back(layer->async_lock);
+    persistent.push_back(layer->handle());
+  }
+  if (layers.empty()) {
+    Nan::ThrowError("layer must not be empty");
+    return;
+  }
+
+  // one band per burn value, the first band by default
+  if (bands.empty()) {
+    for (size_t i = 0; i < std::max<size_t>(1, burn_values.size()); i++) bands.push_back((int)i + 1);
+  }
+  for (int band : bands) {
+    if (band < 1 || band > gdal_dst->GetRasterCount()) {
+      Nan::ThrowRangeError("Invalid band number");
+      return;
+    }
+  }
+  if (burn_values.empty()) burn_values.assign(bands.size(), 1);
+  if (burn_values.size() != bands.size()) {
+    Nan::ThrowError("burnValues must have one value per band");
+    return;
+  }
+  if (!merge_alg.empty() && merge_alg != "REPLACE" && merge_alg != "ADD") {
+    Nan::ThrowError("mergeAlg must be \"REPLACE\" or \"ADD\"");
+    return;
+  }
+
+  // the burn values are given per layer and per band
+  std::vector<double> layer_burn_values;
+  for (size_t i = 0; i < layers.size(); i++)
+    layer_burn_values.insert(layer_burn_values.end(), burn_values.begin(), burn_values.end());
+
+  char **papszOptions = NULL;
+  if (!attribute.empty()) papszOptions = CSLSetNameValue(papszOptions, "ATTRIBUTE", attribute.c_str());
+  if (all_touched) papszOptions = CSLSetNameValue(papszOptions, "ALL_TOUCHED", "TRUE");
+  if (!merge_alg.empty()) papszOptions = CSLSetNameValue(papszOptions, "MERGE_ALG", merge_alg.c_str());
+  if (chunk_y_size > 0)
+    papszOptions = CSLSetNameValue(papszOptions, "CHUNKYSIZE", std::to_string(chunk_y_size).c_str());
+  std::shared_ptr<char *> rasterize_options(papszOptions, CSLDestroy);
+
+  GDALDatasetH hDst = reinterpret_cast<GDALDatasetH>(gdal_dst);
+  AsyncGDALWorker::Job doit = [hDst, bands, layers, layer_burn_values, rasterize_options, locks](
+                                GDALProgressFunc pfnProgress, void *pProgressArg) mutable {
+    AsyncGDALWorker::lock(locks);
+    CPLErr err = GDALRasterizeLayers(
+      hDst,
+      bands.size(),
+      bands.data(),
+      layers.size(),
+      layers.data(),
+      NULL,
+      NULL,
+      layer_burn_values.data(),
+      rasterize_options.get(),
+      pfnProgress,
+      pProgressArg);
+    AsyncGDALWorker::unlock(locks);
+    return err;
+  };
+
+  if (async) {
+    Nan::Callback *callback, *progress_cb = NULL;
+    NODE_ARG_CB(5, "callback", callback);
+    NODE_ARG_CB_OPT(4, "progress_cb", progress_cb);
+    AsyncGDALWorker *worker = new AsyncGDALWorker(callback, "node-gdal:Rasterize", info[3], progress_cb, doit);
+    for (Local<Object> &obj : persistent) worker->persist(obj);
+    Nan::AsyncQueueWorker(worker);
+    return;
+  }
+
+  CPLErr err = doit(NULL, NULL);
+  if (err) {
+    NODE_THROW_LAST_CPLERR();
+    return;
+  }
+
+  return;
+}
+
+/**
+ * Burns vector geometries into the bands of a raster dataset, using the
+ * chunked scanline rasterizer of GDAL.
+ *
+ * The geometries are reprojected to the spatial reference system of the
+ * raster when both are defined.
+ *
+ * @example
+ * ```
+ * gdal.rasterize(mask, parcels, {burnValues: [255], allTouched: true});
+ * gdal.rasterize(heights, buildings, {attribute: 'height'});```
+ *
+ * @throws Error
+ * @method rasterize
+ * @static
+ * @for gdal
+ * @param {gdal.Dataset} dst
+ * @param {gdal.Layer|gdal.Layer[]} layer
+ * @param {Object} [options]
+ * @param {Integer[]} [options.bands] The band numbers, one per burn value, the first band by default
+ * @param {Number[]} [options.burnValues=[1]] The value to burn in each band
+ * @param {String} [options.attribute] Burn the value of this attribute instead of `burnValues`
+ * @param {Boolean} [options.allTouched=false] Burn all the pixels touched by the geometries
+ * instead of only the pixels whose center is inside
+ * @param {String} [options.mergeAlg="REPLACE"] `"REPLACE"` or `"ADD"` the burnt values to the existing ones
+ * @param {Integer} [options.chunkYSize] The height in lines of the chunks processed at once
+ */
+NAN_METHOD(Algorithms::rasterize) {
+  _do_rasterize(info, false);
+}
+
+/**
+ * Asynchronously burns vector geometries into the bands of a raster dataset,
+ * using the chunked scanline rasterizer of GDAL.
+ *
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved on completion.
+ * The operation can be aborted with an
+ * [AbortSignal](https://developer.mozilla.org/en-US/docs/Web/API/AbortSignal), the Promise is then
+ * rejected with an `AbortError`.
+ *
+ * @throws Error
+ * @method rasterizeAsync
+ * @static
+ * @for gdal
+ * @param {gdal.Dataset} dst
+ * @param {gdal.Layer|gdal.Layer[]} layer
+ * @param {Object} [options]
+ * @param {Integer[]} [options.bands] The band numbers, one per burn value, the first band by default
+ * @param {Number[]} [options.burnValues=[1]] The value to burn in each band
+ * @param {String} [options.attribute] Burn the value of this attribute instead of `burnValues`
+ * @param {Boolean} [options.allTouched=false] Burn all the pixels touched by the geometries
+ * instead of only the pixels whose center is inside
+ * @param {String} [options.mergeAlg="REPLACE"] `"REPLACE"` or `"ADD"` the burnt values to the existing ones
+ * @param {Integer} [options.chunkYSize] The height in lines of the chunks processed at once
+ * @param {AbortSignal} [options.signal] Aborts the operation when signaled
+ * @param {ProgressCb} [options.progress_cb] Called with the completion ratio, between 0 and 1
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter, can be specified even if
+ * certain optional parameters are omitted
+ * @return {Promise<void>}
+ */
+NAN_METHOD(Algorithms::rasterizeAsync) {
+  _do_rasterize(info, true);
+}
+
+struct GridPoints {
+  std::vector<double> x, y, z;
+};
+
+/*
+ * Collects the points of a layer, the value is taken from the z_field
+ * attribute or from the Z coordinate of the geometry
+ */
+static void collectGridPoints(OGRLayer *layer, int z_field, GridPoints &points) {
+  layer->ResetReading();
+  OGRFeature *feature;
+  while ((feature = layer->GetNextFeature()) != NULL) {
+    OGRGeometry *geom = feature->GetGeometryRef();
+    double value = z_field >= 0 ? feature->GetFieldAsDouble(z_field) : 0;
+    std::vector<OGRPoint *> feature_points;
+    if (geom && wkbFlatten(geom->getGeometryType()) == wkbPoint) {
+      feature_points.push_back(static_cast<OGRPoint *>(geom));
+    } else if (geom && wkbFlatten(geom->getGeometryType()) == wkbMultiPoint) {
+      OGRMultiPoint *multi = static_cast<OGRMultiPoint *>(geom);
+      for (int i = 0; i < multi->getNumGeometries(); i++)
+        feature_points.push_back(static_cast<OGRPoint *>(multi->getGeometryRef(i)));
+    }
+    for (OGRPoint *pt : feature_points) {
+      if (pt->IsEmpty()) continue;
+      points.x.push_back(pt->getX());
+      points.y.push_back(pt->getY());
+      points.z.push_back(z_field >= 0 ? value : pt->getZ());
+    }
+    OGRFeature::DestroyFeature(feature);
+  }
+}
+
+struct GridAlgorithm {
+  GDALGridAlgorithm algorithm;
+  GDALGridInverseDistanceToAPowerOptions invdist;
+  GDALGridMovingAverageOptions average;
+  GDALGridNearestNeighborOptions nearest;
+#if GDAL_VERSION_MAJOR > 2 || (GDAL_VERSION_MAJOR == 2 && GDAL_VERSION_MINOR >= 1)
+  GDALGridLinearOptions linear;
+#endif
+
+  const void *options() const {
+    switch (algorithm) {
+      case GGA_MovingAverage: return &average;
+      case GGA_NearestNeighbor: return &nearest;
+#if GDAL_VERSION_MAJOR > 2 || (GDAL_VERSION_MAJOR == 2 && GDAL_VERSION_MINOR >= 1)
+      case GGA_Linear: return &linear;
+#endif
+      default: return &invdist;
+    }
+  }
+};
+
+/*
+ * The dataset created when grid has no destination, it is closed
+ * unless it has been handed to JS, e.g. when the job fails or is aborted
+ */
+struct GridResult {
+  GDALDatasetH ds = nullptr;
+  ~GridResult() {
+    if (ds) GDALClose(ds);
+  }
+};
+
+/**
+ * Low level grid for both synchronous and asynchronous execution.
+ */
+static void _do_grid(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async) {
+  Nan::HandleScope scope;
+
+  Local<Object> obj;
+  Layer *layer = NULL;
+  RasterBand *dst = NULL;
+  std::string algorithm = "invdist", z_field;
+  double power = 2, smoothing = 0, radius = -1, radius1 = 0, radius2 = 0, angle = 0, nodata = 0;
+  int max_points = 0, min_points = 0, threads = 0;
+  int x_size = 0, y_size = 0;
+  std::vector<double> bounds;
+  std::shared_ptr<GridPoints> points = std::make_shared<GridPoints>();
+
+  if (info.Length() < 1 || !(IS_WRAPPED(info[0], Layer) || info[0]->IsFloat64Array())) {
+    Nan::ThrowTypeError("source must be a Layer or a Float64Array");
+    return;
+  }
+  NODE_ARG_OBJECT(1, "options", obj);
+  NODE_STR_FROM_OBJ_OPT(obj, "algorithm", algorithm);
+  NODE_STR_FROM_OBJ_OPT(obj, "zField", z_field);
+  NODE_DOUBLE_FROM_OBJ_OPT(obj, "power", power);
+  NODE_DOUBLE_FROM_OBJ_OPT(obj, "smoothing", smoothing);
+  NODE_DOUBLE_FROM_OBJ_OPT(obj, "radius", radius);
+  NODE_DOUBLE_FROM_OBJ_OPT(obj, "radius1", radius1);
+  NODE_DOUBLE_FROM_OBJ_OPT(obj, "radius2", radius2);
+  NODE_DOUBLE_FROM_OBJ_OPT(obj, "angle", angle);
+  NODE_DOUBLE_FROM_OBJ_OPT(obj, "nodata", nodata);
+  NODE_INT_FROM_OBJ_OPT(obj, "maxPoints", max_points);
+  NODE_INT_FROM_OBJ_OPT(obj, "minPoints", min_points);
+  NODE_INT_FROM_OBJ_OPT(obj, "threads", threads);
+  if (Nan::HasOwnProperty(obj, Nan::New("size").ToLocalChecked()).FromMaybe(false)) {
+    Local<Value> size = Nan::Get(obj, Nan::New("size").ToLocalChecked()).ToLocalChecked();
+    if (!size->IsObject()) {
+      Nan::ThrowTypeError("Property \"size\" must be an object");
+      return;
+    }
+    NODE_INT_FROM_OBJ(size.As<Object>(), "x", x_size);
+    NODE_INT_FROM_OBJ(size.As<Object>(), "y", y_size);
+  }
+  if (Nan::HasOwnProperty(obj, Nan::New("bounds").ToLocalChecked()).FromMaybe(false)) {
+    DoubleList bounds_array;
+    if (bounds_array.parse(Nan::Get(obj, Nan::New("bounds").ToLocalChecked()).ToLocalChecked())) return;
+    if (bounds_array.length() != 4) {
+      Nan::ThrowError("bounds must be [xmin, ymin, xmax, ymax]");
+      return;
+    }
+    bounds.assign(bounds_array.get(), bounds_array.get() + 4);
+  }
+  if (info.Length() > 2 && !info[2]->IsUndefined() && !info[2]->IsNull()) {
+    NODE_ARG_WRAPPED(2, "dst", RasterBand, dst);
+  }
+  if (max_points < 0 || min_points < 0 || threads < 0) {
+    Nan::ThrowRangeError("maxPoints, minPoints and threads must not be negative");
+    return;
+  }
+
+  std::shared_ptr<GridAlgorithm> algo = std::make_shared<GridAlgorithm>();
+  memset(algo.get(), 0, sizeof(GridAlgorithm));
+  if (algorithm == "invdist") {
+    algo->algorithm = GGA_InverseDistanceToAPower;
+    algo->invdist.dfPower = power;
+    algo->invdist.dfSmoothing = smoothing;
+    algo->invdist.dfRadius1 = radius1;
+    algo->invdist.dfRadius2 = radius2;
+    algo->invdist.dfAngle = angle;
+    algo->invdist.nMaxPoints = max_points;
+    algo->invdist.nMinPoints = min_points;
+    algo->invdist.dfNoDataValue = nodata;
+  } else if (algorithm == "average") {
+    algo->algorithm = GGA_MovingAverage;
+    algo->average.dfRadius1 = radius1;
+    algo->average.dfRadius2 = radius2;
+    algo->average.dfAngle = angle;
+    algo->average.nMinPoints = min_points;
+    algo->average.dfNoDataValue = nodata;
+  } else if (algorithm == "nearest") {
+    algo->algorithm = GGA_NearestNeighbor;
+    algo->nearest.dfRadius1 = radius1;
+    algo->nearest.dfRadius2 = radius2;
+    algo->nearest.dfAngle = angle;
+    algo->nearest.dfNoDataValue = nodata;
+#if GDAL_VERSION_MAJOR > 2 || (GDAL_VERSION_MAJOR == 2 && GDAL_VERSION_MINOR >= 1)
+  } else if (algorithm == "linear") {
+    algo->algorithm = GGA_Linear;
+    algo->linear.dfRadius = radius;
+    algo->linear.dfNoDataValue = nodata;
+#endif
+  } else {
+    Nan::ThrowError("algorithm must be \"invdist\", \"average\", \"nearest\" or \"linear\"");
+    return;
+  }
+
+  std::vector<uv_mutex_t *> locks;
+  OGRLayer *ogr_layer = NULL;
+  int z_field_index = -1;
+  if (info[0]->IsFloat64Array()) {
+    // the points are copied, the array may change while the grid is computed asynchronously
+    Nan::TypedArrayContents<double> coords(info[0]);
+    if (coords.length() % 3) {
+      Nan::ThrowRangeError("The length of the coordinates must be a multiple of 3");
+      return;
+    }
+    for (size_t i = 0; i < coords.length(); i += 3) {
+      points->x.push_back((*coords)[i]);
+      points->y.push_back((*coords)[i + 1]);
+      points->z.push_back((*coords)[i + 2]);
+    }
+  } else {
+    layer = Nan::ObjectWrap::Unwrap<Layer>(info[0].As<Object>());
+    if (!layer->isAlive()) {
+      Nan::ThrowError("Layer object has already been destroyed");
+      return;
+    }
+    ogr_layer = layer->get();
+    locks.push_back(layer->async_lock);
+    if (!z_field.empty()) {
+      z_field_index = ogr_layer->GetLayerDefn()->GetFieldIndex(z_field.c_str());
+      if (z_field_index < 0) {
+        Nan::ThrowError(("Field \"" + z_field + "\" does not exist").c_str());
+        return;
+      }
+    }
+  }
+
+  GDALRasterBand *gdal_dst = NULL;
+  double gt[6];
+  if (dst) {
+    gdal_dst = dst->get();
+    x_size = gdal_dst->GetXSize();
+    y_size = gdal_dst->GetYSize();
+    locks.push_back(dst->async_lock);
+    if (bounds.empty()) {
+      GDALDataset *parent = gdal_dst->GetDataset();
+      if (!parent || parent->GetGeoTransform(gt) != CE_None || gt[2] != 0 || gt[4] != 0) {
+        Nan::ThrowError("bounds must be given when dst has no north-up geotransform");
+        return;
+      }
+    }
+  } else if (x_size < 1 || y_size < 1 || bounds.empty()) {
+    Nan::ThrowError("size and bounds must be given when dst is omitted");
+    return;
+  }
+  if (!bounds.empty()) {
+    // north-up, the first line is at ymax
+    gt[0] = bounds[0];
+    gt[1] = (bounds[2] - bounds[0]) / x_size;
+    gt[2] = 0;
+    gt[3] = bounds[3];
+    gt[4] = 0;
+    gt[5] = (bounds[1] - bounds[3]) / y_size;
+  }
+  double x_min = gt[0], x_max = gt[0] + gt[1] * x_size;
+  double y_min = gt[3], y_max = gt[3] + gt[5] * y_size;
+  std::vector<double> geotransform(gt, gt + 6);
+  std::shared_ptr<GridResult> result = std::make_shared<GridResult>();
+
+  AsyncGDALWorker::Job doit = [layer, ogr_layer, z_field_index, points, algo, gdal_dst, x_size, y_size, x_min, x_max,
+                               y_min, y_max, geotransform, nodata, threads, result, locks](
+                                GDALProgressFunc pfnProgress, void *pProgressArg) mutable {
+    if (ogr_layer) {
+      AsyncGDALWorker::lock(locks);
+      collectGridPoints(ogr_layer, z_field_index, *points);
+      layer->dropPendingFeature();
+      AsyncGDALWorker::unlock(locks);
+    }
+    if (points->x.empty()) {
+      CPLError(CE_Failure, CPLE_AppDefined, "No points to interpolate");
+      return CE_Failure;
+    }
+
+    // GDALGridCreate spreads the lines over GDAL_NUM_THREADS threads, ALL_CPUS by default
+    std::string previous_threads = CPLGetThreadLocalConfigOption("GDAL_NUM_THREADS", "");
+    if (threads > 0) CPLSetThreadLocalConfigOption("GDAL_NUM_THREADS", std::to_string(threads).c_str());
+    std::vector<double> data((size_t)x_size * y_size);
+    CPLErr err = GDALGridCreate(
+      algo->algorithm,
+      algo->options(),
+      points->x.size(),
+      points->x.data(),
+      points->y.data(),
+      points->z.data(),
+      x_min,
+      x_max,
+      y_min,
+      y_max,
+      x_size,
+      y_size,
+      GDT_Float64,
+      data.data(),
+      pfnProgress,
+      pProgressArg);
+    if (threads > 0)
+      CPLSetThreadLocalConfigOption("GDAL_NUM_THREADS", previous_threads.empty() ? NULL : previous_threads.c_str());
+    if (err != CE_None) return err;
+
+    GDALRasterBand *band = gdal_dst;
+    if (!band) {
+      GDALDriver *mem_driver = GetGDALDriverManager()->GetDriverByName("MEM");
+      if (!mem_driver) {
+        CPLError(CE_Failure, CPLE_AppDefined, "MEM driver is not available");
+        return CE_Failure;
+      }
+      GDALDataset *ds = mem_driver->Create("", x_size, y_size, 1, GDT_Float64, NULL);
+      if (!ds) return CE_Failure;
+      ds->SetGeoTransform(geotransform.data());
+      band = ds->GetRasterBand(1);
+      band->SetNoDataValue(nodata);
+      result->ds = (GDALDatasetH)ds;
+    }
+
+    if (gdal_dst) AsyncGDALWorker::lock(locks);
+    err = band->RasterIO(GF_Write, 0, 0, x_size, y_size, data.data(), x_size, y_size, GDT_Float64, 0, 0, NULL);
+    if (gdal_dst) AsyncGDALWorker::unlock(locks);
+    return err;
+  };
+
+  AsyncGDALWorker::Result rval = [result]() {
+    Nan::EscapableHandleScope scope;
+    if (!result->ds) return scope.Escape(Nan::Undefined().As<Value>());
+    Local<Value> ds = Dataset::New((GDALDataset *)result->ds);
+    result->ds = nullptr;
+    return scope.Escape(ds);
+  };
+
+  if (async) {
+    Nan::Callback *callback, *progress_cb = NULL;
+    NODE_ARG_CB(5, "callback", callback);
+    NODE_ARG_CB_OPT(4, "progress_cb", progress_cb);
+    AsyncGDALWorker *worker = new AsyncGDALWorker(callback, "node-gdal:Grid", info[3], progress_cb, doit, rval);
+    worker->persist(info[0]);
+    if (dst) worker->persist(dst->handle());
+    Nan::AsyncQueueWorker(worker);
+    return;
+  }
+
+  CPLErr err = doit(NULL, NULL);
+  if (err) {
+    NODE_THROW_LAST_CPLERR();
+    return;
+  }
+
+  info.GetReturnValue().Set(rval());
+}
+
+/**
+ * Interpolates scattered points on a regular grid, the library version of
+ * [gdal_grid](https://gdal.org/programs/gdal_grid.html).
+ *
+ * The points are either the point geometries of a layer or a packed
+ * `Float64Array` of `x, y, z` triplets. The lines of the grid are spread
+ * over `threads` threads, all the CPUs by default (`GDAL_NUM_THREADS`).
+ *
+ * @example
+ * ```
+ * var ds = gdal.grid(sensors, {
+ *   algorithm: 'invdist', power: 2, zField: 'temperature',
+ *   size: {x: 512, y: 512}, bounds: [xmin, ymin, xmax, ymax]
+ * });
+ * gdal.grid(new Float64Array([0, 0, 1, 10, 10, 5]), {algorithm: 'linear'}, band);```
+ *
+ * @throws Error
+ * @method grid
+ * @static
+ * @for gdal
+ * @param {gdal.Layer|Float64Array} source
+ * @param {Object} options
+ * @param {String} [options.algorithm="invdist"] `"invdist"`, `"average"`, `"nearest"` or `"linear"`
+ * @param {String} [options.zField] The attribute holding the values, the Z coordinate by default
+ * @param {Number} [options.power=2] The weighting power of `"invdist"`
+ * @param {Number} [options.smoothing=0] The smoothing parameter of `"invdist"`
+ * @param {Number} [options.radius1=0] The first radius of the search ellipse
+ * @param {Number} [options.radius2=0] The second radius of the search ellipse
+ * @param {Number} [options.angle=0] The rotation of the search ellipse in degrees
+ * @param {Number} [options.radius=-1] The search radius of `"linear"` outside of the triangulation
+ * @param {Integer} [options.maxPoints=0] The maximum number of points used by `"invdist"`
+ * @param {Integer} [options.minPoints=0] The minimum number of points
+ * @param {Number} [options.nodata=0] The value of the empty cells
+ * @param {Object} [options.size] The size (`{x, y}`) of the new dataset when `dst` is omitted
+ * @param {Number[]} [options.bounds] `[xmin, ymin, xmax, ymax]`, by default the extent of `dst`
+ * @param {Integer} [options.threads] The number of threads
+ * @param {gdal.RasterBand} [dst] The band receiving the grid, a new MEM dataset is created when omitted
+ * @return {gdal.Dataset|undefined} The new dataset when `dst` is omitted
+ */
+NAN_METHOD(Algorithms::grid) {
+  _do_grid(info, false);
+}
+
+/**
+ * Asynchronously interpolates scattered points on a regular grid, the library version of
+ * [gdal_grid](https://gdal.org/programs/gdal_grid.html).
+ *
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ * The operation can be aborted with an
+ * [AbortSignal](https://developer.mozilla.org/en-US/docs/Web/API/AbortSignal), the Promise is then
+ * rejected with an `AbortError`.
+ *
+ * @throws Error
+ * @method gridAsync
+ * @static
+ * @for gdal
+ * @param {gdal.Layer|Float64Array} source
+ * @param {Object} options
+ * @param {String} [options.algorithm="invdist"] `"invdist"`, `"average"`, `"nearest"` or `"linear"`
+ * @param {String} [options.zField] The attribute holding the values, the Z coordinate by default
+ * @param {Number} [options.power=2] The weighting power of `"invdist"`
+ * @param {Number} [options.smoothing=0] The smoothing parameter of `"invdist"`
+ * @param {Number} [options.radius1=0] The first radius of the search ellipse
+ * @param {Number} [options.radius2=0] The second radius of the search ellipse
+ * @param {Number} [options.angle=0] The rotation of the search ellipse in degrees
+ * @param {Number} [options.radius=-1] The search radius of `"linear"` outside of the triangulation
+ * @param {Integer} [options.maxPoints=0] The maximum number of points used by `"invdist"`
+ * @param {Integer} [options.minPoints=0] The minimum number of points
+ * @param {Number} [options.nodata=0] The value of the empty cells
+ * @param {Object} [options.size] The size (`{x, y}`) of the new dataset when `dst` is omitted
+ * @param {Number[]} [options.bounds] `[xmin, ymin, xmax, ymax]`, by default the extent of `dst`
+ * @param {Integer} [options.threads] The number of threads
+ * @param {AbortSignal} [options.signal] Aborts the operation when signaled
+ * @param {ProgressCb} [options.progress_cb] Called with the completion ratio, between 0 and 1
+ * @param {gdal.RasterBand} [dst] The band receiving the grid, a new MEM dataset is created when omitted
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter, can be specified even if
+ * certain optional parameters are omitted
+ * @return {Promise<gdal.Dataset|undefined>}
+ */
+NAN_METHOD(Algorithms::gridAsync) {
+  _do_grid(info, true);
+}
+
 } // namespace node_gdal
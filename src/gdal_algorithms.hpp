@@ -27,10 +27,22 @@ namespace Algorithms {
 void Initialize(Local<Object> target);
 
 NAN_METHOD(fillNodata);
+NAN_METHOD(fillNodataAsync);
 NAN_METHOD(contourGenerate);
+NAN_METHOD(contourGenerateAsync);
 NAN_METHOD(sieveFilter);
+NAN_METHOD(sieveFilterAsync);
 NAN_METHOD(checksumImage);
 NAN_METHOD(polygonize);
+NAN_METHOD(polygonizeAsync);
+NAN_METHOD(zonalStats);
+NAN_METHOD(zonalStatsAsync);
+NAN_METHOD(calc);
+NAN_METHOD(calcAsync);
+NAN_METHOD(rasterize);
+NAN_METHOD(rasterizeAsync);
+NAN_METHOD(grid);
+NAN_METHOD(gridAsync);
 } // namespace Algorithms
 } // namespace node_gdal
 
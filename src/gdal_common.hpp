@@ -196,6 +196,19 @@ NAN_SETTER(READ_ONLY_SETTER);
     }                                                                                                                  \
   }
 
+#define NODE_BOOL_FROM_OBJ_OPT(obj, key, var)                                                                          \
+  {                                                                                                                    \
+    Local<String> sym = Nan::New(key).ToLocalChecked();                                                                \
+    if (Nan::HasOwnProperty(obj, sym).FromMaybe(false)) {                                                              \
+      Local<Value> val = Nan::Get(obj, sym).ToLocalChecked();                                                          \
+      if (!val->IsBoolean()) {                                                                                         \
+        Nan::ThrowTypeError("Property \"" key "\" must be a boolean");                                                 \
+        return;                                                                                                        \
+      }                                                                                                                \
+      var = Nan::To<bool>(val).ToChecked();                                                                            \
+    }                                                                                                                  \
+  }
+
 // ----- argument conversion -------
 
 // determine field index based on string/numeric js argument
@@ -322,6 +335,16 @@ NAN_SETTER(READ_ONLY_SETTER);
 
 // ----- optional argument conversion -------
 
+#define NODE_ARG_CB_OPT(num, name, var)                                                                                \
+  if (info.Length() > num) {                                                                                           \
+    if (info[num]->IsFunction()) {                                                                                     \
+      var = new Nan::Callback(info[num].As<Function>());                                                               \
+    } else if (!info[num]->IsUndefined() && !info[num]->IsNull()) {                                                    \
+      Nan::ThrowTypeError(name " must be a function");                                                                 \
+      return;                                                                                                          \
+    }                                                                                                                  \
+  }
+
 #define NODE_ARG_INT_OPT(num, name, var)                                                                               \
   if (info.Length() > num) {                                                                                           \
     if (info[num]->IsInt32()) {                                                                                        \
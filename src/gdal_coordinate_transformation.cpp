@@ -3,6 +3,11 @@
 #include "gdal_common.hpp"
 #include "gdal_dataset.hpp"
 #include "gdal_spatial_reference.hpp"
+#include "utils/typed_array.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
 
 namespace node_gdal {
 
@@ -17,6 +22,8 @@ void CoordinateTransformation::Initialize(Local<Object> target) {
 
   Nan::SetPrototypeMethod(lcons, "toString", toString);
   Nan::SetPrototypeMethod(lcons, "transformPoint", transformPoint);
+  Nan::SetPrototypeMethod(lcons, "transformArrays", transformArrays);
+  Nan::SetPrototypeMethod(lcons, "transformInterleaved", transformInterleaved);
 
   Nan::Set(target, Nan::New("CoordinateTransformation").ToLocalChecked(), Nan::GetFunction(lcons).ToLocalChecked());
 
@@ -209,4 +216,239 @@ NAN_METHOD(CoordinateTransformation::transformPoint) {
   info.GetReturnValue().Set(result);
 }
 
+/*
+ * Coordinates of n points, either in separate arrays (stride = 1)
+ * or interleaved in a single array (stride = 2 or 3)
+ */
+struct CoordinateArrays {
+  double *x;
+  double *y;
+  double *z;
+  size_t stride;
+  size_t n;
+};
+
+// points per call to OGRCoordinateTransformation::Transform
+static const size_t TRANSFORM_CHUNK_SIZE = 65536;
+
+static void transformRange(
+  OGRCoordinateTransformation *ct, const CoordinateArrays &coords, size_t begin, size_t end, GByte *mask) {
+  std::vector<int> success(std::min(TRANSFORM_CHUNK_SIZE, end - begin));
+  std::vector<double> x, y, z;
+  if (coords.stride > 1) {
+    x.resize(success.size());
+    y.resize(success.size());
+    if (coords.z) z.resize(success.size());
+  }
+
+  for (size_t chunk = begin; chunk < end; chunk += TRANSFORM_CHUNK_SIZE) {
+    size_t n = std::min(TRANSFORM_CHUNK_SIZE, end - chunk);
+    double *px, *py, *pz;
+    if (coords.stride == 1) {
+      // in place
+      px = coords.x + chunk;
+      py = coords.y + chunk;
+      pz = coords.z ? coords.z + chunk : NULL;
+    } else {
+      for (size_t i = 0; i < n; i++) {
+        x[i] = coords.x[(chunk + i) * coords.stride];
+        y[i] = coords.y[(chunk + i) * coords.stride];
+        if (coords.z) z[i] = coords.z[(chunk + i) * coords.stride];
+      }
+      px = x.data();
+      py = y.data();
+      pz = coords.z ? z.data() : NULL;
+    }
+
+    std::fill(success.begin(), success.begin() + n, FALSE);
+#if GDAL_VERSION_MAJOR >= 3
+    ct->Transform(n, px, py, pz, success.data());
+#else
+    ct->TransformEx(n, px, py, pz, success.data());
+#endif
+
+    for (size_t i = 0; i < n; i++) mask[chunk + i] = success[i] ? 1 : 0;
+    if (coords.stride > 1) {
+      for (size_t i = 0; i < n; i++) {
+        coords.x[(chunk + i) * coords.stride] = x[i];
+        coords.y[(chunk + i) * coords.stride] = y[i];
+        if (coords.z) coords.z[(chunk + i) * coords.stride] = z[i];
+      }
+    }
+  }
+}
+
+/*
+ * Every thread uses its own clone of the transformation,
+ * the geotransform transformers can't be cloned safely and always use one thread
+ */
+static void transformCoordinates(
+  OGRCoordinateTransformation *ct, const CoordinateArrays &coords, int threads, GByte *mask) {
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 1)
+  if (dynamic_cast<GeoTransformTransformer *>(ct) != nullptr) threads = 1;
+  size_t max_threads = (coords.n + TRANSFORM_CHUNK_SIZE - 1) / TRANSFORM_CHUNK_SIZE;
+  if ((size_t)threads > max_threads) threads = std::max<size_t>(max_threads, 1);
+#else
+  threads = 1;
+#endif
+  if (threads <= 1) {
+    transformRange(ct, coords, 0, coords.n, mask);
+    return;
+  }
+
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 1)
+  std::vector<OGRCoordinateTransformation *> clones;
+  std::vector<std::thread> workers;
+  size_t range = (coords.n + threads - 1) / threads;
+  for (int t = 1; t < threads; t++) {
+    OGRCoordinateTransformation *clone = ct->Clone();
+    if (clone == nullptr) break;
+    clones.push_back(clone);
+    size_t begin = range * t;
+    size_t end = std::min(coords.n, begin + range);
+    workers.push_back(std::thread(transformRange, clone, std::cref(coords), begin, end, mask));
+  }
+  // the calling thread handles the first range, and the ranges without a clone
+  size_t handled = range * (clones.size() + 1);
+  transformRange(ct, coords, 0, std::min(coords.n, range), mask);
+  if (handled < coords.n) transformRange(ct, coords, handled, coords.n, mask);
+  for (std::thread &worker : workers) worker.join();
+  for (OGRCoordinateTransformation *clone : clones) OGRCoordinateTransformation::DestroyCT(clone);
+#endif
+}
+
+static bool parseThreads(const Nan::FunctionCallbackInfo<v8::Value> &info, int arg, int &threads) {
+  threads = 1;
+  if (info.Length() > arg && !info[arg]->IsUndefined() && !info[arg]->IsNull()) {
+    if (!info[arg]->IsObject()) {
+      Nan::ThrowTypeError("options must be an object");
+      return false;
+    }
+    Local<Object> options = info[arg].As<Object>();
+    Local<String> sym = Nan::New("threads").ToLocalChecked();
+    if (Nan::HasOwnProperty(options, sym).FromMaybe(false)) {
+      Local<Value> val = Nan::Get(options, sym).ToLocalChecked();
+      if (!val->IsInt32() || Nan::To<int32_t>(val).ToChecked() < 1) {
+        Nan::ThrowTypeError("threads property must be a positive integer");
+        return false;
+      }
+      threads = Nan::To<int32_t>(val).ToChecked();
+    }
+  }
+  return true;
+}
+
+static double *parseFloat64Array(Local<Value> value, const char *name, size_t &length) {
+  if (!value->IsFloat64Array()) {
+    Nan::ThrowTypeError((std::string(name) + " must be a Float64Array").c_str());
+    return NULL;
+  }
+  Nan::TypedArrayContents<double> contents(value);
+  length = contents.length();
+  return *contents;
+}
+
+/**
+ * Transforms the points given by several coordinate arrays from source to
+ * destination space, in place.
+ *
+ * The points are transformed in large chunks, optionally in several threads,
+ * each using its own copy of the transformation (requires GDAL >= 3.1).
+ *
+ * @example
+ * ```
+ * var xs = new Float64Array([2.35, -0.12]);
+ * var ys = new Float64Array([48.85, 51.5]);
+ * var ok = transform.transformArrays(xs, ys, undefined, {threads: 4});```
+ *
+ * @throws Error
+ * @method transformArrays
+ * @param {Float64Array} xs
+ * @param {Float64Array} ys
+ * @param {Float64Array} [zs]
+ * @param {Object} [options]
+ * @param {Integer} [options.threads=1]
+ * @return {Uint8Array} The success mask, 1 for each point that has been transformed, 0 otherwise
+ */
+NAN_METHOD(CoordinateTransformation::transformArrays) {
+  Nan::HandleScope scope;
+
+  CoordinateTransformation *transform = Nan::ObjectWrap::Unwrap<CoordinateTransformation>(info.This());
+
+  CoordinateArrays coords;
+  size_t y_length, z_length = 0;
+  coords.z = NULL;
+  coords.stride = 1;
+  if (!(coords.x = parseFloat64Array(info[0], "xs", coords.n))) return;
+  if (!(coords.y = parseFloat64Array(info[1], "ys", y_length))) return;
+  if (info.Length() > 2 && !info[2]->IsUndefined() && !info[2]->IsNull()) {
+    if (!(coords.z = parseFloat64Array(info[2], "zs", z_length))) return;
+  }
+  if (y_length != coords.n || (coords.z && z_length != coords.n)) {
+    Nan::ThrowRangeError("xs, ys and zs must have the same length");
+    return;
+  }
+  int threads;
+  if (!parseThreads(info, 3, threads)) return;
+
+  Local<Value> mask = TypedArray::New(GDT_Byte, coords.n);
+  if (mask.IsEmpty() || !mask->IsObject()) return;
+  GByte *mask_data = (GByte *)TypedArray::Validate(mask.As<Object>(), GDT_Byte, coords.n);
+  if (!mask_data) return;
+
+  transformCoordinates(transform->this_, coords, threads, mask_data);
+
+  info.GetReturnValue().Set(mask);
+}
+
+/**
+ * Transforms the points given as interleaved coordinates (`x0, y0, x1, y1, ...` or
+ * `x0, y0, z0, x1, y1, z1, ...`) from source to destination space, in place.
+ *
+ * @throws Error
+ * @method transformInterleaved
+ * @param {Float64Array} coordinates
+ * @param {Integer} [dimensions=2] `2` or `3`
+ * @param {Object} [options]
+ * @param {Integer} [options.threads=1]
+ * @return {Uint8Array} The success mask, 1 for each point that has been transformed, 0 otherwise
+ */
+NAN_METHOD(CoordinateTransformation::transformInterleaved) {
+  Nan::HandleScope scope;
+
+  CoordinateTransformation *transform = Nan::ObjectWrap::Unwrap<CoordinateTransformation>(info.This());
+
+  size_t length;
+  double *data = parseFloat64Array(info[0], "coordinates", length);
+  if (!data) return;
+  int dimensions = 2;
+  NODE_ARG_INT_OPT(1, "dimensions", dimensions);
+  if (dimensions != 2 && dimensions != 3) {
+    Nan::ThrowRangeError("dimensions must be 2 or 3");
+    return;
+  }
+  if (length % dimensions) {
+    Nan::ThrowRangeError("The length of coordinates must be a multiple of dimensions");
+    return;
+  }
+  int threads;
+  if (!parseThreads(info, 2, threads)) return;
+
+  CoordinateArrays coords;
+  coords.x = data;
+  coords.y = data + 1;
+  coords.z = dimensions == 3 ? data + 2 : NULL;
+  coords.stride = dimensions;
+  coords.n = length / dimensions;
+
+  Local<Value> mask = TypedArray::New(GDT_Byte, coords.n);
+  if (mask.IsEmpty() || !mask->IsObject()) return;
+  GByte *mask_data = (GByte *)TypedArray::Validate(mask.As<Object>(), GDT_Byte, coords.n);
+  if (!mask_data) return;
+
+  transformCoordinates(transform->this_, coords, threads, mask_data);
+
+  info.GetReturnValue().Set(mask);
+}
+
 } // namespace node_gdal
@@ -27,6 +27,8 @@ class CoordinateTransformation : public Nan::ObjectWrap {
   static Local<Value> New(OGRCoordinateTransformation *transform);
   static NAN_METHOD(toString);
   static NAN_METHOD(transformPoint);
+  static NAN_METHOD(transformArrays);
+  static NAN_METHOD(transformInterleaved);
 
   CoordinateTransformation();
   CoordinateTransformation(OGRCoordinateTransformation *srs);
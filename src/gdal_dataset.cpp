@@ -8,6 +8,10 @@
 #include "gdal_majorobject.hpp"
 #include "gdal_rasterband.hpp"
 #include "gdal_spatial_reference.hpp"
+#include "async/async_worker.hpp"
+#include "utils/typed_array.hpp"
+
+#include <memory>
 
 namespace node_gdal {
 
@@ -35,6 +39,9 @@ void Dataset::Initialize(Local<Object> target) {
   Nan::SetPrototypeMethod(lcons, "testCapability", testCapability);
   Nan::SetPrototypeMethod(lcons, "executeSQL", executeSQL);
   Nan::SetPrototypeMethod(lcons, "buildOverviews", buildOverviews);
+  Nan::SetPrototypeMethod(lcons, "buildOverviewsAsync", buildOverviewsAsync);
+  Nan::SetPrototypeMethod(lcons, "rasterIO", rasterIO);
+  Nan::SetPrototypeMethod(lcons, "rasterIOAsync", rasterIOAsync);
 
   ATTR_DONT_ENUM(lcons, "_uid", uidGetter, READ_ONLY_SETTER);
   ATTR(lcons, "description", descriptionGetter, READ_ONLY_SETTER);
@@ -155,7 +162,9 @@ Local<Value> Dataset::New(GDALDataset *raw) {
   wrapped->async_lock = new uv_mutex_t;
   uv_mutex_init(wrapped->async_lock);
 
-  wrapped->uid = ptr_manager.add(raw, wrapped->async_lock);
+  wrapped->reader_pool = std::shared_ptr<ReaderPool>(ReaderPool::create(raw));
+
+  wrapped->uid = ptr_manager.add(raw, wrapped->async_lock, wrapped->reader_pool);
 
   return scope.Escape(obj);
 }
@@ -593,17 +602,9 @@ NAN_METHOD(Dataset::setGCPs) {
 }
 
 /**
- * Builds dataset overviews.
- *
- * @throws Error
- * @method buildOverviews
- * @param {String} resampling `"NEAREST"`, `"GAUSS"`, `"CUBIC"`, `"AVERAGE"`,
- * `"MODE"`, `"AVERAGE_MAGPHASE"` or `"NONE"`
- * @param {Integer[]} overviews
- * @param {Integer[]} [bands] Note: Generation of overviews in external TIFF
- * currently only supported when operating on all bands.
+ * Low level overview building for both synchronous and asynchronous execution.
  */
-NAN_METHOD(Dataset::buildOverviews) {
+static void _do_build_overviews(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async) {
   Nan::HandleScope scope;
   Dataset *ds = Nan::ObjectWrap::Unwrap<Dataset>(info.This());
 
@@ -628,58 +629,409 @@ NAN_METHOD(Dataset::buildOverviews) {
   NODE_ARG_ARRAY(1, "overviews", overviews);
   NODE_ARG_ARRAY_OPT(2, "bands", bands);
 
-  int *o, *b = NULL;
-  int n_overviews = overviews->Length();
-  int i, n_bands = 0;
+  std::vector<int> o, b;
+  unsigned int i;
 
-  o = new int[n_overviews];
-  for (i = 0; i < n_overviews; i++) {
+  for (i = 0; i < overviews->Length(); i++) {
     Local<Value> val = Nan::Get(overviews, i).ToLocalChecked();
     if (!val->IsNumber()) {
-      delete[] o;
       Nan::ThrowError("overviews array must only contain numbers");
       return;
     }
-    o[i] = Nan::To<int32_t>(val).ToChecked();
+    o.push_back(Nan::To<int32_t>(val).ToChecked());
   }
 
-  uv_mutex_lock(ds->async_lock);
   if (!bands.IsEmpty()) {
-    n_bands = bands->Length();
-    b = new int[n_bands];
-    for (i = 0; i < n_bands; i++) {
+    int n_bands = raw->GetRasterCount();
+    for (i = 0; i < bands->Length(); i++) {
       Local<Value> val = Nan::Get(bands, i).ToLocalChecked();
       if (!val->IsNumber()) {
-        delete[] o;
-        delete[] b;
-        uv_mutex_unlock(ds->async_lock);
         Nan::ThrowError("band array must only contain numbers");
         return;
       }
-      b[i] = Nan::To<int32_t>(val).ToChecked();
-      if (b[i] > raw->GetRasterCount() || b[i] < 1) {
+      b.push_back(Nan::To<int32_t>(val).ToChecked());
+      if (b[i] > n_bands || b[i] < 1) {
         // BuildOverviews prints an error but segfaults before returning
-        delete[] o;
-        delete[] b;
-        uv_mutex_unlock(ds->async_lock);
         Nan::ThrowError("invalid band id");
         return;
       }
     }
   }
 
-  CPLErr err = raw->BuildOverviews(resampling.c_str(), n_overviews, o, n_bands, b, NULL, NULL);
+  uv_mutex_t *async_lock = ds->async_lock;
+  AsyncGDALWorker::Job doit = [raw, async_lock, resampling, o, b](GDALProgressFunc pfnProgress, void *pProgressArg) {
+    std::vector<int> overview_list = o, band_list = b;
+    uv_mutex_lock(async_lock);
+    CPLErr err = raw->BuildOverviews(
+      resampling.c_str(),
+      overview_list.size(),
+      overview_list.data(),
+      band_list.size(),
+      band_list.empty() ? NULL : band_list.data(),
+      pfnProgress,
+      pProgressArg);
+    uv_mutex_unlock(async_lock);
+    return err;
+  };
+
+  if (async) {
+    Nan::Callback *callback, *progress_cb = NULL;
+    NODE_ARG_CB(5, "callback", callback);
+    NODE_ARG_CB_OPT(4, "progress_cb", progress_cb);
+    AsyncGDALWorker *worker = new AsyncGDALWorker(callback, "node-gdal:BuildOverviews", info[3], progress_cb, doit);
+    worker->persist(info.This());
+    Nan::AsyncQueueWorker(worker);
+    return;
+  }
+
+  CPLErr err = doit(NULL, NULL);
+  if (err) {
+    NODE_THROW_CPLERR(err);
+    return;
+  }
+
+  return;
+}
+
+/**
+ * Builds dataset overviews.
+ *
+ * @throws Error
+ * @method buildOverviews
+ * @param {String} resampling `"NEAREST"`, `"GAUSS"`, `"CUBIC"`, `"AVERAGE"`,
+ * `"MODE"`, `"AVERAGE_MAGPHASE"` or `"NONE"`
+ * @param {Integer[]} overviews
+ * @param {Integer[]} [bands] Note: Generation of overviews in external TIFF
+ * currently only supported when operating on all bands.
+ */
+NAN_METHOD(Dataset::buildOverviews) {
+  _do_build_overviews(info, false);
+}
+
+/**
+ * Asynchronously builds dataset overviews.
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved on completion.
+ * The operation can be aborted with an
+ * [AbortSignal](https://developer.mozilla.org/en-US/docs/Web/API/AbortSignal), the Promise is then
+ * rejected with an `AbortError`.
+ *
+ * @throws Error
+ * @method buildOverviewsAsync
+ * @param {String} resampling `"NEAREST"`, `"GAUSS"`, `"CUBIC"`, `"AVERAGE"`,
+ * `"MODE"`, `"AVERAGE_MAGPHASE"` or `"NONE"`
+ * @param {Integer[]} overviews
+ * @param {Integer[]} [bands] Note: Generation of overviews in external TIFF
+ * currently only supported when operating on all bands.
+ * @param {Object} [options]
+ * @param {AbortSignal} [options.signal] Aborts the operation when signaled
+ * @param {ProgressCb} [options.progress_cb] Called with the completion ratio, between 0 and 1
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter, can be specified even if
+ * certain optional parameters are omitted
+ * @return {Promise<void>}
+ */
+NAN_METHOD(Dataset::buildOverviewsAsync) {
+  _do_build_overviews(info, true);
+}
+
+static void _do_raster_io(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async) {
+  Nan::HandleScope scope;
+  Dataset *ds = Nan::ObjectWrap::Unwrap<Dataset>(info.This());
+
+  if (!ds->isAlive()) {
+    Nan::ThrowError("Dataset object has already been destroyed");
+    return;
+  }
+
+#if GDAL_VERSION_MAJOR < 2
+  if (ds->uses_ogr) {
+    Nan::ThrowError("Dataset does not support raster IO");
+    return;
+  }
+#endif
+
+  GDALDataset *raw = ds->getDataset();
+  int x, y, w, h;
+  Local<Object> options;
+  Local<Object> obj;
+
+  NODE_ARG_INT(0, "x_offset", x);
+  NODE_ARG_INT(1, "y_offset", y);
+  NODE_ARG_INT(2, "x_size", w);
+  NODE_ARG_INT(3, "y_size", h);
+  if (info.Length() > 5 && !info[5]->IsUndefined() && !info[5]->IsNull()) {
+    NODE_ARG_OBJECT(5, "options", options);
+  } else {
+    options = Nan::New<Object>();
+  }
+
+  uv_mutex_lock(ds->async_lock);
+  int n_raster_bands = raw->GetRasterCount();
+  GDALDataType type = n_raster_bands > 0 ? raw->GetRasterBand(1)->GetRasterDataType() : GDT_Unknown;
   uv_mutex_unlock(ds->async_lock);
 
-  delete[] o;
-  if (b) delete[] b;
+  std::vector<int> band_map;
+  Local<String> bands_key = Nan::New("bands").ToLocalChecked();
+  if (Nan::HasOwnProperty(options, bands_key).FromMaybe(false)) {
+    Local<Value> bands_val = Nan::Get(options, bands_key).ToLocalChecked();
+    if (!bands_val->IsArray()) {
+      Nan::ThrowTypeError("Property \"bands\" must be an array");
+      return;
+    }
+    Local<Array> bands = bands_val.As<Array>();
+    for (unsigned int i = 0; i < bands->Length(); i++) {
+      Local<Value> val = Nan::Get(bands, i).ToLocalChecked();
+      if (!val->IsNumber()) {
+        Nan::ThrowError("band array must only contain numbers");
+        return;
+      }
+      int band_id = Nan::To<int32_t>(val).ToChecked();
+      if (band_id > n_raster_bands || band_id < 1) {
+        Nan::ThrowRangeError("invalid band id");
+        return;
+      }
+      band_map.push_back(band_id);
+    }
+  } else {
+    for (int i = 1; i <= n_raster_bands; i++) band_map.push_back(i);
+  }
+  if (band_map.empty()) {
+    Nan::ThrowError("No raster bands to read");
+    return;
+  }
+  int n_bands = band_map.size();
+
+  int buffer_w = w, buffer_h = h;
+  std::string type_name = "";
+  NODE_INT_FROM_OBJ_OPT(options, "buffer_width", buffer_w);
+  NODE_INT_FROM_OBJ_OPT(options, "buffer_height", buffer_h);
+  NODE_STR_FROM_OBJ_OPT(options, "data_type", type_name);
+  if (!type_name.empty()) { type = GDALGetDataTypeByName(type_name.c_str()); }
+
+  // an ArrayBuffer or a SharedArrayBuffer is read into in place
+  bool raw_buffer = info[4]->IsArrayBuffer() || info[4]->IsSharedArrayBuffer();
+  if (!raw_buffer && !info[4]->IsUndefined() && !info[4]->IsNull()) {
+    NODE_ARG_OBJECT(4, "data", obj);
+    type = TypedArray::Identify(obj);
+    if (type == GDT_Unknown) {
+      Nan::ThrowError("Invalid array");
+      return;
+    }
+  }
+
+  // pixel-interleaved by default
+  int bytes_per_pixel = GDALGetDataTypeSize(type) / 8;
+  int pixel_space = bytes_per_pixel * n_bands;
+  NODE_INT_FROM_OBJ_OPT(options, "pixel_space", pixel_space);
+  int line_space = pixel_space * buffer_w;
+  NODE_INT_FROM_OBJ_OPT(options, "line_space", line_space);
+  int band_space = bytes_per_pixel;
+  NODE_INT_FROM_OBJ_OPT(options, "band_space", band_space);
+
+  if (bytes_per_pixel <= 0) {
+    Nan::ThrowError("Unsupported data_type");
+    return;
+  }
+  if (buffer_w <= 0 || buffer_h <= 0) {
+    Nan::ThrowRangeError("buffer_width and buffer_height must be greater than 0");
+    return;
+  }
+  if (pixel_space < bytes_per_pixel || line_space < bytes_per_pixel || band_space < bytes_per_pixel) {
+    Nan::ThrowError("pixel_space, line_space and band_space must be greater than or equal to size of data_type");
+    return;
+  }
+
+  // offset of the last byte written + 1
+  GIntBig min_size = (GIntBig)(buffer_h - 1) * line_space + (GIntBig)(buffer_w - 1) * pixel_space +
+    (GIntBig)(n_bands - 1) * band_space + bytes_per_pixel;
+  GIntBig min_length = (min_size + bytes_per_pixel - 1) / bytes_per_pixel;
+  if (min_length > INT_MAX) {
+    Nan::ThrowRangeError("The requested buffer is too large");
+    return;
+  }
 
+  if (raw_buffer) {
+    int offset = 0;
+    NODE_INT_FROM_OBJ_OPT(options, "offset", offset);
+    if (offset < 0) {
+      Nan::ThrowRangeError("offset must be greater than or equal to 0");
+      return;
+    }
+    Local<Value> array = TypedArray::New(type, info[4], offset, min_length);
+    if (array.IsEmpty() || !array->IsObject()) {
+      return; // TypedArray::New threw an error
+    }
+    obj = array.As<Object>();
+  } else if (obj.IsEmpty()) {
+    Local<Value> array = TypedArray::New(type, min_length);
+    if (array.IsEmpty() || !array->IsObject()) {
+      return; // TypedArray::New threw an error
+    }
+    obj = array.As<Object>();
+  }
+
+  void *data = TypedArray::Validate(obj, type, min_length);
+  if (!data) {
+    return; // TypedArray::Validate threw an error
+  }
+
+  uv_mutex_t *async_lock = ds->async_lock;
+  std::shared_ptr<ReaderPool> reader_pool = ds->reader_pool;
+  AsyncGDALWorker::Job doit = [raw,
+                               async_lock,
+                               reader_pool,
+                               x,
+                               y,
+                               w,
+                               h,
+                               data,
+                               buffer_w,
+                               buffer_h,
+                               type,
+                               band_map,
+                               pixel_space,
+                               line_space,
+                               band_space](GDALProgressFunc pfnProgress, void *pProgressArg) {
+    std::vector<int> bands = band_map;
+    // a read-only dataset is read through a pooled handle when one is available
+    GDALDataset *reader = reader_pool ? reader_pool->acquire() : NULL;
+    GDALDataset *src = reader ? reader : raw;
+    if (!reader) uv_mutex_lock(async_lock);
+#if GDAL_VERSION_MAJOR >= 2
+    GDALRasterIOExtraArg sExtraArg;
+    INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+    sExtraArg.pfnProgress = pfnProgress;
+    sExtraArg.pProgressData = pProgressArg;
+    CPLErr err = src->RasterIO(
+      GF_Read,
+      x,
+      y,
+      w,
+      h,
+      data,
+      buffer_w,
+      buffer_h,
+      type,
+      bands.size(),
+      bands.data(),
+      pixel_space,
+      line_space,
+      band_space,
+      &sExtraArg);
+#else
+    CPLErr err = src->RasterIO(
+      GF_Read, x, y, w, h, data, buffer_w, buffer_h, type, bands.size(), bands.data(), pixel_space, line_space,
+      band_space);
+#endif
+    if (reader)
+      reader_pool->release(reader);
+    else
+      uv_mutex_unlock(async_lock);
+    return err;
+  };
+
+  if (async) {
+    Nan::Callback *callback, *progress_cb = NULL;
+    NODE_ARG_CB(8, "callback", callback);
+    NODE_ARG_CB_OPT(7, "progress_cb", progress_cb);
+    // released in the main thread when the worker is destroyed
+    std::shared_ptr<Nan::Persistent<Object>> result(
+      new Nan::Persistent<Object>(obj), [](Nan::Persistent<Object> *p) {
+        p->Reset();
+        delete p;
+      });
+    AsyncGDALWorker::Result rval = [result]() { return Nan::New(*result).As<Value>(); };
+    AsyncGDALWorker *worker = new AsyncGDALWorker(callback, "node-gdal:RasterIO", info[6], progress_cb, doit, rval);
+    worker->persist(info.This());
+    Nan::AsyncQueueWorker(worker);
+    return;
+  }
+
+  CPLErr err = doit(NULL, NULL);
   if (err) {
     NODE_THROW_CPLERR(err);
     return;
   }
 
-  return;
+  info.GetReturnValue().Set(obj);
+}
+
+/**
+ * Reads a region of pixels of several bands in one call.
+ *
+ * The data is pixel-interleaved by default (`RGBRGB...` for a 3-band dataset),
+ * `options.pixel_space`, `options.line_space` and `options.band_space` (in bytes)
+ * allow any other layout such as band-sequential.
+ *
+ * @example
+ * ```
+ * // a 256x256 RGBA tile in a single buffer
+ * var tile = dataset.rasterIO(0, 0, 256, 256, null, {bands: [1, 2, 3, 4]});```
+ *
+ * @throws Error
+ * @method rasterIO
+ * @param {Integer} x
+ * @param {Integer} y
+ * @param {Integer} width
+ * @param {Integer} height
+ * @param {TypedArray|ArrayBuffer|SharedArrayBuffer} [data] The
+ * [TypedArray](https://developer.mozilla.org/en-US/docs/Web/API/ArrayBufferView#Typed_array_subclasses)
+ * to put the data in. A new array is created if not given. When an `ArrayBuffer` or a `SharedArrayBuffer` is given,
+ * the data is read in place into a view of the data type starting at `options.offset`.
+ * @param {Object} [options]
+ * @param {Integer[]} [options.bands] The band numbers to read, all the bands when not given
+ * @param {Integer} [options.buffer_width=x_size]
+ * @param {Integer} [options.buffer_height=y_size]
+ * @param {String} [options.data_type] See {{#crossLink "Constants (GDT)"}}GDT
+ * constants{{/crossLink}}, defaults to the data type of the first band.
+ * @param {Integer} [options.pixel_space] Defaults to the size of the data type * number of bands
+ * @param {Integer} [options.line_space] Defaults to `pixel_space * buffer_width`
+ * @param {Integer} [options.band_space] Defaults to the size of the data type
+ * @param {Integer} [options.offset=0] Byte offset in the `ArrayBuffer` or `SharedArrayBuffer`
+ * @return {TypedArray} A
+ * [TypedArray](https://developer.mozilla.org/en-US/docs/Web/API/ArrayBufferView#Typed_array_subclasses)
+ * of values.
+ */
+NAN_METHOD(Dataset::rasterIO) {
+  _do_raster_io(info, false);
+}
+
+/**
+ * Asynchronously reads a region of pixels of several bands in one call.
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ * The operation can be aborted with an
+ * [AbortSignal](https://developer.mozilla.org/en-US/docs/Web/API/AbortSignal), the Promise is then
+ * rejected with an `AbortError`.
+ *
+ * @throws Error
+ * @method rasterIOAsync
+ * @param {Integer} x
+ * @param {Integer} y
+ * @param {Integer} width
+ * @param {Integer} height
+ * @param {TypedArray|ArrayBuffer|SharedArrayBuffer} [data] The
+ * [TypedArray](https://developer.mozilla.org/en-US/docs/Web/API/ArrayBufferView#Typed_array_subclasses)
+ * to put the data in. A new array is created if not given. When an `ArrayBuffer` or a `SharedArrayBuffer` is given,
+ * the data is read in place into a view of the data type starting at `options.offset`.
+ * @param {Object} [options]
+ * @param {Integer[]} [options.bands] The band numbers to read, all the bands when not given
+ * @param {Integer} [options.buffer_width=x_size]
+ * @param {Integer} [options.buffer_height=y_size]
+ * @param {String} [options.data_type] See {{#crossLink "Constants (GDT)"}}GDT
+ * constants{{/crossLink}}, defaults to the data type of the first band.
+ * @param {Integer} [options.pixel_space] Defaults to the size of the data type * number of bands
+ * @param {Integer} [options.line_space] Defaults to `pixel_space * buffer_width`
+ * @param {Integer} [options.band_space] Defaults to the size of the data type
+ * @param {Integer} [options.offset=0] Byte offset in the `ArrayBuffer` or `SharedArrayBuffer`
+ * @param {AbortSignal} [options.signal] Aborts the operation when signaled
+ * @param {ProgressCb} [options.progress_cb] Called with the completion ratio, between 0 and 1
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter, can be specified even if
+ * certain optional parameters are omitted
+ * @return {Promise<TypedArray>}
+ */
+NAN_METHOD(Dataset::rasterIOAsync) {
+  _do_raster_io(info, true);
 }
 
 /**
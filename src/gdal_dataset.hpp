@@ -15,6 +15,9 @@
 #include <ogrsf_frmts.h>
 
 #include "utils/obj_cache.hpp"
+#include "utils/reader_pool.hpp"
+
+#include <memory>
 
 using namespace v8;
 using namespace node;
@@ -41,6 +44,9 @@ class Dataset : public Nan::ObjectWrap {
   static NAN_METHOD(executeSQL);
   static NAN_METHOD(testCapability);
   static NAN_METHOD(buildOverviews);
+  static NAN_METHOD(buildOverviewsAsync);
+  static NAN_METHOD(rasterIO);
+  static NAN_METHOD(rasterIOAsync);
   static NAN_METHOD(close);
 
   static NAN_GETTER(bandsGetter);
@@ -83,6 +89,8 @@ class Dataset : public Nan::ObjectWrap {
 #endif
 
   uv_mutex_t *async_lock;
+  // only for the datasets opened read-only, see ReaderPool
+  std::shared_ptr<ReaderPool> reader_pool;
 
     private:
   ~Dataset();
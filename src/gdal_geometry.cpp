@@ -10,12 +10,14 @@
 #include "gdal_multipolygon.hpp"
 #include "gdal_point.hpp"
 #include "gdal_polygon.hpp"
+#include "gdal_prepared_geometry.hpp"
 #include "gdal_spatial_reference.hpp"
 
 #include <node_buffer.h>
 #include <ogr_core.h>
 #include <sstream>
 #include <stdlib.h>
+#include <vector>
 
 namespace node_gdal {
 
@@ -32,6 +34,7 @@ void Geometry::Initialize(Local<Object> target) {
   Nan::SetMethod(lcons, "fromWKT", Geometry::createFromWkt);
   Nan::SetMethod(lcons, "fromWKB", Geometry::createFromWkb);
   Nan::SetMethod(lcons, "fromGeoJson", Geometry::createFromGeoJson);
+  Nan::SetMethod(lcons, "fromGeoJsonObject", Geometry::createFromGeoJsonObject);
   Nan::SetMethod(lcons, "getName", Geometry::getName);
   Nan::SetMethod(lcons, "getConstructor", Geometry::getConstructor);
 
@@ -39,6 +42,7 @@ void Geometry::Initialize(Local<Object> target) {
   Nan::SetPrototypeMethod(lcons, "toKML", exportToKML);
   Nan::SetPrototypeMethod(lcons, "toGML", exportToGML);
   Nan::SetPrototypeMethod(lcons, "toJSON", exportToJSON);
+  Nan::SetPrototypeMethod(lcons, "toObject", toObject);
   Nan::SetPrototypeMethod(lcons, "toWKT", exportToWKT);
   Nan::SetPrototypeMethod(lcons, "toWKB", exportToWKB);
   Nan::SetPrototypeMethod(lcons, "isEmpty", isEmpty);
@@ -73,6 +77,7 @@ void Geometry::Initialize(Local<Object> target) {
   Nan::SetPrototypeMethod(lcons, "getEnvelope3D", getEnvelope3D);
   Nan::SetPrototypeMethod(lcons, "transform", transform);
   Nan::SetPrototypeMethod(lcons, "transformTo", transformTo);
+  Nan::SetPrototypeMethod(lcons, "prepare", prepare);
 
   ATTR(lcons, "srs", srsGetter, srsSetter);
   ATTR(lcons, "wkbSize", wkbSizeGetter, READ_ONLY_SETTER);
@@ -365,6 +370,33 @@ NODE_WRAPPED_METHOD_WITH_OGRERR_RESULT_1_WRAPPED_PARAM(
 NODE_WRAPPED_METHOD_WITH_OGRERR_RESULT_1_WRAPPED_PARAM(
   Geometry, transformTo, transformTo, SpatialReference, "spatial reference");
 
+/**
+ * Prepares the geometry for repeated spatial predicates: the GEOS geometry
+ * and its indexes are built once instead of on every call.
+ *
+ * The prepared geometry is a snapshot, later changes to the geometry are not
+ * reflected.
+ *
+ * @example
+ * ```
+ * var prepared = polygon.prepare();
+ * points.forEach(function(pt) {
+ *   if (prepared.contains(pt)) { ... }
+ * });```
+ *
+ * @throws Error
+ * @method prepare
+ * @return gdal.PreparedGeometry
+ */
+NAN_METHOD(Geometry::prepare) {
+  Nan::HandleScope scope;
+  Geometry *geom = Nan::ObjectWrap::Unwrap<Geometry>(info.This());
+
+  Local<Value> prepared = PreparedGeometry::New(geom->this_);
+  if (prepared.IsEmpty() || prepared->IsUndefined()) return;
+  info.GetReturnValue().Set(prepared);
+}
+
 /**
  * Clones the instance.
  *
@@ -689,6 +721,157 @@ NAN_METHOD(Geometry::exportToJSON) {
   return;
 }
 
+/*
+ * GeoJSON objects are built directly from the OGRGeometry coordinates,
+ * with the same output as exportToJson() except for the coordinates that are
+ * not rounded to 15 significant digits: null for an empty point, a non-finite
+ * coordinate or a geometry type that has no GeoJSON equivalent
+ */
+
+struct GeoJSONKeys {
+  Local<String> type;
+  Local<String> coordinates;
+  Local<String> geometries;
+  GeoJSONKeys()
+    : type(Nan::New("type").ToLocalChecked()),
+      coordinates(Nan::New("coordinates").ToLocalChecked()),
+      geometries(Nan::New("geometries").ToLocalChecked()) {
+  }
+};
+
+// the nested arrays are created with all their elements at once
+static inline Local<Array> newArray(std::vector<Local<Value>> &elements) {
+#if V8_MAJOR_VERSION >= 7
+  return Array::New(v8::Isolate::GetCurrent(), elements.data(), elements.size());
+#else
+  Local<Array> array = Nan::New<Array>(elements.size());
+  for (size_t i = 0; i < elements.size(); i++) Nan::Set(array, i, elements[i]);
+  return array;
+#endif
+}
+
+static bool positionToArray(double x, double y, double z, bool has_z, Local<Value> &result) {
+  if (!CPLIsFinite(x) || !CPLIsFinite(y) || (has_z && !CPLIsFinite(z))) return false;
+  std::vector<Local<Value>> position = {Nan::New<Number>(x), Nan::New<Number>(y)};
+  if (has_z) position.push_back(Nan::New<Number>(z));
+  result = newArray(position);
+  return true;
+}
+
+static bool curveToArray(const OGRLineString *curve, Local<Value> &result) {
+  bool has_z = wkbHasZ(curve->getGeometryType());
+  int n = curve->getNumPoints();
+  std::vector<Local<Value>> positions(n);
+  for (int i = 0; i < n; i++) {
+    if (!positionToArray(curve->getX(i), curve->getY(i), has_z ? curve->getZ(i) : 0, has_z, positions[i]))
+      return false;
+  }
+  result = newArray(positions);
+  return true;
+}
+
+static bool polygonToArray(const OGRPolygon *polygon, Local<Value> &result) {
+  std::vector<Local<Value>> rings;
+  const OGRLinearRing *exterior = polygon->getExteriorRing();
+  if (exterior != nullptr) {
+    rings.resize(polygon->getNumInteriorRings() + 1);
+    if (!curveToArray(exterior, rings[0])) return false;
+    for (int i = 0; i < polygon->getNumInteriorRings(); i++) {
+      if (!curveToArray(polygon->getInteriorRing(i), rings[i + 1])) return false;
+    }
+  }
+  result = newArray(rings);
+  return true;
+}
+
+static Local<Value> geometryToObject(const OGRGeometry *geom, const GeoJSONKeys &keys) {
+  Nan::EscapableHandleScope scope;
+  OGRwkbGeometryType type = wkbFlatten(geom->getGeometryType());
+  const OGRGeometryCollection *collection = nullptr;
+  Local<Value> coordinates;
+  const char *name;
+  bool ok = true;
+
+  if (type == wkbPoint && geom->IsEmpty()) return scope.Escape(Nan::Null());
+
+  switch (type) {
+    case wkbPoint: {
+      const OGRPoint *point = static_cast<const OGRPoint *>(geom);
+      name = "Point";
+      ok = positionToArray(point->getX(), point->getY(), point->getZ(), wkbHasZ(geom->getGeometryType()), coordinates);
+      break;
+    }
+    case wkbLineString:
+      name = "LineString";
+      ok = curveToArray(static_cast<const OGRLineString *>(geom), coordinates);
+      break;
+    case wkbPolygon:
+      name = "Polygon";
+      ok = polygonToArray(static_cast<const OGRPolygon *>(geom), coordinates);
+      break;
+    case wkbMultiPoint:
+    case wkbMultiLineString:
+    case wkbMultiPolygon: {
+      collection = static_cast<const OGRGeometryCollection *>(geom);
+      name = type == wkbMultiPoint ? "MultiPoint" : type == wkbMultiLineString ? "MultiLineString" : "MultiPolygon";
+      std::vector<Local<Value>> children(collection->getNumGeometries());
+      for (size_t i = 0; ok && i < children.size(); i++) {
+        const OGRGeometry *child = collection->getGeometryRef(i);
+        if (type == wkbMultiPoint) {
+          const OGRPoint *point = static_cast<const OGRPoint *>(child);
+          // an empty point in a multipoint is not representable
+          ok = !point->IsEmpty() &&
+            positionToArray(point->getX(), point->getY(), point->getZ(), wkbHasZ(point->getGeometryType()), children[i]);
+        } else if (type == wkbMultiLineString) {
+          ok = curveToArray(static_cast<const OGRLineString *>(child), children[i]);
+        } else {
+          ok = polygonToArray(static_cast<const OGRPolygon *>(child), children[i]);
+        }
+      }
+      if (ok) coordinates = newArray(children);
+      break;
+    }
+    case wkbGeometryCollection: {
+      collection = static_cast<const OGRGeometryCollection *>(geom);
+      std::vector<Local<Value>> children(collection->getNumGeometries());
+      for (size_t i = 0; ok && i < children.size(); i++) {
+        children[i] = geometryToObject(collection->getGeometryRef(i), keys);
+        ok = !children[i]->IsNull();
+      }
+      if (!ok) return scope.Escape(Nan::Null());
+      Local<Object> result = Nan::New<Object>();
+      Nan::Set(result, keys.type, Nan::New("GeometryCollection").ToLocalChecked());
+      Nan::Set(result, keys.geometries, newArray(children));
+      return scope.Escape(result);
+    }
+    default: return scope.Escape(Nan::Null());
+  }
+
+  if (!ok) return scope.Escape(Nan::Null());
+  Local<Object> result = Nan::New<Object>();
+  Nan::Set(result, keys.type, Nan::New(name).ToLocalChecked());
+  Nan::Set(result, keys.coordinates, coordinates);
+  return scope.Escape(result);
+}
+
+/**
+ * Converts the geometry to a GeoJSON object representation.
+ *
+ * The object is built directly from the coordinates, without going through
+ * a JSON string. Returns `null` for an empty point, for non-finite coordinates and
+ * for the geometry types that have no GeoJSON equivalent.
+ *
+ * @method toObject
+ * @return {Object} GeoJSON
+ */
+NAN_METHOD(Geometry::toObject) {
+  Nan::HandleScope scope;
+
+  Geometry *geom = Nan::ObjectWrap::Unwrap<Geometry>(info.This());
+  GeoJSONKeys keys;
+  info.GetReturnValue().Set(geometryToObject(geom->this_, keys));
+}
+
 /**
  * Compute the centroid of the geometry.
  *
@@ -875,6 +1058,198 @@ NAN_METHOD(Geometry::createFromGeoJson) {
 #endif
 }
 
+/*
+ * The parsers return false after throwing an error, the partially built
+ * geometry is destroyed by the caller
+ */
+
+static bool parsePosition(Local<Value> value, double &x, double &y, double &z, bool &has_z) {
+  if (!value->IsArray()) {
+    Nan::ThrowError("Invalid GeoJSON: a position must be an array");
+    return false;
+  }
+  Local<Array> position = value.As<Array>();
+  unsigned int length = position->Length();
+  if (length < 2) {
+    Nan::ThrowError("Invalid GeoJSON: a position must have at least two elements");
+    return false;
+  }
+  Local<Value> vx = Nan::Get(position, 0).ToLocalChecked();
+  Local<Value> vy = Nan::Get(position, 1).ToLocalChecked();
+  Local<Value> vz = length > 2 ? Nan::Get(position, 2).ToLocalChecked() : Local<Value>();
+  if (!vx->IsNumber() || !vy->IsNumber() || (length > 2 && !vz->IsNumber())) {
+    Nan::ThrowError("Invalid GeoJSON: coordinates must be numbers");
+    return false;
+  }
+  x = Nan::To<double>(vx).ToChecked();
+  y = Nan::To<double>(vy).ToChecked();
+  has_z = length > 2;
+  z = has_z ? Nan::To<double>(vz).ToChecked() : 0;
+  return true;
+}
+
+static bool parseArray(Local<Value> value, Local<Array> &array) {
+  if (!value->IsArray()) {
+    Nan::ThrowError("Invalid GeoJSON: coordinates must be nested arrays");
+    return false;
+  }
+  array = value.As<Array>();
+  return true;
+}
+
+static bool parsePoint(Local<Value> value, OGRPoint *point) {
+  Local<Array> coordinates;
+  if (!parseArray(value, coordinates)) return false;
+  // an empty coordinates array is an empty point
+  if (coordinates->Length() == 0) return true;
+  double x, y, z;
+  bool has_z;
+  if (!parsePosition(coordinates, x, y, z, has_z)) return false;
+  point->setX(x);
+  point->setY(y);
+  if (has_z) point->setZ(z);
+  return true;
+}
+
+static bool parseCurve(Local<Value> value, OGRLineString *curve) {
+  Local<Array> positions;
+  if (!parseArray(value, positions)) return false;
+  unsigned int n = positions->Length();
+  std::vector<OGRRawPoint> xy(n);
+  std::vector<double> z(n);
+  bool any_z = false;
+  for (unsigned int i = 0; i < n; i++) {
+    bool has_z;
+    if (!parsePosition(Nan::Get(positions, i).ToLocalChecked(), xy[i].x, xy[i].y, z[i], has_z)) return false;
+    any_z = any_z || has_z;
+  }
+  curve->setPoints(n, xy.data(), any_z ? z.data() : nullptr);
+  return true;
+}
+
+static bool parsePolygon(Local<Value> value, OGRPolygon *polygon) {
+  Local<Array> rings;
+  if (!parseArray(value, rings)) return false;
+  for (unsigned int i = 0; i < rings->Length(); i++) {
+    OGRLinearRing *ring = new OGRLinearRing();
+    if (!parseCurve(Nan::Get(rings, i).ToLocalChecked(), ring)) {
+      delete ring;
+      return false;
+    }
+    polygon->addRingDirectly(ring);
+  }
+  return true;
+}
+
+static OGRGeometry *parseGeometry(Local<Value> value, const GeoJSONKeys &keys) {
+  Nan::HandleScope scope;
+
+  if (!value->IsObject()) {
+    Nan::ThrowError("Invalid GeoJSON: a geometry must be an object");
+    return nullptr;
+  }
+  Local<Object> obj = value.As<Object>();
+  Local<Value> type_val = Nan::Get(obj, keys.type).ToLocalChecked();
+  if (!type_val->IsString()) {
+    Nan::ThrowError("Invalid GeoJSON: missing geometry type");
+    return nullptr;
+  }
+  std::string type = *Nan::Utf8String(type_val);
+
+  if (type == "GeometryCollection") {
+    Local<Value> geometries_val = Nan::Get(obj, keys.geometries).ToLocalChecked();
+    if (!geometries_val->IsArray()) {
+      Nan::ThrowError("Invalid GeoJSON: geometries must be an array");
+      return nullptr;
+    }
+    Local<Array> geometries = geometries_val.As<Array>();
+    OGRGeometryCollection *collection = new OGRGeometryCollection();
+    for (unsigned int i = 0; i < geometries->Length(); i++) {
+      OGRGeometry *child = parseGeometry(Nan::Get(geometries, i).ToLocalChecked(), keys);
+      if (child == nullptr) {
+        delete collection;
+        return nullptr;
+      }
+      collection->addGeometryDirectly(child);
+    }
+    return collection;
+  }
+
+  Local<Value> coordinates = Nan::Get(obj, keys.coordinates).ToLocalChecked();
+  OGRGeometry *geom = nullptr;
+  bool ok = false;
+  if (type == "Point") {
+    geom = new OGRPoint();
+    ok = parsePoint(coordinates, static_cast<OGRPoint *>(geom));
+  } else if (type == "LineString") {
+    geom = new OGRLineString();
+    ok = parseCurve(coordinates, static_cast<OGRLineString *>(geom));
+  } else if (type == "Polygon") {
+    geom = new OGRPolygon();
+    ok = parsePolygon(coordinates, static_cast<OGRPolygon *>(geom));
+  } else if (type == "MultiPoint" || type == "MultiLineString" || type == "MultiPolygon") {
+    Local<Array> children;
+    OGRGeometryCollection *collection;
+    if (type == "MultiPoint") {
+      collection = new OGRMultiPoint();
+    } else if (type == "MultiLineString") {
+      collection = new OGRMultiLineString();
+    } else {
+      collection = new OGRMultiPolygon();
+    }
+    geom = collection;
+    ok = parseArray(coordinates, children);
+    for (unsigned int i = 0; ok && i < children->Length(); i++) {
+      Local<Value> child_coordinates = Nan::Get(children, i).ToLocalChecked();
+      OGRGeometry *child;
+      if (type == "MultiPoint") {
+        child = new OGRPoint();
+        ok = parsePoint(child_coordinates, static_cast<OGRPoint *>(child));
+      } else if (type == "MultiLineString") {
+        child = new OGRLineString();
+        ok = parseCurve(child_coordinates, static_cast<OGRLineString *>(child));
+      } else {
+        child = new OGRPolygon();
+        ok = parsePolygon(child_coordinates, static_cast<OGRPolygon *>(child));
+      }
+      collection->addGeometryDirectly(child);
+    }
+  } else {
+    Nan::ThrowError(("Invalid GeoJSON: unsupported geometry type " + type).c_str());
+    return nullptr;
+  }
+
+  if (!ok) {
+    delete geom;
+    return nullptr;
+  }
+  return geom;
+}
+
+/**
+ * Creates a Geometry from a GeoJSON object.
+ *
+ * The geometry is built directly from the object, without going through
+ * a JSON string.
+ *
+ * @static
+ * @method fromGeoJsonObject
+ * @throws Error
+ * @param {Object} geojson
+ * @return gdal.Geometry
+ */
+NAN_METHOD(Geometry::createFromGeoJsonObject) {
+  Nan::HandleScope scope;
+
+  Local<Object> geo_obj;
+  NODE_ARG_OBJECT(0, "geojson", geo_obj);
+
+  GeoJSONKeys keys;
+  OGRGeometry *geom = parseGeometry(geo_obj, keys);
+  if (geom == nullptr) return;
+  info.GetReturnValue().Set(Geometry::New(geom, true));
+}
+
 /**
  * Creates an empty Geometry from a WKB type.
  *
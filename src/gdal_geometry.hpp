@@ -36,6 +36,7 @@ class Geometry : public Nan::ObjectWrap {
   static NAN_METHOD(exportToKML);
   static NAN_METHOD(exportToGML);
   static NAN_METHOD(exportToJSON);
+  static NAN_METHOD(toObject);
   static NAN_METHOD(exportToWKT);
   static NAN_METHOD(exportToWKB);
   static NAN_METHOD(closeRings);
@@ -66,12 +67,14 @@ class Geometry : public Nan::ObjectWrap {
   static NAN_METHOD(getEnvelope3D);
   static NAN_METHOD(transform);
   static NAN_METHOD(transformTo);
+  static NAN_METHOD(prepare);
 
   // static constructor methods
   static NAN_METHOD(create);
   static NAN_METHOD(createFromWkt);
   static NAN_METHOD(createFromWkb);
   static NAN_METHOD(createFromGeoJson);
+  static NAN_METHOD(createFromGeoJsonObject);
   static NAN_METHOD(getName);
   static NAN_METHOD(getConstructor);
 
@@ -12,6 +12,7 @@
 
 #include <sstream>
 #include <stdlib.h>
+#include <vector>
 
 namespace node_gdal {
 
@@ -32,6 +33,10 @@ void Layer::Initialize(Local<Object> target) {
   Nan::SetPrototypeMethod(lcons, "getSpatialFilter", getSpatialFilter);
   Nan::SetPrototypeMethod(lcons, "testCapability", testCapability);
   Nan::SetPrototypeMethod(lcons, "flush", syncToDisk);
+  Nan::SetPrototypeMethod(lcons, "buildSpatialIndex", buildSpatialIndex);
+  Nan::SetPrototypeMethod(lcons, "saveSpatialIndex", saveSpatialIndex);
+  Nan::SetPrototypeMethod(lcons, "loadSpatialIndex", loadSpatialIndex);
+  Nan::SetPrototypeMethod(lcons, "query", query);
 
   ATTR_DONT_ENUM(lcons, "ds", dsGetter, READ_ONLY_SETTER);
   ATTR_DONT_ENUM(lcons, "_uid", uidGetter, READ_ONLY_SETTER);
@@ -48,11 +53,12 @@ void Layer::Initialize(Local<Object> target) {
   constructor.Reset(lcons);
 }
 
-Layer::Layer(OGRLayer *layer) : Nan::ObjectWrap(), uid(0), this_(layer), parent_ds(0) {
+Layer::Layer(OGRLayer *layer)
+  : Nan::ObjectWrap(), uid(0), async_lock(0), pending_feature(0), this_(layer), parent_ds(0) {
   LOG("Created layer [%p]", layer);
 }
 
-Layer::Layer() : Nan::ObjectWrap(), uid(0), this_(0), parent_ds(0) {
+Layer::Layer() : Nan::ObjectWrap(), uid(0), async_lock(0), pending_feature(0), this_(0), parent_ds(0) {
 }
 
 Layer::~Layer() {
@@ -65,12 +71,34 @@ void Layer::dispose() {
     LOG("Disposing layer [%p]", this_);
 
     ptr_manager.dispose(uid);
+    spatial_index.reset();
+    dropPendingFeature();
 
     LOG("Disposed layer [%p]", this_);
     this_ = NULL;
   }
 };
 
+/*
+ * The next feature of the reading position, the caller holds async_lock
+ */
+OGRFeature *Layer::nextFeature() {
+  if (pending_feature) {
+    OGRFeature *feature = pending_feature;
+    pending_feature = NULL;
+    return feature;
+  }
+  return this_->GetNextFeature();
+}
+
+/*
+ * Called when the reading position is reset
+ */
+void Layer::dropPendingFeature() {
+  if (pending_feature) OGRFeature::DestroyFeature(pending_feature);
+  pending_feature = NULL;
+}
+
 /**
  * A representation of a layer of simple vector features, with access methods.
  *
@@ -154,10 +182,12 @@ Local<Value> Layer::New(OGRLayer *raw, OGRDataSource *raw_parent, bool result_se
     // ds = Dataset::New(raw_parent); //should never happen
   }
 
-  long parent_uid = Nan::ObjectWrap::Unwrap<Dataset>(ds)->uid;
+  Dataset *parent = Nan::ObjectWrap::Unwrap<Dataset>(ds);
+  long parent_uid = parent->uid;
 
   wrapped->uid = ptr_manager.add(raw, parent_uid, result_set);
   wrapped->parent_ds = raw_parent;
+  wrapped->async_lock = parent->async_lock;
   Nan::SetPrivate(obj, Nan::New("ds_").ToLocalChecked(), ds);
 
   return scope.Escape(obj);
@@ -299,6 +329,10 @@ NAN_METHOD(Layer::setSpatialFilter) {
     Nan::ThrowError("Invalid number of arguments");
     return;
   }
+  // a new filter restarts the reading
+  uv_mutex_lock(layer->async_lock);
+  layer->dropPendingFeature();
+  uv_mutex_unlock(layer->async_lock);
 
   return;
 }
@@ -343,6 +377,9 @@ NAN_METHOD(Layer::setAttributeFilter) {
   } else {
     err = layer->this_->SetAttributeFilter(filter.c_str());
   }
+  uv_mutex_lock(layer->async_lock);
+  layer->dropPendingFeature();
+  uv_mutex_unlock(layer->async_lock);
 
   if (err) {
     NODE_THROW_OGRERR(err);
@@ -352,6 +389,217 @@ NAN_METHOD(Layer::setAttributeFilter) {
   return;
 }
 
+/**
+ * Builds an in-memory spatial index (a packed Hilbert R-tree) over the
+ * envelopes of the features of the layer, for use by
+ * {{#crossLink "gdal.Layer/query:method"}}query(){{/crossLink}}.
+ *
+ * The features are read once, the current attribute and spatial filters
+ * apply. Features without a geometry are not indexed. The index is dropped
+ * when features are added, changed or removed through `layer.features` or
+ * written by `gdal.polygonize()` and `gdal.contourGenerate()`.
+ *
+ * The scan restarts the reading of the layer: an iteration with
+ * `layer.features.next()` in progress is reset to the first feature.
+ *
+ * @example
+ * ```
+ * layer.buildSpatialIndex();
+ * var fids = layer.query({minX: 0, minY: 0, maxX: 10, maxY: 10});```
+ *
+ * @throws Error
+ * @method buildSpatialIndex
+ * @param {Object} [options]
+ * @param {Integer} [options.node_size=16] Number of entries per node of the tree
+ * @return {Integer} The number of indexed features
+ */
+NAN_METHOD(Layer::buildSpatialIndex) {
+  Nan::HandleScope scope;
+
+  Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(info.This());
+  if (!layer->isAlive()) {
+    Nan::ThrowError("Layer object has already been destroyed");
+    return;
+  }
+
+  int node_size = SpatialIndex::DEFAULT_NODE_SIZE;
+  if (info.Length() > 0 && !info[0]->IsUndefined() && !info[0]->IsNull()) {
+    Local<Object> options;
+    NODE_ARG_OBJECT(0, "options", options);
+    NODE_INT_FROM_OBJ_OPT(options, "node_size", node_size);
+    if (node_size < 2 || node_size > 0xFFFF) {
+      Nan::ThrowRangeError("node_size must be between 2 and 65535");
+      return;
+    }
+  }
+
+  std::vector<SpatialIndex::Item> items;
+  uv_mutex_lock(layer->async_lock);
+  layer->this_->ResetReading();
+  layer->dropPendingFeature();
+  OGRFeature *feature;
+  while ((feature = layer->this_->GetNextFeature()) != nullptr) {
+    OGRGeometry *geom = feature->GetGeometryRef();
+    if (geom != nullptr && !geom->IsEmpty()) {
+      SpatialIndex::Item item;
+      geom->getEnvelope(&item.envelope);
+      item.fid = feature->GetFID();
+      items.push_back(item);
+    }
+    OGRFeature::DestroyFeature(feature);
+  }
+  layer->this_->ResetReading();
+  uv_mutex_unlock(layer->async_lock);
+
+  layer->spatial_index.reset(new SpatialIndex(items, node_size));
+
+  info.GetReturnValue().Set(Nan::New<Number>(layer->spatial_index->size()));
+}
+
+/**
+ * Saves the spatial index built by
+ * {{#crossLink "gdal.Layer/buildSpatialIndex:method"}}buildSpatialIndex(){{/crossLink}}
+ * to a file, the file can be read back with
+ * {{#crossLink "gdal.Layer/loadSpatialIndex:method"}}loadSpatialIndex(){{/crossLink}}
+ * on the same machine.
+ *
+ * @throws Error
+ * @method saveSpatialIndex
+ * @param {String} filename
+ */
+NAN_METHOD(Layer::saveSpatialIndex) {
+  Nan::HandleScope scope;
+
+  Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(info.This());
+  if (!layer->isAlive()) {
+    Nan::ThrowError("Layer object has already been destroyed");
+    return;
+  }
+
+  std::string filename;
+  NODE_ARG_STR(0, "filename", filename);
+
+  if (!layer->spatial_index) {
+    Nan::ThrowError("The layer has no spatial index, call buildSpatialIndex() first");
+    return;
+  }
+  if (!layer->spatial_index->save(filename.c_str())) {
+    NODE_THROW_LAST_CPLERR();
+    return;
+  }
+}
+
+/**
+ * Loads a spatial index saved by
+ * {{#crossLink "gdal.Layer/saveSpatialIndex:method"}}saveSpatialIndex(){{/crossLink}}.
+ *
+ * The index is not checked against the features of the layer, it must have
+ * been built from the same data.
+ *
+ * @throws Error
+ * @method loadSpatialIndex
+ * @param {String} filename
+ * @return {Integer} The number of indexed features
+ */
+NAN_METHOD(Layer::loadSpatialIndex) {
+  Nan::HandleScope scope;
+
+  Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(info.This());
+  if (!layer->isAlive()) {
+    Nan::ThrowError("Layer object has already been destroyed");
+    return;
+  }
+
+  std::string filename;
+  NODE_ARG_STR(0, "filename", filename);
+
+  SpatialIndex *index = SpatialIndex::load(filename.c_str());
+  if (index == nullptr) {
+    Nan::ThrowError(("Failed to load a spatial index from " + filename).c_str());
+    return;
+  }
+  layer->spatial_index.reset(index);
+
+  info.GetReturnValue().Set(Nan::New<Number>(index->size()));
+}
+
+/**
+ * Finds the features whose envelope intersects the given envelope using the
+ * spatial index built by
+ * {{#crossLink "gdal.Layer/buildSpatialIndex:method"}}buildSpatialIndex(){{/crossLink}}.
+ *
+ * Only the envelopes are compared, the geometries of the returned features
+ * may not intersect the envelope. With `features: true`, the features without
+ * an id or no longer in the layer are left out.
+ *
+ * @example
+ * ```
+ * var fids = layer.query(new gdal.Envelope({minX: 0, minY: 0, maxX: 10, maxY: 10}));
+ * var features = layer.query({minX: 0, minY: 0, maxX: 10, maxY: 10}, {features: true});```
+ *
+ * @throws Error
+ * @method query
+ * @param {gdal.Envelope|Object} envelope An object containing `minX`, `maxX`, `minY`, and `maxY` values.
+ * @param {Object} [options]
+ * @param {Boolean} [options.features=false] Return the features instead of their ids
+ * @return {Number[]|gdal.Feature[]}
+ */
+NAN_METHOD(Layer::query) {
+  Nan::HandleScope scope;
+
+  Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(info.This());
+  if (!layer->isAlive()) {
+    Nan::ThrowError("Layer object has already been destroyed");
+    return;
+  }
+
+  Local<Object> obj;
+  NODE_ARG_OBJECT(0, "envelope", obj);
+  OGREnvelope envelope;
+  NODE_DOUBLE_FROM_OBJ(obj, "minX", envelope.MinX);
+  NODE_DOUBLE_FROM_OBJ(obj, "minY", envelope.MinY);
+  NODE_DOUBLE_FROM_OBJ(obj, "maxX", envelope.MaxX);
+  NODE_DOUBLE_FROM_OBJ(obj, "maxY", envelope.MaxY);
+
+  bool features = false;
+  if (info.Length() > 1 && !info[1]->IsUndefined() && !info[1]->IsNull()) {
+    Local<Object> options;
+    NODE_ARG_OBJECT(1, "options", options);
+    NODE_BOOL_FROM_OBJ_OPT(options, "features", features);
+  }
+
+  if (!layer->spatial_index) {
+    Nan::ThrowError("The layer has no spatial index, call buildSpatialIndex() first");
+    return;
+  }
+
+  std::vector<GIntBig> fids;
+  layer->spatial_index->search(envelope, fids);
+
+  if (!features) {
+    Local<Array> results = Nan::New<Array>(fids.size());
+    for (size_t i = 0; i < fids.size(); i++) Nan::Set(results, i, Nan::New<Number>(fids[i]));
+    info.GetReturnValue().Set(results);
+    return;
+  }
+
+  // the features without an id cannot be fetched back
+  std::vector<OGRFeature *> found;
+  found.reserve(fids.size());
+  uv_mutex_lock(layer->async_lock);
+  for (GIntBig fid : fids) {
+    if (fid == OGRNullFID) continue;
+    OGRFeature *feature = layer->this_->GetFeature(fid);
+    if (feature) found.push_back(feature);
+  }
+  uv_mutex_unlock(layer->async_lock);
+
+  Local<Array> results = Nan::New<Array>(found.size());
+  for (size_t i = 0; i < found.size(); i++) Nan::Set(results, i, Feature::New(found[i]));
+
+  info.GetReturnValue().Set(results);
+}
+
 /*
 NAN_METHOD(Layer::getLayerDefn)
 {
@@ -13,6 +13,9 @@
 
 #include "gdal_dataset.hpp"
 #include "utils/obj_cache.hpp"
+#include "utils/spatial_index.hpp"
+
+#include <memory>
 
 using namespace v8;
 using namespace node;
@@ -38,6 +41,10 @@ class Layer : public Nan::ObjectWrap {
   static NAN_METHOD(getSpatialFilter);
   static NAN_METHOD(testCapability);
   static NAN_METHOD(syncToDisk);
+  static NAN_METHOD(buildSpatialIndex);
+  static NAN_METHOD(saveSpatialIndex);
+  static NAN_METHOD(loadSpatialIndex);
+  static NAN_METHOD(query);
 
   static NAN_SETTER(dsSetter);
   static NAN_GETTER(dsGetter);
@@ -70,7 +77,22 @@ class Layer : public Nan::ObjectWrap {
   }
 #endif
   void dispose();
+  OGRFeature *nextFeature();
+  void dropPendingFeature();
   long uid;
+  /* Dataset manages the async lock lifetime
+   * Layer carries it
+   * LayerFeatures uses it
+   */
+  uv_mutex_t *async_lock;
+  /* In-memory index built by buildSpatialIndex()
+   * dropped when features are added, changed or removed
+   */
+  std::unique_ptr<SpatialIndex> spatial_index;
+  /* Feature read by readBatch() that did not fit in its batch,
+   * returned first by the next read, both are under async_lock
+   */
+  OGRFeature *pending_feature;
 
     private:
   ~Layer();
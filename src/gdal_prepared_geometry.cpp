@@ -0,0 +1,226 @@
+#include "gdal_prepared_geometry.hpp"
+#include "gdal_common.hpp"
+#include "gdal_geometry.hpp"
+#include "utils/typed_array.hpp"
+
+namespace node_gdal {
+
+Nan::Persistent<FunctionTemplate> PreparedGeometry::constructor;
+
+void PreparedGeometry::Initialize(Local<Object> target) {
+  Nan::HandleScope scope;
+
+  Local<FunctionTemplate> lcons = Nan::New<FunctionTemplate>(PreparedGeometry::New);
+  lcons->InstanceTemplate()->SetInternalFieldCount(1);
+  lcons->SetClassName(Nan::New("PreparedGeometry").ToLocalChecked());
+
+  Nan::SetPrototypeMethod(lcons, "toString", toString);
+  Nan::SetPrototypeMethod(lcons, "intersects", intersects);
+  Nan::SetPrototypeMethod(lcons, "contains", contains);
+  Nan::SetPrototypeMethod(lcons, "intersectsPoints", intersectsPoints);
+  Nan::SetPrototypeMethod(lcons, "containsPoints", containsPoints);
+
+  Nan::Set(target, Nan::New("PreparedGeometry").ToLocalChecked(), Nan::GetFunction(lcons).ToLocalChecked());
+
+  constructor.Reset(lcons);
+}
+
+PreparedGeometry::PreparedGeometry(OGRPreparedGeometry *prepared, const OGREnvelope &envelope)
+  : Nan::ObjectWrap(), this_(prepared), envelope(envelope) {
+  LOG("Created PreparedGeometry [%p]", prepared);
+}
+
+PreparedGeometry::PreparedGeometry() : Nan::ObjectWrap(), this_(0) {
+}
+
+PreparedGeometry::~PreparedGeometry() {
+  if (this_) {
+    LOG("Disposing PreparedGeometry [%p]", this_);
+    OGRDestroyPreparedGeometry(this_);
+    LOG("Disposed PreparedGeometry [%p]", this_);
+    this_ = NULL;
+  }
+}
+
+/**
+ * A geometry prepared for repeated spatial predicates, created with
+ * {{#crossLink "gdal.Geometry/prepare:method"}}Geometry.prepare(){{/crossLink}}.
+ *
+ * The prepared geometry is independent from the geometry it was created from.
+ *
+ * @class gdal.PreparedGeometry
+ */
+NAN_METHOD(PreparedGeometry::New) {
+  Nan::HandleScope scope;
+
+  if (!info.IsConstructCall()) {
+    Nan::ThrowError("Cannot call constructor as function, you need to use 'new' keyword");
+    return;
+  }
+
+  if (info[0]->IsExternal()) {
+    Local<External> ext = info[0].As<External>();
+    void *ptr = ext->Value();
+    PreparedGeometry *f = static_cast<PreparedGeometry *>(ptr);
+    f->Wrap(info.This());
+    info.GetReturnValue().Set(info.This());
+    return;
+  } else {
+    Nan::ThrowError("Cannot create PreparedGeometry directly, use Geometry.prepare()");
+    return;
+  }
+}
+
+Local<Value> PreparedGeometry::New(OGRGeometry *geom) {
+  Nan::EscapableHandleScope scope;
+
+  if (!OGRHasPreparedGeometrySupport()) {
+    Nan::ThrowError("GDAL was built without prepared geometry support (GEOS >= 3.1 is needed)");
+    return scope.Escape(Nan::Undefined());
+  }
+
+  OGRPreparedGeometry *prepared = OGRCreatePreparedGeometry(geom);
+  if (!prepared) {
+    NODE_THROW_LAST_CPLERR();
+    return scope.Escape(Nan::Undefined());
+  }
+  OGREnvelope envelope;
+  geom->getEnvelope(&envelope);
+
+  PreparedGeometry *wrapped = new PreparedGeometry(prepared, envelope);
+
+  Local<Value> ext = Nan::New<External>(wrapped);
+  Local<Object> obj =
+    Nan::NewInstance(Nan::GetFunction(Nan::New(PreparedGeometry::constructor)).ToLocalChecked(), 1, &ext)
+      .ToLocalChecked();
+
+  return scope.Escape(obj);
+}
+
+NAN_METHOD(PreparedGeometry::toString) {
+  Nan::HandleScope scope;
+  info.GetReturnValue().Set(Nan::New("PreparedGeometry").ToLocalChecked());
+}
+
+/**
+ * Determines if the prepared geometry intersects the given geometry.
+ *
+ * @method intersects
+ * @param {gdal.Geometry} geometry
+ * @return Boolean
+ */
+NAN_METHOD(PreparedGeometry::intersects) {
+  Nan::HandleScope scope;
+  Geometry *geom;
+  NODE_ARG_WRAPPED(0, "geometry to compare", Geometry, geom);
+  PreparedGeometry *prepared = Nan::ObjectWrap::Unwrap<PreparedGeometry>(info.This());
+
+  info.GetReturnValue().Set(Nan::New<Boolean>(OGRPreparedGeometryIntersects(prepared->this_, geom->get())));
+}
+
+/**
+ * Determines if the prepared geometry contains the given geometry.
+ *
+ * @method contains
+ * @param {gdal.Geometry} geometry
+ * @return Boolean
+ */
+NAN_METHOD(PreparedGeometry::contains) {
+  Nan::HandleScope scope;
+  Geometry *geom;
+  NODE_ARG_WRAPPED(0, "geometry to compare", Geometry, geom);
+  PreparedGeometry *prepared = Nan::ObjectWrap::Unwrap<PreparedGeometry>(info.This());
+
+  info.GetReturnValue().Set(Nan::New<Boolean>(OGRPreparedGeometryContains(prepared->this_, geom->get())));
+}
+
+typedef int (*PreparedPredicate)(const OGRPreparedGeometry *, const OGRGeometry *);
+
+/*
+ * Tests all the points of a flat coordinates array against a prepared geometry,
+ * the points outside of its envelope are rejected without going through GEOS
+ */
+static void testPoints(const Nan::FunctionCallbackInfo<v8::Value> &info, PreparedPredicate predicate) {
+  PreparedGeometry *prepared = Nan::ObjectWrap::Unwrap<PreparedGeometry>(info.This());
+
+  if (info.Length() < 1 || !info[0]->IsFloat64Array()) {
+    Nan::ThrowTypeError("points must be a Float64Array");
+    return;
+  }
+  int dimensions = 2;
+  NODE_ARG_INT_OPT(1, "dimensions", dimensions);
+  if (dimensions != 2 && dimensions != 3) {
+    Nan::ThrowRangeError("dimensions must be 2 or 3");
+    return;
+  }
+
+  Nan::TypedArrayContents<double> contents(info[0]);
+  size_t length = contents.length();
+  if (length % dimensions) {
+    Nan::ThrowRangeError("The length of points must be a multiple of dimensions");
+    return;
+  }
+  size_t n = length / dimensions;
+
+  Local<Value> result = TypedArray::New(GDT_Byte, n);
+  if (result.IsEmpty() || !result->IsObject()) return;
+  GByte *data = (GByte *)TypedArray::Validate(result.As<Object>(), GDT_Byte, n);
+  if (!data) return;
+
+  const double *coords = *contents;
+  const OGREnvelope &envelope = prepared->getEnvelope();
+  OGRPoint pt;
+  for (size_t i = 0; i < n; i++) {
+    double x = coords[i * dimensions];
+    double y = coords[i * dimensions + 1];
+    if (x < envelope.MinX || x > envelope.MaxX || y < envelope.MinY || y > envelope.MaxY) {
+      data[i] = 0;
+      continue;
+    }
+    pt.setX(x);
+    pt.setY(y);
+    if (dimensions == 3) pt.setZ(coords[i * dimensions + 2]);
+    data[i] = predicate(prepared->get(), &pt) ? 1 : 0;
+  }
+
+  info.GetReturnValue().Set(result);
+}
+
+/**
+ * Determines which points of a flat coordinates array
+ * (`x0, y0, x1, y1, ...` or `x0, y0, z0, x1, y1, z1, ...`)
+ * intersect the prepared geometry.
+ *
+ * @example
+ * ```
+ * var prepared = polygon.prepare();
+ * var inside = prepared.intersectsPoints(new Float64Array([0, 0, 10, 10]));```
+ *
+ * @method intersectsPoints
+ * @throws Error
+ * @param {Float64Array} points
+ * @param {Integer} [dimensions=2] `2` or `3`
+ * @return {Uint8Array} 1 for each point that intersects the geometry, 0 otherwise
+ */
+NAN_METHOD(PreparedGeometry::intersectsPoints) {
+  Nan::HandleScope scope;
+  testPoints(info, OGRPreparedGeometryIntersects);
+}
+
+/**
+ * Determines which points of a flat coordinates array
+ * (`x0, y0, x1, y1, ...` or `x0, y0, z0, x1, y1, z1, ...`)
+ * are contained in the prepared geometry.
+ *
+ * @method containsPoints
+ * @throws Error
+ * @param {Float64Array} points
+ * @param {Integer} [dimensions=2] `2` or `3`
+ * @return {Uint8Array} 1 for each point that is contained in the geometry, 0 otherwise
+ */
+NAN_METHOD(PreparedGeometry::containsPoints) {
+  Nan::HandleScope scope;
+  testPoints(info, OGRPreparedGeometryContains);
+}
+
+} // namespace node_gdal
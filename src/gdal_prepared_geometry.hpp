@@ -0,0 +1,50 @@
+#ifndef __NODE_OGR_PREPARED_GEOMETRY_H__
+#define __NODE_OGR_PREPARED_GEOMETRY_H__
+
+// node
+#include <node.h>
+#include <node_object_wrap.h>
+
+// nan
+#include "nan-wrapper.h"
+
+// ogr
+#include <ogrsf_frmts.h>
+
+using namespace v8;
+using namespace node;
+
+namespace node_gdal {
+
+class PreparedGeometry : public Nan::ObjectWrap {
+    public:
+  static Nan::Persistent<FunctionTemplate> constructor;
+  static void Initialize(Local<Object> target);
+  static NAN_METHOD(New);
+  static Local<Value> New(OGRGeometry *geom);
+  static NAN_METHOD(toString);
+  static NAN_METHOD(intersects);
+  static NAN_METHOD(contains);
+  static NAN_METHOD(intersectsPoints);
+  static NAN_METHOD(containsPoints);
+
+  PreparedGeometry();
+  PreparedGeometry(OGRPreparedGeometry *prepared, const OGREnvelope &envelope);
+  inline OGRPreparedGeometry *get() {
+    return this_;
+  }
+  inline bool isAlive() {
+    return this_;
+  }
+  inline const OGREnvelope &getEnvelope() {
+    return envelope;
+  }
+
+    private:
+  ~PreparedGeometry();
+  OGRPreparedGeometry *this_;
+  OGREnvelope envelope;
+};
+
+} // namespace node_gdal
+#endif
@@ -6,9 +6,17 @@
 #include "gdal_dataset.hpp"
 #include "gdal_majorobject.hpp"
 #include "gdal_rasterband.hpp"
+#include "async/async_worker.hpp"
 
 #include <cpl_port.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace node_gdal {
 
@@ -28,6 +36,12 @@ void RasterBand::Initialize(Local<Object> target) {
   Nan::SetPrototypeMethod(lcons, "getStatistics", getStatistics);
   Nan::SetPrototypeMethod(lcons, "setStatistics", setStatistics);
   Nan::SetPrototypeMethod(lcons, "computeStatistics", computeStatistics);
+  Nan::SetPrototypeMethod(lcons, "computeStatisticsAsync", computeStatisticsAsync);
+  Nan::SetPrototypeMethod(lcons, "getHistogram", getHistogram);
+  Nan::SetPrototypeMethod(lcons, "getHistogramAsync", getHistogramAsync);
+  Nan::SetPrototypeMethod(lcons, "getDefaultHistogram", getDefaultHistogram);
+  Nan::SetPrototypeMethod(lcons, "getDefaultHistogramAsync", getDefaultHistogramAsync);
+  Nan::SetPrototypeMethod(lcons, "setDefaultHistogram", setDefaultHistogram);
   Nan::SetPrototypeMethod(lcons, "getMaskBand", getMaskBand);
   Nan::SetPrototypeMethod(lcons, "getMaskFlags", getMaskFlags);
   Nan::SetPrototypeMethod(lcons, "createMaskBand", createMaskBand);
@@ -38,9 +52,6 @@ void RasterBand::Initialize(Local<Object> target) {
   // Nan::SetPrototypeMethod(lcons, "rasterIO", rasterIO);
   // Nan::SetPrototypeMethod(lcons, "getColorTable", getColorTable);
   // Nan::SetPrototypeMethod(lcons, "setColorTable", setColorTable);
-  // Nan::SetPrototypeMethod(lcons, "getHistogram", getHistogram);
-  // Nan::SetPrototypeMethod(lcons, "getDefaultHistogram", getDefaultHistogram);
-  // Nan::SetPrototypeMethod(lcons, "setDefaultHistogram", setDefaultHistogram);
 
   ATTR_DONT_ENUM(lcons, "ds", dsGetter, READ_ONLY_SETTER);
   ATTR_DONT_ENUM(lcons, "_uid", uidGetter, READ_ONLY_SETTER);
@@ -157,6 +168,11 @@ Local<Value> RasterBand::New(GDALRasterBand *raw, GDALDataset *raw_parent) {
   wrapped->uid = ptr_manager.add(raw, parent_uid);
   wrapped->parent_ds = raw_parent;
   wrapped->async_lock = async_lock;
+  // overview bands don't exist as such in the pooled handles
+  int band_id = raw->GetBand();
+  if (band_id > 0 && band_id <= raw_parent->GetRasterCount() && raw_parent->GetRasterBand(band_id) == raw) {
+    wrapped->reader_pool = parent->reader_pool;
+  }
   Nan::SetPrivate(obj, Nan::New("ds_").ToLocalChecked(), ds);
 
   return scope.Escape(obj);
@@ -337,6 +353,316 @@ NAN_METHOD(RasterBand::getStatistics) {
   info.GetReturnValue().Set(result);
 }
 
+// thread-safe variant for the statistics computed in a worker thread,
+// the message is stored in the user data of the handler
+void CPL_STDCALL statisticsLocalErrorHandler(CPLErr, int err_no, const char *msg) {
+  if (err_no == CPLE_OpenFailed) { *static_cast<std::string *>(CPLGetErrorHandlerUserData()) = msg; }
+}
+
+struct StatisticsResult {
+  double min, max, mean, std_dev;
+  std::string file_err;
+};
+
+#if GDAL_VERSION_MAJOR < 2
+typedef int HistogramBucket;
+#else
+typedef GUIntBig HistogramBucket;
+#endif
+
+struct HistogramResult {
+  double min, max;
+  int buckets;
+  std::vector<HistogramBucket> histogram;
+};
+
+/*
+ * Statistics and histogram of the pixels scanned by one thread,
+ * the partial results of the threads are merged at the end of the scan
+ */
+struct BandScan {
+  GUIntBig count;
+  double min, max, mean, m2;
+  std::vector<HistogramBucket> histogram;
+
+  BandScan(int buckets)
+    : count(0),
+      min(std::numeric_limits<double>::infinity()),
+      max(-std::numeric_limits<double>::infinity()),
+      mean(0),
+      m2(0),
+      histogram(buckets) {
+  }
+
+  void add(GUIntBig n, double min, double max, double mean, double m2);
+  void merge(const BandScan &other);
+};
+
+// combines the mean and the sum of squared deviations of two sets (Chan et al.)
+void BandScan::add(GUIntBig n, double n_min, double n_max, double n_mean, double n_m2) {
+  if (n == 0) return;
+  double total = static_cast<double>(count + n);
+  double delta = n_mean - mean;
+  mean += delta * n / total;
+  m2 += n_m2 + delta * delta * (static_cast<double>(count) * n / total);
+  count += n;
+  min = std::min(min, n_min);
+  max = std::max(max, n_max);
+}
+
+void BandScan::merge(const BandScan &other) {
+  add(other.count, other.min, other.max, other.mean, other.m2);
+  for (size_t i = 0; i < histogram.size(); i++) histogram[i] += other.histogram[i];
+}
+
+/*
+ * Accumulates a window of values read as Float64,
+ * the mean and the deviations of the window are computed in two passes
+ * and merged into the running statistics
+ */
+static void scanWindow(
+  BandScan &scan,
+  const double *values,
+  size_t n,
+  bool has_nodata,
+  double nodata,
+  const HistogramResult *bounds,
+  bool include_out_of_range) {
+  GUIntBig count = 0;
+  double sum = 0, min = std::numeric_limits<double>::infinity(), max = -min;
+  for (size_t i = 0; i < n; i++) {
+    double v = values[i];
+    if (std::isnan(v) || (has_nodata && v == nodata)) continue;
+    count++;
+    sum += v;
+    min = std::min(min, v);
+    max = std::max(max, v);
+  }
+  if (count == 0) return;
+
+  double mean = sum / count, m2 = 0;
+  double scale = bounds ? bounds->buckets / (bounds->max - bounds->min) : 0;
+  for (size_t i = 0; i < n; i++) {
+    double v = values[i];
+    if (std::isnan(v) || (has_nodata && v == nodata)) continue;
+    m2 += (v - mean) * (v - mean);
+    if (bounds) {
+      // the same bucketing as GDALRasterBand::GetHistogram
+      double index = std::floor((v - bounds->min) * scale);
+      if (index < 0) {
+        if (include_out_of_range) scan.histogram[0]++;
+      } else if (index >= bounds->buckets) {
+        if (include_out_of_range) scan.histogram[bounds->buckets - 1]++;
+      } else {
+        scan.histogram[static_cast<int>(index)]++;
+      }
+    }
+  }
+  scan.add(count, min, max, mean, m2);
+}
+
+/*
+ * Scans a band of a read-only dataset on several threads
+ *
+ * The block rows are distributed to the threads, each of them reads
+ * through its own pooled handle and accumulates its partial BandScan,
+ * the partials are merged in result. A thread that does not get a pooled
+ * handle reads through the main handle under the async_lock.
+ *
+ * Complex bands and approximate results are left to the single-threaded
+ * GDAL scanner, as are the datasets without a ReaderPool.
+ */
+static CPLErr scanBand(
+  GDALRasterBand *gdal_band,
+  uv_mutex_t *async_lock,
+  std::shared_ptr<ReaderPool> reader_pool,
+  const HistogramResult *bounds,
+  bool include_out_of_range,
+  BandScan &result,
+  GDALProgressFunc pfnProgress,
+  void *pProgressArg) {
+  uv_mutex_lock(async_lock);
+  int band_id = gdal_band->GetBand();
+  int x_size = gdal_band->GetXSize(), y_size = gdal_band->GetYSize();
+  int block_x, block_y;
+  gdal_band->GetBlockSize(&block_x, &block_y);
+  int has_nodata;
+  double nodata = gdal_band->GetNoDataValue(&has_nodata);
+  // the values are compared at the precision of the band
+  if (has_nodata && gdal_band->GetRasterDataType() == GDT_Float32) nodata = static_cast<float>(nodata);
+  uv_mutex_unlock(async_lock);
+
+  size_t rows = (y_size + block_y - 1) / block_y;
+  size_t threads = std::min<size_t>(std::max(CPLGetNumCPUs(), 1), rows);
+  std::vector<BandScan> partials(threads, BandScan(result.histogram.size()));
+  std::mutex err_lock;
+  std::atomic<size_t> next(0), done(0);
+  std::atomic<bool> failed(false);
+  std::string err_msg;
+
+  auto scan = [&](size_t t, bool report) {
+    GDALDataset *reader = reader_pool->acquire();
+    GDALRasterBand *src = reader ? reader->GetRasterBand(band_id) : gdal_band;
+    std::vector<double> values(static_cast<size_t>(block_x) * block_y);
+    std::string file_err;
+    CPLPushErrorHandlerEx(statisticsLocalErrorHandler, &file_err);
+    size_t row;
+    while (!failed && (row = next++) < rows) {
+      int y = row * block_y, h = std::min(block_y, y_size - y);
+      for (int x = 0; x < x_size && !failed; x += block_x) {
+        int w = std::min(block_x, x_size - x);
+        if (!reader) uv_mutex_lock(async_lock);
+        CPLErr err = GDALRasterIO(
+          static_cast<GDALRasterBandH>(src), GF_Read, x, y, w, h, values.data(), w, h, GDT_Float64, 0, 0);
+        if (!reader) uv_mutex_unlock(async_lock);
+        if (err != CE_None || !file_err.empty()) {
+          std::lock_guard<std::mutex> guard(err_lock);
+          if (!failed && !file_err.empty()) {
+            err_msg = file_err;
+          } else if (!failed) {
+            err_msg = CPLGetLastErrorNo() ? CPLGetLastErrorMsg() : "Failed reading the band";
+          }
+          failed = true;
+          break;
+        }
+        scanWindow(
+          partials[t], values.data(), static_cast<size_t>(w) * h, has_nodata, nodata, bounds, include_out_of_range);
+      }
+      done++;
+      if (report && pfnProgress && !pfnProgress((double)done / rows, NULL, pProgressArg)) {
+        std::lock_guard<std::mutex> guard(err_lock);
+        if (!failed) err_msg = "User terminated";
+        failed = true;
+      }
+    }
+    CPLPopErrorHandler();
+    if (reader) reader_pool->release(reader);
+  };
+
+  std::vector<std::thread> workers;
+  for (size_t t = 1; t < threads; t++) workers.push_back(std::thread(scan, t, false));
+  scan(0, true);
+  for (std::thread &worker : workers) worker.join();
+
+  if (failed) {
+    // CPL errors are thread-local, the message of the failed thread is raised again in this one
+    CPLError(CE_Failure, CPLE_AppDefined, "%s", err_msg.c_str());
+    return CE_Failure;
+  }
+  for (const BandScan &partial : partials) result.merge(partial);
+  return CE_None;
+}
+
+// the single-threaded GDAL scanner is used where the parallel scan does not apply
+static bool canScanInParallel(RasterBand *band) {
+  return band->reader_pool && !GDALDataTypeIsComplex(band->get()->GetRasterDataType());
+}
+
+/*
+ * Stores the statistics of a parallel scan the same way as GDALRasterBand::ComputeStatistics,
+ * STATISTICS_VALID_PERCENT is set by its SetValidPercent() which is internal to GDAL
+ */
+static CPLErr storeStatistics(GDALRasterBand *gdal_band, const BandScan &scan, StatisticsResult &r) {
+  GUIntBig total = static_cast<GUIntBig>(gdal_band->GetXSize()) * gdal_band->GetYSize();
+  r.min = scan.min;
+  r.max = scan.max;
+  r.mean = scan.mean;
+  r.std_dev = scan.count > 0 ? sqrt(scan.m2 / scan.count) : 0.0;
+
+  if (scan.count > 0) {
+    if (gdal_band->GetMetadataItem("STATISTICS_APPROXIMATE")) {
+      gdal_band->SetMetadataItem("STATISTICS_APPROXIMATE", NULL);
+    }
+    gdal_band->SetStatistics(r.min, r.max, r.mean, r.std_dev);
+  }
+  if (scan.count == 0) {
+    gdal_band->SetMetadataItem("STATISTICS_VALID_PERCENT", "0");
+  } else if (scan.count == total) {
+    gdal_band->SetMetadataItem("STATISTICS_VALID_PERCENT", "100");
+  } else {
+    // some pixels are nodata, the percentage is never rounded to 100
+    char valid[128];
+    CPLsnprintf(valid, sizeof(valid), "%.4g", 100. * static_cast<double>(scan.count) / total);
+    gdal_band->SetMetadataItem("STATISTICS_VALID_PERCENT", EQUAL(valid, "100") ? "99.999" : valid);
+  }
+
+  if (scan.count > 0) return CE_None;
+  CPLError(CE_Failure, CPLE_AppDefined, "Failed to compute statistics, no valid pixels found in sampling.");
+  return CE_Failure;
+}
+
+/**
+ * Low level statistics computation for both synchronous and asynchronous execution.
+ */
+static void _do_compute_statistics(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async) {
+  Nan::HandleScope scope;
+  int approx;
+  NODE_ARG_BOOL(0, "allow approximation", approx);
+
+  RasterBand *band = Nan::ObjectWrap::Unwrap<RasterBand>(info.This());
+  if (!band->isAlive()) {
+    Nan::ThrowError("RasterBand object has already been destroyed");
+    return;
+  }
+
+  GDALRasterBand *gdal_band = band->get();
+  uv_mutex_t *async_lock = band->async_lock;
+  std::shared_ptr<ReaderPool> reader_pool = canScanInParallel(band) ? band->reader_pool : nullptr;
+  std::shared_ptr<StatisticsResult> r = std::make_shared<StatisticsResult>();
+
+  AsyncGDALWorker::Job doit = [gdal_band, async_lock, reader_pool, approx, r](
+                                GDALProgressFunc pfnProgress, void *pProgressArg) {
+    if (reader_pool && !approx) {
+      BandScan scan(0);
+      CPLErr err = scanBand(gdal_band, async_lock, reader_pool, NULL, false, scan, pfnProgress, pProgressArg);
+      if (err != CE_None) return err;
+      uv_mutex_lock(async_lock);
+      err = storeStatistics(gdal_band, scan, *r);
+      uv_mutex_unlock(async_lock);
+      return err;
+    }
+    uv_mutex_lock(async_lock);
+    CPLPushErrorHandlerEx(statisticsLocalErrorHandler, &r->file_err);
+    CPLErr err =
+      gdal_band->ComputeStatistics(approx, &r->min, &r->max, &r->mean, &r->std_dev, pfnProgress, pProgressArg);
+    CPLPopErrorHandler();
+    uv_mutex_unlock(async_lock);
+    if (!r->file_err.empty()) {
+      CPLErrorSetState(CE_Failure, CPLE_OpenFailed, r->file_err.c_str());
+      return CE_Failure;
+    }
+    return err;
+  };
+  AsyncGDALWorker::Result rval = [r]() {
+    Nan::EscapableHandleScope scope;
+    Local<Object> result = Nan::New<Object>();
+    Nan::Set(result, Nan::New("min").ToLocalChecked(), Nan::New<Number>(r->min));
+    Nan::Set(result, Nan::New("max").ToLocalChecked(), Nan::New<Number>(r->max));
+    Nan::Set(result, Nan::New("mean").ToLocalChecked(), Nan::New<Number>(r->mean));
+    Nan::Set(result, Nan::New("std_dev").ToLocalChecked(), Nan::New<Number>(r->std_dev));
+    return scope.Escape(result.As<Value>());
+  };
+
+  if (async) {
+    Nan::Callback *callback, *progress_cb = NULL;
+    NODE_ARG_CB(3, "callback", callback);
+    NODE_ARG_CB_OPT(2, "progress_cb", progress_cb);
+    AsyncGDALWorker *worker =
+      new AsyncGDALWorker(callback, "node-gdal:ComputeStatistics", info[1], progress_cb, doit, rval);
+    worker->persist(info.This());
+    Nan::AsyncQueueWorker(worker);
+    return;
+  }
+
+  CPLErr err = doit(NULL, NULL);
+  if (err) {
+    NODE_THROW_CPLERR(err);
+    return;
+  }
+
+  info.GetReturnValue().Set(rval());
+}
+
 /**
  * Computes image statistics.
  *
@@ -345,6 +671,9 @@ NAN_METHOD(RasterBand::getStatistics) {
  * `allow_approximation` argument can be set to `true` in which case overviews,
  * or a subset of image tiles may be used in computing the statistics.
  *
+ * The exact statistics of a dataset opened read-only are computed by several
+ * threads scanning different block rows, each with its own handle on the file.
+ *
  * @throws Error
  * @method computeStatistics
  * @param {Boolean} allow_approximation If `true` statistics may be computed
@@ -353,10 +682,57 @@ NAN_METHOD(RasterBand::getStatistics) {
  * `"std_dev"` properties.
  */
 NAN_METHOD(RasterBand::computeStatistics) {
+  _do_compute_statistics(info, false);
+}
+
+/**
+ * Asynchronously computes image statistics.
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ * The operation can be aborted with an
+ * [AbortSignal](https://developer.mozilla.org/en-US/docs/Web/API/AbortSignal), the Promise is then
+ * rejected with an `AbortError`.
+ *
+ * Returns the minimum, maximum, mean and standard deviation of all pixel values
+ * in this band. If approximate statistics are sufficient, the
+ * `allow_approximation` argument can be set to `true` in which case overviews,
+ * or a subset of image tiles may be used in computing the statistics.
+ *
+ * @throws Error
+ * @method computeStatisticsAsync
+ * @param {Boolean} allow_approximation If `true` statistics may be computed
+ * based on overviews or a subset of all tiles.
+ * @param {Object} [options]
+ * @param {AbortSignal} [options.signal] Aborts the operation when signaled
+ * @param {ProgressCb} [options.progress_cb] Called with the completion ratio, between 0 and 1
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter, can be specified even if
+ * certain optional parameters are omitted
+ * @return {Promise<Object>} Statistics containing `"min"`, `"max"`, `"mean"`,
+ * `"std_dev"` properties.
+ */
+NAN_METHOD(RasterBand::computeStatisticsAsync) {
+  _do_compute_statistics(info, true);
+}
+
+/**
+ * Set statistics on the band. This method can be used to store
+ * min/max/mean/standard deviation statistics.
+ *
+ * @throws Error
+ * @method setStatistics
+ * @param {Number} min
+ * @param {Number} max
+ * @param {Number} mean
+ * @param {Number} std_dev
+ */
+NAN_METHOD(RasterBand::setStatistics) {
   Nan::HandleScope scope;
   double min, max, mean, std_dev;
-  int approx;
-  NODE_ARG_BOOL(0, "allow approximation", approx);
+
+  NODE_ARG_DOUBLE(0, "min", min);
+  NODE_ARG_DOUBLE(1, "max", max);
+  NODE_ARG_DOUBLE(2, "mean", mean);
+  NODE_ARG_DOUBLE(3, "standard deviation", std_dev);
 
   RasterBand *band = Nan::ObjectWrap::Unwrap<RasterBand>(info.This());
   if (!band->isAlive()) {
@@ -365,45 +741,350 @@ NAN_METHOD(RasterBand::computeStatistics) {
   }
 
   uv_mutex_lock(band->async_lock);
-  pushStatsErrorHandler();
-  CPLErr err = band->this_->ComputeStatistics(approx, &min, &max, &mean, &std_dev, NULL, NULL);
-  popStatsErrorHandler();
+  CPLErr err = band->this_->SetStatistics(min, max, mean, std_dev);
   uv_mutex_unlock(band->async_lock);
-  if (!stats_file_err.empty()) {
-    Nan::ThrowError(stats_file_err.c_str());
-  } else if (err) {
+
+  if (err) {
     NODE_THROW_CPLERR(err);
     return;
   }
+  return;
+}
 
+static Local<Value> histogramToObject(const HistogramResult &r) {
+  Nan::EscapableHandleScope scope;
   Local<Object> result = Nan::New<Object>();
-  Nan::Set(result, Nan::New("min").ToLocalChecked(), Nan::New<Number>(min));
-  Nan::Set(result, Nan::New("max").ToLocalChecked(), Nan::New<Number>(max));
-  Nan::Set(result, Nan::New("mean").ToLocalChecked(), Nan::New<Number>(mean));
-  Nan::Set(result, Nan::New("std_dev").ToLocalChecked(), Nan::New<Number>(std_dev));
+  Local<Array> buckets = Nan::New<Array>(r.buckets);
+  for (int i = 0; i < r.buckets; i++) {
+    Nan::Set(buckets, i, Nan::New<Number>(static_cast<double>(r.histogram[i])));
+  }
+  Nan::Set(result, Nan::New("min").ToLocalChecked(), Nan::New<Number>(r.min));
+  Nan::Set(result, Nan::New("max").ToLocalChecked(), Nan::New<Number>(r.max));
+  Nan::Set(result, Nan::New("buckets").ToLocalChecked(), buckets);
+  return scope.Escape(result);
+}
 
-  info.GetReturnValue().Set(result);
+/**
+ * Low level histogram computation for both synchronous and asynchronous execution.
+ */
+static void _do_get_histogram(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async) {
+  Nan::HandleScope scope;
+  Local<Object> options;
+  std::shared_ptr<HistogramResult> r = std::make_shared<HistogramResult>();
+  r->min = -0.5;
+  r->max = 255.5;
+  r->buckets = 256;
+  bool include_out_of_range = false;
+  bool approx = false;
+
+  if (info.Length() > 0 && !info[0]->IsUndefined() && !info[0]->IsNull()) {
+    NODE_ARG_OBJECT(0, "options", options);
+    NODE_DOUBLE_FROM_OBJ_OPT(options, "min", r->min);
+    NODE_DOUBLE_FROM_OBJ_OPT(options, "max", r->max);
+    NODE_INT_FROM_OBJ_OPT(options, "buckets", r->buckets);
+    NODE_BOOL_FROM_OBJ_OPT(options, "include_out_of_range", include_out_of_range);
+    NODE_BOOL_FROM_OBJ_OPT(options, "allow_approximation", approx);
+  }
+  if (r->buckets < 1) {
+    Nan::ThrowRangeError("buckets must be greater than 0");
+    return;
+  }
+  if (!(r->max > r->min)) {
+    Nan::ThrowRangeError("max must be greater than min");
+    return;
+  }
+
+  RasterBand *band = Nan::ObjectWrap::Unwrap<RasterBand>(info.This());
+  if (!band->isAlive()) {
+    Nan::ThrowError("RasterBand object has already been destroyed");
+    return;
+  }
+
+  GDALRasterBand *gdal_band = band->get();
+  uv_mutex_t *async_lock = band->async_lock;
+  std::shared_ptr<ReaderPool> reader_pool = canScanInParallel(band) ? band->reader_pool : nullptr;
+  r->histogram.resize(r->buckets);
+
+  AsyncGDALWorker::Job doit = [gdal_band, async_lock, reader_pool, include_out_of_range, approx, r](
+                                GDALProgressFunc pfnProgress, void *pProgressArg) {
+    if (reader_pool && !approx) {
+      BandScan scan(r->buckets);
+      CPLErr err =
+        scanBand(gdal_band, async_lock, reader_pool, r.get(), include_out_of_range, scan, pfnProgress, pProgressArg);
+      if (err == CE_None) r->histogram = scan.histogram;
+      return err;
+    }
+    uv_mutex_lock(async_lock);
+    CPLErr err = gdal_band->GetHistogram(
+      r->min,
+      r->max,
+      r->buckets,
+      r->histogram.data(),
+      include_out_of_range,
+      approx,
+      pfnProgress ? pfnProgress : GDALDummyProgress,
+      pProgressArg);
+    uv_mutex_unlock(async_lock);
+    return err;
+  };
+  AsyncGDALWorker::Result rval = [r]() { return histogramToObject(*r); };
+
+  if (async) {
+    Nan::Callback *callback, *progress_cb = NULL;
+    NODE_ARG_CB(3, "callback", callback);
+    NODE_ARG_CB_OPT(2, "progress_cb", progress_cb);
+    AsyncGDALWorker *worker = new AsyncGDALWorker(callback, "node-gdal:GetHistogram", info[1], progress_cb, doit, rval);
+    worker->persist(info.This());
+    Nan::AsyncQueueWorker(worker);
+    return;
+  }
+
+  CPLErr err = doit(NULL, NULL);
+  if (err) {
+    NODE_THROW_LAST_CPLERR();
+    return;
+  }
+
+  info.GetReturnValue().Set(rval());
 }
 
 /**
- * Set statistics on the band. This method can be used to store
- * min/max/mean/standard deviation statistics.
+ * Computes a histogram of the pixel values of the band.
+ *
+ * The values are counted in `buckets` equal intervals between `min` and `max`.
+ * The defaults, `-0.5`, `255.5` and `256` buckets, are appropriate for
+ * `Byte` bands. The histogram is always computed by scanning the raster
+ * and is not stored, use {{#crossLink "gdal.RasterBand/getDefaultHistogram:method"}}getDefaultHistogram(){{/crossLink}}
+ * for the cached histogram.
+ *
+ * The exact histogram of a dataset opened read-only is computed by several
+ * threads scanning different block rows, each with its own handle on the file.
  *
  * @throws Error
- * @method setStatistics
- * @param {Number} min
- * @param {Number} max
- * @param {Number} mean
- * @param {Number} std_dev
+ * @method getHistogram
+ * @param {Object} [options]
+ * @param {Number} [options.min=-0.5] the lower bound of the histogram
+ * @param {Number} [options.max=255.5] the upper bound of the histogram
+ * @param {Number} [options.buckets=256] the number of buckets
+ * @param {Boolean} [options.include_out_of_range=false] count the values below `min` and above `max`
+ * in the first and last buckets
+ * @param {Boolean} [options.allow_approximation=false] the histogram may be computed from overviews
+ * or a subset of all tiles
+ * @return {Object} Histogram containing `"min"`, `"max"` and `"buckets"`, an array of counts
  */
-NAN_METHOD(RasterBand::setStatistics) {
+NAN_METHOD(RasterBand::getHistogram) {
+  _do_get_histogram(info, false);
+}
+
+/**
+ * Asynchronously computes a histogram of the pixel values of the band.
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ * The operation can be aborted with an
+ * [AbortSignal](https://developer.mozilla.org/en-US/docs/Web/API/AbortSignal), the Promise is then
+ * rejected with an `AbortError`.
+ *
+ * @throws Error
+ * @method getHistogramAsync
+ * @param {Object} [options]
+ * @param {Number} [options.min=-0.5] the lower bound of the histogram
+ * @param {Number} [options.max=255.5] the upper bound of the histogram
+ * @param {Number} [options.buckets=256] the number of buckets
+ * @param {Boolean} [options.include_out_of_range=false] count the values below `min` and above `max`
+ * in the first and last buckets
+ * @param {Boolean} [options.allow_approximation=false] the histogram may be computed from overviews
+ * or a subset of all tiles
+ * @param {AbortSignal} [options.signal] Aborts the operation when signaled
+ * @param {ProgressCb} [options.progress_cb] Called with the completion ratio, between 0 and 1
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter, can be specified even if
+ * certain optional parameters are omitted
+ * @return {Promise<Object>} Histogram containing `"min"`, `"max"` and `"buckets"`, an array of counts
+ */
+NAN_METHOD(RasterBand::getHistogramAsync) {
+  _do_get_histogram(info, true);
+}
+
+/*
+ * Computes the histogram returned by GDALRasterBand::GetDefaultHistogram when there is none,
+ * 256 buckets over the range of the values, and stores it as the default histogram
+ */
+static CPLErr computeDefaultHistogram(
+  GDALRasterBand *gdal_band,
+  uv_mutex_t *async_lock,
+  std::shared_ptr<ReaderPool> reader_pool,
+  HistogramResult &r,
+  GDALProgressFunc pfnProgress,
+  void *pProgressArg) {
+  r.buckets = 256;
+  uv_mutex_lock(async_lock);
+  const char *pixel_type = gdal_band->GetMetadataItem("PIXELTYPE", "IMAGE_STRUCTURE");
+  if (gdal_band->GetRasterDataType() == GDT_Byte && !(pixel_type && EQUAL(pixel_type, "SIGNEDBYTE"))) {
+    r.min = -0.5;
+    r.max = 255.5;
+  } else {
+    CPLErr err = gdal_band->GetStatistics(TRUE, TRUE, &r.min, &r.max, NULL, NULL);
+    if (err != CE_None) {
+      uv_mutex_unlock(async_lock);
+      return err;
+    }
+    double half_bucket = (r.max - r.min) / (2 * (r.buckets - 1));
+    r.min -= half_bucket;
+    r.max += half_bucket;
+  }
+  uv_mutex_unlock(async_lock);
+
+  BandScan scan(r.buckets);
+  CPLErr err = scanBand(gdal_band, async_lock, reader_pool, &r, true, scan, pfnProgress, pProgressArg);
+  if (err != CE_None) return err;
+  r.histogram = scan.histogram;
+
+  uv_mutex_lock(async_lock);
+  err = gdal_band->SetDefaultHistogram(r.min, r.max, r.buckets, r.histogram.data());
+  uv_mutex_unlock(async_lock);
+  return err;
+}
+
+/**
+ * Low level default histogram retrieval for both synchronous and asynchronous execution.
+ */
+static void _do_get_default_histogram(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async) {
   Nan::HandleScope scope;
-  double min, max, mean, std_dev;
+  Local<Object> options;
+  bool force = true;
+
+  if (info.Length() > 0 && !info[0]->IsUndefined() && !info[0]->IsNull()) {
+    NODE_ARG_OBJECT(0, "options", options);
+    NODE_BOOL_FROM_OBJ_OPT(options, "force", force);
+  }
+
+  RasterBand *band = Nan::ObjectWrap::Unwrap<RasterBand>(info.This());
+  if (!band->isAlive()) {
+    Nan::ThrowError("RasterBand object has already been destroyed");
+    return;
+  }
+
+  GDALRasterBand *gdal_band = band->get();
+  uv_mutex_t *async_lock = band->async_lock;
+  std::shared_ptr<ReaderPool> reader_pool = canScanInParallel(band) ? band->reader_pool : nullptr;
+  std::shared_ptr<HistogramResult> r = std::make_shared<HistogramResult>();
+  r->buckets = 0;
+  // CE_Warning means that there is no default histogram and force is false
+  std::shared_ptr<bool> found = std::make_shared<bool>(false);
+
+  AsyncGDALWorker::Job doit = [gdal_band, async_lock, reader_pool, force, r, found](
+                                GDALProgressFunc pfnProgress, void *pProgressArg) {
+    HistogramBucket *histogram = NULL;
+    uv_mutex_lock(async_lock);
+    // a missing histogram is computed by the parallel scan when possible
+    CPLErr err = gdal_band->GetDefaultHistogram(
+      &r->min,
+      &r->max,
+      &r->buckets,
+      &histogram,
+      force && !reader_pool,
+      pfnProgress ? pfnProgress : GDALDummyProgress,
+      pProgressArg);
+    if (err == CE_Warning && force && reader_pool) {
+      uv_mutex_unlock(async_lock);
+      err = computeDefaultHistogram(gdal_band, async_lock, reader_pool, *r, pfnProgress, pProgressArg);
+      if (err == CE_None) *found = true;
+      return err;
+    }
+    uv_mutex_unlock(async_lock);
+    if (err == CE_None && histogram) {
+      r->histogram.assign(histogram, histogram + r->buckets);
+      *found = true;
+    }
+    VSIFree(histogram);
+    return err == CE_Warning ? CE_None : err;
+  };
+  AsyncGDALWorker::Result rval = [r, found]() {
+    Nan::EscapableHandleScope scope;
+    if (!*found) return scope.Escape(Nan::Null().As<Value>());
+    return scope.Escape(histogramToObject(*r));
+  };
+
+  if (async) {
+    Nan::Callback *callback, *progress_cb = NULL;
+    NODE_ARG_CB(3, "callback", callback);
+    NODE_ARG_CB_OPT(2, "progress_cb", progress_cb);
+    AsyncGDALWorker *worker =
+      new AsyncGDALWorker(callback, "node-gdal:GetDefaultHistogram", info[1], progress_cb, doit, rval);
+    worker->persist(info.This());
+    Nan::AsyncQueueWorker(worker);
+    return;
+  }
+
+  CPLErr err = doit(NULL, NULL);
+  if (err) {
+    NODE_THROW_LAST_CPLERR();
+    return;
+  }
+
+  info.GetReturnValue().Set(rval());
+}
+
+/**
+ * Fetches the default histogram of the band.
+ *
+ * The default histogram is the one stored with the dataset, usually in the
+ * `.aux.xml` side-car file. If there is none and `force` is `true`, a
+ * histogram is computed with a number of buckets appropriate for the data
+ * type and is stored as the new default histogram, the same way
+ * {{#crossLink "gdal.RasterBand/computeStatistics:method"}}computeStatistics(){{/crossLink}}
+ * stores the statistics.
+ *
+ * @throws Error
+ * @method getDefaultHistogram
+ * @param {Object} [options]
+ * @param {Boolean} [options.force=true] compute the histogram if there is no default histogram
+ * @return {Object|null} Histogram containing `"min"`, `"max"` and `"buckets"`, an array of counts,
+ * or `null` if there is no default histogram and `force` is `false`
+ */
+NAN_METHOD(RasterBand::getDefaultHistogram) {
+  _do_get_default_histogram(info, false);
+}
+
+/**
+ * Asynchronously fetches the default histogram of the band.
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ * The operation can be aborted with an
+ * [AbortSignal](https://developer.mozilla.org/en-US/docs/Web/API/AbortSignal), the Promise is then
+ * rejected with an `AbortError`.
+ *
+ * @throws Error
+ * @method getDefaultHistogramAsync
+ * @param {Object} [options]
+ * @param {Boolean} [options.force=true] compute the histogram if there is no default histogram
+ * @param {AbortSignal} [options.signal] Aborts the operation when signaled
+ * @param {ProgressCb} [options.progress_cb] Called with the completion ratio, between 0 and 1
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter, can be specified even if
+ * certain optional parameters are omitted
+ * @return {Promise<Object|null>} Histogram containing `"min"`, `"max"` and `"buckets"`, an array of counts,
+ * or `null` if there is no default histogram and `force` is `false`
+ */
+NAN_METHOD(RasterBand::getDefaultHistogramAsync) {
+  _do_get_default_histogram(info, true);
+}
+
+/**
+ * Sets the default histogram of the band.
+ *
+ * @throws Error
+ * @method setDefaultHistogram
+ * @param {Number} min the lower bound of the histogram
+ * @param {Number} max the upper bound of the histogram
+ * @param {Number[]} buckets the counts
+ */
+NAN_METHOD(RasterBand::setDefaultHistogram) {
+  Nan::HandleScope scope;
+  double min, max;
+  Local<Array> buckets;
 
   NODE_ARG_DOUBLE(0, "min", min);
   NODE_ARG_DOUBLE(1, "max", max);
-  NODE_ARG_DOUBLE(2, "mean", mean);
-  NODE_ARG_DOUBLE(3, "standard deviation", std_dev);
+  NODE_ARG_ARRAY(2, "buckets", buckets);
 
   RasterBand *band = Nan::ObjectWrap::Unwrap<RasterBand>(info.This());
   if (!band->isAlive()) {
@@ -411,12 +1092,27 @@ NAN_METHOD(RasterBand::setStatistics) {
     return;
   }
 
+  int n = buckets->Length();
+  if (n < 1) {
+    Nan::ThrowRangeError("buckets must not be empty");
+    return;
+  }
+  std::vector<HistogramBucket> histogram(n);
+  for (int i = 0; i < n; i++) {
+    Local<Value> val = Nan::Get(buckets, i).ToLocalChecked();
+    if (!val->IsNumber() || Nan::To<double>(val).ToChecked() < 0) {
+      Nan::ThrowTypeError("buckets must contain only positive numbers");
+      return;
+    }
+    histogram[i] = static_cast<HistogramBucket>(Nan::To<double>(val).ToChecked());
+  }
+
   uv_mutex_lock(band->async_lock);
-  CPLErr err = band->this_->SetStatistics(min, max, mean, std_dev);
+  CPLErr err = band->this_->SetDefaultHistogram(min, max, n, histogram.data());
   uv_mutex_unlock(band->async_lock);
 
   if (err) {
-    NODE_THROW_CPLERR(err);
+    NODE_THROW_LAST_CPLERR();
     return;
   }
   return;
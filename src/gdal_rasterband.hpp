@@ -30,7 +30,13 @@ class RasterBand : public Nan::ObjectWrap {
   static NAN_METHOD(fill);
   static NAN_METHOD(getStatistics);
   static NAN_METHOD(computeStatistics);
+  static NAN_METHOD(computeStatisticsAsync);
   static NAN_METHOD(setStatistics);
+  static NAN_METHOD(getHistogram);
+  static NAN_METHOD(getHistogramAsync);
+  static NAN_METHOD(getDefaultHistogram);
+  static NAN_METHOD(getDefaultHistogramAsync);
+  static NAN_METHOD(setDefaultHistogram);
   static NAN_METHOD(getMaskBand);
   static NAN_METHOD(getMaskFlags);
   static NAN_METHOD(createMaskBand);
@@ -41,9 +47,6 @@ class RasterBand : public Nan::ObjectWrap {
   // static NAN_METHOD(setColorTable);
   // static NAN_METHOD(rasterIO);
   // static NAN_METHOD(buildOverviews);
-  // static NAN_METHOD(getHistogram);
-  // static NAN_METHOD(getDefaultHistogram);
-  // static NAN_METHOD(setDefaultHistogram);
 
   static NAN_GETTER(dsGetter);
   static NAN_GETTER(sizeGetter);
@@ -92,6 +95,8 @@ class RasterBand : public Nan::ObjectWrap {
    * RasterBandPixels uses it
    */
   uv_mutex_t *async_lock;
+  // the pool of the parent dataset, only for the datasets opened read-only
+  std::shared_ptr<ReaderPool> reader_pool;
 
     private:
   ~RasterBand();
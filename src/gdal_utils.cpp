@@ -0,0 +1,977 @@
+#include "gdal_utils.hpp"
+#include "gdal_common.hpp"
+#include "gdal_dataset.hpp"
+#include "gdal_rasterband.hpp"
+#include "utils/string_list.hpp"
+#include "utils/typed_array.hpp"
+#include "async/async_worker.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string.h>
+#include <string>
+#include <vector>
+
+// the progress setters appeared with the library versions of the utilities
+#if GDAL_VERSION_MAJOR > 2 || (GDAL_VERSION_MAJOR == 2 && GDAL_VERSION_MINOR >= 1)
+#define HAVE_GDAL_UTILS
+#include <gdal_utils.h>
+#endif
+
+namespace node_gdal {
+
+void Utils::Initialize(Local<Object> target) {
+  Nan::SetMethod(target, "translate", translate);
+  Nan::SetMethod(target, "translateAsync", translateAsync);
+  Nan::SetMethod(target, "warp", warp);
+  Nan::SetMethod(target, "warpAsync", warpAsync);
+  Nan::SetMethod(target, "buildVRT", buildVRT);
+  Nan::SetMethod(target, "buildVRTAsync", buildVRTAsync);
+  Nan::SetMethod(target, "vectorTranslate", vectorTranslate);
+  Nan::SetMethod(target, "vectorTranslateAsync", vectorTranslateAsync);
+  Nan::SetMethod(target, "dem", dem);
+  Nan::SetMethod(target, "demAsync", demAsync);
+  Nan::SetMethod(target, "demWindow", demWindow);
+  Nan::SetMethod(target, "demWindowAsync", demWindowAsync);
+}
+
+#ifdef HAVE_GDAL_UTILS
+
+/*
+ * The dataset produced by a utility, it is closed unless it
+ * has been handed to JS or it belongs to an existing Dataset object
+ */
+struct UtilityResult {
+  GDALDatasetH ds = nullptr;
+  bool owned = true;
+  ~UtilityResult() {
+    if (ds && owned) GDALClose(ds);
+  }
+};
+
+typedef std::function<GDALDatasetH(GDALProgressFunc, void *, UtilityResult &)> UtilityJob;
+
+/*
+ * A VRT created from Dataset objects reads them through their GDALDataset:
+ * the VRT keeps the source objects alive, it is closed with any of them
+ * and it shares their async_lock, the callers ensure there is only one
+ */
+static void attachSources(Local<Value> result, Local<Array> sources) {
+  if (sources.IsEmpty() || sources->Length() == 0 || !IS_WRAPPED(result, Dataset)) return;
+  Dataset *vrt = Nan::ObjectWrap::Unwrap<Dataset>(result.As<Object>());
+  GDALDriver *driver = vrt->getDataset()->GetDriver();
+  if (!driver || !EQUAL(driver->GetDescription(), "VRT")) return;
+
+  std::vector<Dataset *> datasets;
+  for (unsigned i = 0; i < sources->Length(); i++)
+    datasets.push_back(Nan::ObjectWrap::Unwrap<Dataset>(Nan::Get(sources, i).ToLocalChecked().As<Object>()));
+
+  for (Dataset *src : datasets) ptr_manager.addDependency(vrt->uid, src->uid);
+  ptr_manager.shareLock(vrt->uid);
+  vrt->async_lock = datasets[0]->async_lock;
+  Nan::SetPrivate(result.As<Object>(), Nan::New("sources_").ToLocalChecked(), sources);
+}
+
+/*
+ * Runs a utility synchronously or in an AsyncGDALWorker, the last three arguments
+ * of the async variants are the cancel flag, the progress callback and the callback
+ *
+ * persist are the Dataset objects used by the job, sources are those that a VRT result may reference,
+ * they are collected by value so emptying the arrays given by the caller does not release them
+ */
+static void runUtility(
+  const Nan::FunctionCallbackInfo<v8::Value> &info,
+  bool async,
+  int flag_arg,
+  const char *label,
+  UtilityJob job,
+  const std::vector<Local<Object>> &persist,
+  const std::vector<Local<Object>> &sources) {
+  std::shared_ptr<UtilityResult> result = std::make_shared<UtilityResult>();
+  Local<Array> source_array = Nan::New<Array>(sources.size());
+  for (size_t i = 0; i < sources.size(); i++) Nan::Set(source_array, i, sources[i]);
+
+  AsyncGDALWorker::Job doit = [job, result](GDALProgressFunc pfnProgress, void *pProgressArg) {
+    CPLErrorReset();
+    result->ds = job(pfnProgress, pProgressArg, *result);
+    return result->ds ? CE_None : CE_Failure;
+  };
+
+  if (async) {
+    Nan::Callback *callback, *progress_cb = NULL;
+    NODE_ARG_CB(flag_arg + 2, "callback", callback);
+    NODE_ARG_CB_OPT(flag_arg + 1, "progress_cb", progress_cb);
+    std::shared_ptr<Nan::Persistent<Array>> persistent(
+      new Nan::Persistent<Array>(source_array), [](Nan::Persistent<Array> *p) {
+        p->Reset();
+        delete p;
+      });
+    AsyncGDALWorker::Result rval = [result, persistent]() {
+      bool owned = result->owned;
+      Local<Value> ds = Dataset::New((GDALDataset *)result->ds);
+      result->ds = nullptr;
+      if (owned) attachSources(ds, Nan::New(*persistent));
+      return ds;
+    };
+    AsyncGDALWorker *worker = new AsyncGDALWorker(callback, label, info[flag_arg], progress_cb, doit, rval);
+    for (Local<Object> obj : persist) worker->persist(obj);
+    Nan::AsyncQueueWorker(worker);
+    return;
+  }
+
+  if (doit(NULL, NULL) != CE_None) {
+    NODE_THROW_LAST_CPLERR();
+    return;
+  }
+  Local<Value> ds = Dataset::New((GDALDataset *)result->ds);
+  result->ds = nullptr;
+  if (result->owned) attachSources(ds, source_array);
+  info.GetReturnValue().Set(ds);
+}
+
+/*
+ * Reads a Dataset or an array of Datasets
+ */
+static bool parseDatasets(
+  Local<Value> value,
+  const char *name,
+  std::vector<GDALDatasetH> &datasets,
+  std::vector<uv_mutex_t *> &locks,
+  std::vector<Local<Object>> &objects) {
+  std::vector<Local<Value>> values;
+  if (value->IsArray()) {
+    Local<Array> array = value.As<Array>();
+    for (unsigned i = 0; i < array->Length(); i++) values.push_back(Nan::Get(array, i).ToLocalChecked());
+  } else {
+    values.push_back(value);
+  }
+  for (Local<Value> v : values) {
+    if (!IS_WRAPPED(v, Dataset)) {
+      Nan::ThrowTypeError((std::string(name) + " must be a Dataset or an array of Datasets").c_str());
+      return false;
+    }
+    Dataset *ds = Nan::ObjectWrap::Unwrap<Dataset>(v.As<Object>());
+    if (!ds->isAlive() || !ds->getDataset()) {
+      Nan::ThrowError("Dataset object has already been destroyed");
+      return false;
+    }
+    datasets.push_back(ds->getDataset());
+    locks.push_back(ds->async_lock);
+    objects.push_back(v.As<Object>());
+  }
+  if (datasets.empty()) {
+    Nan::ThrowError((std::string(name) + " must not be empty").c_str());
+    return false;
+  }
+  return true;
+}
+
+/*
+ * Reads a destination given either as a filename or as an existing Dataset
+ */
+static bool parseDestination(
+  Local<Value> value,
+  std::string &destination,
+  GDALDatasetH &dst,
+  std::vector<uv_mutex_t *> &locks,
+  std::vector<Local<Object>> &objects) {
+  if (value->IsString()) {
+    destination = *Nan::Utf8String(value);
+    return true;
+  }
+  if (IS_WRAPPED(value, Dataset)) {
+    std::vector<GDALDatasetH> dsts;
+    if (!parseDatasets(value, "destination", dsts, locks, objects)) return false;
+    dst = dsts[0];
+    return true;
+  }
+  Nan::ThrowTypeError("destination must be a filename or a Dataset");
+  return false;
+}
+
+static bool parseArgs(const Nan::FunctionCallbackInfo<v8::Value> &info, int arg, StringList &args) {
+  if (info.Length() > arg && !info[arg]->IsUndefined() && !info[arg]->IsNull()) {
+    if (!info[arg]->IsArray()) {
+      Nan::ThrowTypeError("args must be an array of strings");
+      return false;
+    }
+    if (args.parse(info[arg])) return false;
+  }
+  return true;
+}
+
+#define NODE_UTILS_UNSUPPORTED
+#else
+#define NODE_UTILS_UNSUPPORTED                                                                                         \
+  Nan::ThrowError("This operation requires GDAL >= 2.1");                                                              \
+  return;
+#endif
+
+/**
+ * Low level translate for both synchronous and asynchronous execution.
+ */
+static void _do_translate(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async) {
+  Nan::HandleScope scope;
+  NODE_UTILS_UNSUPPORTED
+#ifdef HAVE_GDAL_UTILS
+  std::string destination;
+  std::vector<GDALDatasetH> sources;
+  std::vector<uv_mutex_t *> locks;
+  std::vector<Local<Object>> objects;
+  StringList args;
+
+  NODE_ARG_STR(0, "destination", destination);
+  if (!parseDatasets(info[1], "source", sources, locks, objects)) return;
+  if (sources.size() != 1) {
+    Nan::ThrowError("translate accepts a single source Dataset");
+    return;
+  }
+  if (!parseArgs(info, 2, args)) return;
+
+  std::shared_ptr<GDALTranslateOptions> options(GDALTranslateOptionsNew(args.get(), NULL), GDALTranslateOptionsFree);
+  if (!options) {
+    NODE_THROW_LAST_CPLERR();
+    return;
+  }
+
+  GDALDatasetH src = sources[0];
+  UtilityJob job = [destination, src, options, locks](
+                     GDALProgressFunc pfnProgress, void *pProgressArg, UtilityResult &) mutable {
+    GDALTranslateOptionsSetProgress(options.get(), pfnProgress, pProgressArg);
+    AsyncGDALWorker::lock(locks);
+    GDALDatasetH ds = GDALTranslate(destination.c_str(), src, options.get(), NULL);
+    AsyncGDALWorker::unlock(locks);
+    return ds;
+  };
+
+  runUtility(info, async, 3, "node-gdal:Translate", job, objects, objects);
+#endif
+}
+
+/**
+ * Converts raster data between different formats, the library version of
+ * [gdal_translate](https://gdal.org/programs/gdal_translate.html).
+ *
+ * A VRT produced with `-of VRT` reads from the source Dataset: it keeps it alive,
+ * it is closed when the source is closed and then any access to it throws.
+ *
+ * @example
+ * ```
+ * var out = gdal.translate('out.tif', ds, ['-of', 'GTiff', '-co', 'COMPRESS=DEFLATE', '-outsize', '50%', '50%']);```
+ *
+ * @throws Error
+ * @method translate
+ * @static
+ * @for gdal
+ * @param {String} destination The output filename
+ * @param {gdal.Dataset} source
+ * @param {String[]} [args] The command-line arguments of gdal_translate
+ * @return {gdal.Dataset}
+ */
+NAN_METHOD(Utils::translate) {
+  _do_translate(info, false);
+}
+
+/**
+ * Asynchronously converts raster data between different formats, the library version of
+ * [gdal_translate](https://gdal.org/programs/gdal_translate.html).
+ *
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ * The operation can be aborted with an
+ * [AbortSignal](https://developer.mozilla.org/en-US/docs/Web/API/AbortSignal), the Promise is then
+ * rejected with an `AbortError`.
+ *
+ * @throws Error
+ * @method translateAsync
+ * @static
+ * @for gdal
+ * @param {String} destination The output filename
+ * @param {gdal.Dataset} source
+ * @param {String[]} [args] The command-line arguments of gdal_translate
+ * @param {Object} [options]
+ * @param {AbortSignal} [options.signal] Aborts the operation when signaled
+ * @param {ProgressCb} [options.progress_cb] Called with the completion ratio, between 0 and 1
+ * @param {requestCallback<gdal.Dataset>} [callback] Promisifiable callback, always the last parameter, can be
+ * specified even if certain optional parameters are omitted
+ * @return {Promise<gdal.Dataset>}
+ */
+NAN_METHOD(Utils::translateAsync) {
+  _do_translate(info, true);
+}
+
+/**
+ * Low level warp for both synchronous and asynchronous execution.
+ */
+static void _do_warp(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async) {
+  Nan::HandleScope scope;
+  NODE_UTILS_UNSUPPORTED
+#ifdef HAVE_GDAL_UTILS
+  std::string destination;
+  GDALDatasetH dst = nullptr;
+  std::vector<GDALDatasetH> sources;
+  std::vector<uv_mutex_t *> locks;
+  std::vector<Local<Object>> objects, source_objects;
+  StringList args;
+
+  if (!parseDestination(info[0], destination, dst, locks, objects)) return;
+  if (!parseDatasets(info[1], "sources", sources, locks, source_objects)) return;
+  objects.insert(objects.end(), source_objects.begin(), source_objects.end());
+  if (!parseArgs(info, 2, args)) return;
+
+  std::shared_ptr<GDALWarpAppOptions> options(GDALWarpAppOptionsNew(args.get(), NULL), GDALWarpAppOptionsFree);
+  if (!options) {
+    NODE_THROW_LAST_CPLERR();
+    return;
+  }
+
+  UtilityJob job = [destination, dst, sources, options, locks](
+                     GDALProgressFunc pfnProgress, void *pProgressArg, UtilityResult &result) mutable {
+    // warping into an existing Dataset returns it
+    if (dst) result.owned = false;
+    GDALWarpAppOptionsSetProgress(options.get(), pfnProgress, pProgressArg);
+    AsyncGDALWorker::lock(locks);
+    GDALDatasetH ds = GDALWarp(
+      dst ? NULL : destination.c_str(),
+      dst,
+      sources.size(),
+      sources.data(),
+      options.get(),
+      NULL);
+    AsyncGDALWorker::unlock(locks);
+    return ds;
+  };
+
+  runUtility(info, async, 3, "node-gdal:Warp", job, objects, source_objects);
+#endif
+}
+
+/**
+ * Mosaics, reprojects and warps rasters, the library version of
+ * [gdalwarp](https://gdal.org/programs/gdalwarp.html).
+ *
+ * The destination can be a filename or an existing Dataset that receives the
+ * result. Multithreaded warping is enabled with `-multi` and `-wo NUM_THREADS=ALL_CPUS`.
+ * As with `gdal.translate()`, a VRT produced with `-of VRT` reads from the
+ * sources and is closed with them.
+ *
+ * @example
+ * ```
+ * var out = gdal.warp('out.tif', [ds],
+ *   ['-t_srs', 'EPSG:3857', '-r', 'bilinear', '-multi', '-wo', 'NUM_THREADS=ALL_CPUS']);```
+ *
+ * @throws Error
+ * @method warp
+ * @static
+ * @for gdal
+ * @param {String|gdal.Dataset} destination
+ * @param {gdal.Dataset|gdal.Dataset[]} sources
+ * @param {String[]} [args] The command-line arguments of gdalwarp
+ * @return {gdal.Dataset}
+ */
+NAN_METHOD(Utils::warp) {
+  _do_warp(info, false);
+}
+
+/**
+ * Asynchronously mosaics, reprojects and warps rasters, the library version of
+ * [gdalwarp](https://gdal.org/programs/gdalwarp.html).
+ *
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ * The operation can be aborted with an
+ * [AbortSignal](https://developer.mozilla.org/en-US/docs/Web/API/AbortSignal), the Promise is then
+ * rejected with an `AbortError`.
+ *
+ * @throws Error
+ * @method warpAsync
+ * @static
+ * @for gdal
+ * @param {String|gdal.Dataset} destination
+ * @param {gdal.Dataset|gdal.Dataset[]} sources
+ * @param {String[]} [args] The command-line arguments of gdalwarp
+ * @param {Object} [options]
+ * @param {AbortSignal} [options.signal] Aborts the operation when signaled
+ * @param {ProgressCb} [options.progress_cb] Called with the completion ratio, between 0 and 1
+ * @param {requestCallback<gdal.Dataset>} [callback] Promisifiable callback, always the last parameter, can be
+ * specified even if certain optional parameters are omitted
+ * @return {Promise<gdal.Dataset>}
+ */
+NAN_METHOD(Utils::warpAsync) {
+  _do_warp(info, true);
+}
+
+/**
+ * Low level buildVRT for both synchronous and asynchronous execution.
+ */
+static void _do_build_vrt(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async) {
+  Nan::HandleScope scope;
+  NODE_UTILS_UNSUPPORTED
+#ifdef HAVE_GDAL_UTILS
+  std::string destination;
+  std::vector<GDALDatasetH> sources;
+  std::vector<std::string> names;
+  std::vector<uv_mutex_t *> locks;
+  std::vector<Local<Object>> objects;
+  StringList args;
+
+  NODE_ARG_STR(0, "destination", destination);
+  if (info.Length() > 1 && info[1]->IsArray() && info[1].As<Array>()->Length() > 0 &&
+      Nan::Get(info[1].As<Array>(), 0).ToLocalChecked()->IsString()) {
+    Local<Array> array = info[1].As<Array>();
+    for (unsigned i = 0; i < array->Length(); i++) {
+      Local<Value> name = Nan::Get(array, i).ToLocalChecked();
+      if (!name->IsString()) {
+        Nan::ThrowTypeError("sources must be an array of Datasets or an array of filenames");
+        return;
+      }
+      names.push_back(*Nan::Utf8String(name));
+    }
+  } else if (!parseDatasets(info[1], "sources", sources, locks, objects)) {
+    return;
+  }
+  if (!parseArgs(info, 2, args)) return;
+
+  // gdalbuildvrt reopens the named sources by filename, it references the MEM and unnamed ones
+  // by their handle: these must share one async_lock that the VRT will use too
+  std::vector<Local<Object>> referenced;
+  uv_mutex_t *referenced_lock = nullptr;
+  for (size_t i = 0; i < sources.size(); i++) {
+    GDALDataset *src = (GDALDataset *)sources[i];
+    GDALDriver *driver = src->GetDriver();
+    if (!driver || (*src->GetDescription() != '\0' && !EQUAL(driver->GetDescription(), "MEM"))) continue;
+    if (referenced_lock && locks[i] != referenced_lock) {
+      Nan::ThrowError("The in-memory sources of a VRT must come from the same Dataset, write them to files first");
+      return;
+    }
+    referenced_lock = locks[i];
+    referenced.push_back(objects[i]);
+  }
+
+  std::shared_ptr<GDALBuildVRTOptions> options(GDALBuildVRTOptionsNew(args.get(), NULL), GDALBuildVRTOptionsFree);
+  if (!options) {
+    NODE_THROW_LAST_CPLERR();
+    return;
+  }
+
+  UtilityJob job = [destination, sources, names, options, locks](
+                     GDALProgressFunc pfnProgress, void *pProgressArg, UtilityResult &) mutable {
+    std::vector<const char *> src_names;
+    for (const std::string &name : names) src_names.push_back(name.c_str());
+    src_names.push_back(nullptr);
+
+    GDALBuildVRTOptionsSetProgress(options.get(), pfnProgress, pProgressArg);
+    AsyncGDALWorker::lock(locks);
+    GDALDatasetH ds = GDALBuildVRT(
+      destination.c_str(),
+      names.empty() ? sources.size() : names.size(),
+      names.empty() ? sources.data() : NULL,
+      names.empty() ? NULL : src_names.data(),
+      options.get(),
+      NULL);
+    AsyncGDALWorker::unlock(locks);
+    return ds;
+  };
+
+  runUtility(info, async, 3, "node-gdal:BuildVRT", job, objects, referenced);
+#endif
+}
+
+/**
+ * Builds a VRT from a list of datasets, the library version of
+ * [gdalbuildvrt](https://gdal.org/programs/gdalbuildvrt.html).
+ *
+ * The sources opened from files are reopened by their filename. A VRT built
+ * from MEM or unnamed Dataset objects reads from them: it keeps them alive,
+ * it is closed when one of them is closed and then any access to it throws.
+ * These in-memory sources must all come from the same Dataset.
+ *
+ * @example
+ * ```
+ * var vrt = gdal.buildVRT('/vsimem/mosaic.vrt', ['a.tif', 'b.tif'], ['-resolution', 'highest']);```
+ *
+ * @throws Error
+ * @method buildVRT
+ * @static
+ * @for gdal
+ * @param {String} destination The output filename, can be an empty string for an in-memory VRT
+ * @param {gdal.Dataset[]|String[]} sources
+ * @param {String[]} [args] The command-line arguments of gdalbuildvrt
+ * @return {gdal.Dataset}
+ */
+NAN_METHOD(Utils::buildVRT) {
+  _do_build_vrt(info, false);
+}
+
+/**
+ * Asynchronously builds a VRT from a list of datasets, the library version of
+ * [gdalbuildvrt](https://gdal.org/programs/gdalbuildvrt.html).
+ *
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ * The operation can be aborted with an
+ * [AbortSignal](https://developer.mozilla.org/en-US/docs/Web/API/AbortSignal), the Promise is then
+ * rejected with an `AbortError`.
+ *
+ * @throws Error
+ * @method buildVRTAsync
+ * @static
+ * @for gdal
+ * @param {String} destination The output filename, can be an empty string for an in-memory VRT
+ * @param {gdal.Dataset[]|String[]} sources
+ * @param {String[]} [args] The command-line arguments of gdalbuildvrt
+ * @param {Object} [options]
+ * @param {AbortSignal} [options.signal] Aborts the operation when signaled
+ * @param {ProgressCb} [options.progress_cb] Called with the completion ratio, between 0 and 1
+ * @param {requestCallback<gdal.Dataset>} [callback] Promisifiable callback, always the last parameter, can be
+ * specified even if certain optional parameters are omitted
+ * @return {Promise<gdal.Dataset>}
+ */
+NAN_METHOD(Utils::buildVRTAsync) {
+  _do_build_vrt(info, true);
+}
+
+/**
+ * Low level vectorTranslate for both synchronous and asynchronous execution.
+ */
+static void _do_vector_translate(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async) {
+  Nan::HandleScope scope;
+  NODE_UTILS_UNSUPPORTED
+#ifdef HAVE_GDAL_UTILS
+  std::string destination;
+  GDALDatasetH dst = nullptr;
+  std::vector<GDALDatasetH> sources;
+  std::vector<uv_mutex_t *> locks;
+  std::vector<Local<Object>> objects;
+  StringList args;
+
+  if (!parseDestination(info[0], destination, dst, locks, objects)) return;
+  if (!parseDatasets(info[1], "source", sources, locks, objects)) return;
+  if (sources.size() != 1) {
+    Nan::ThrowError("vectorTranslate accepts a single source Dataset");
+    return;
+  }
+  if (!parseArgs(info, 2, args)) return;
+
+  std::shared_ptr<GDALVectorTranslateOptions> options(
+    GDALVectorTranslateOptionsNew(args.get(), NULL), GDALVectorTranslateOptionsFree);
+  if (!options) {
+    NODE_THROW_LAST_CPLERR();
+    return;
+  }
+
+  UtilityJob job = [destination, dst, sources, options, locks](
+                     GDALProgressFunc pfnProgress, void *pProgressArg, UtilityResult &result) mutable {
+    // translating into an existing Dataset returns it
+    if (dst) result.owned = false;
+    GDALVectorTranslateOptionsSetProgress(options.get(), pfnProgress, pProgressArg);
+    AsyncGDALWorker::lock(locks);
+    GDALDatasetH ds =
+      GDALVectorTranslate(dst ? NULL : destination.c_str(), dst, 1, sources.data(), options.get(), NULL);
+    AsyncGDALWorker::unlock(locks);
+    return ds;
+  };
+
+  runUtility(info, async, 3, "node-gdal:VectorTranslate", job, objects, {});
+#endif
+}
+
+/**
+ * Converts vector data between different formats, the library version of
+ * [ogr2ogr](https://gdal.org/programs/ogr2ogr.html).
+ *
+ * The destination can be a filename or an existing Dataset opened for update,
+ * the features are copied natively without creating any JS objects.
+ *
+ * @example
+ * ```
+ * var out = gdal.vectorTranslate('out.gpkg', ds, ['-f', 'GPKG', '-t_srs', 'EPSG:4326']);
+ * gdal.vectorTranslate(existing, ds, ['-append', '-nln', 'parcels']);```
+ *
+ * @throws Error
+ * @method vectorTranslate
+ * @static
+ * @for gdal
+ * @param {String|gdal.Dataset} destination
+ * @param {gdal.Dataset} source
+ * @param {String[]} [args] The command-line arguments of ogr2ogr
+ * @return {gdal.Dataset}
+ */
+NAN_METHOD(Utils::vectorTranslate) {
+  _do_vector_translate(info, false);
+}
+
+/**
+ * Asynchronously converts vector data between different formats, the library version of
+ * [ogr2ogr](https://gdal.org/programs/ogr2ogr.html).
+ *
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ * The operation can be aborted with an
+ * [AbortSignal](https://developer.mozilla.org/en-US/docs/Web/API/AbortSignal), the Promise is then
+ * rejected with an `AbortError`.
+ *
+ * @throws Error
+ * @method vectorTranslateAsync
+ * @static
+ * @for gdal
+ * @param {String|gdal.Dataset} destination
+ * @param {gdal.Dataset} source
+ * @param {String[]} [args] The command-line arguments of ogr2ogr
+ * @param {Object} [options]
+ * @param {AbortSignal} [options.signal] Aborts the operation when signaled
+ * @param {ProgressCb} [options.progress_cb] Called with the completion ratio, between 0 and 1
+ * @param {requestCallback<gdal.Dataset>} [callback] Promisifiable callback, always the last parameter, can be
+ * specified even if certain optional parameters are omitted
+ * @return {Promise<gdal.Dataset>}
+ */
+NAN_METHOD(Utils::vectorTranslateAsync) {
+  _do_vector_translate(info, true);
+}
+
+/**
+ * Low level dem for both synchronous and asynchronous execution.
+ */
+static void _do_dem(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async) {
+  Nan::HandleScope scope;
+  NODE_UTILS_UNSUPPORTED
+#ifdef HAVE_GDAL_UTILS
+  std::string destination, mode, color_file;
+  std::vector<GDALDatasetH> sources;
+  std::vector<uv_mutex_t *> locks;
+  std::vector<Local<Object>> objects;
+  StringList args;
+
+  NODE_ARG_STR(0, "destination", destination);
+  if (!parseDatasets(info[1], "source", sources, locks, objects)) return;
+  if (sources.size() != 1) {
+    Nan::ThrowError("dem accepts a single source Dataset");
+    return;
+  }
+  NODE_ARG_STR(2, "mode", mode);
+  if (!parseArgs(info, 3, args)) return;
+  NODE_ARG_OPT_STR(4, "color_file", color_file);
+  if (mode == "color-relief" && color_file.empty()) {
+    Nan::ThrowError("color-relief requires a color_file");
+    return;
+  }
+
+  std::shared_ptr<GDALDEMProcessingOptions> options(
+    GDALDEMProcessingOptionsNew(args.get(), NULL), GDALDEMProcessingOptionsFree);
+  if (!options) {
+    NODE_THROW_LAST_CPLERR();
+    return;
+  }
+
+  GDALDatasetH src = sources[0];
+  UtilityJob job = [destination, src, mode, color_file, options, locks](
+                     GDALProgressFunc pfnProgress, void *pProgressArg, UtilityResult &) mutable {
+    GDALDEMProcessingOptionsSetProgress(options.get(), pfnProgress, pProgressArg);
+    AsyncGDALWorker::lock(locks);
+    GDALDatasetH ds = GDALDEMProcessing(
+      destination.c_str(),
+      src,
+      mode.c_str(),
+      color_file.empty() ? NULL : color_file.c_str(),
+      options.get(),
+      NULL);
+    AsyncGDALWorker::unlock(locks);
+    return ds;
+  };
+
+  runUtility(info, async, 5, "node-gdal:DEMProcessing", job, objects, {});
+#endif
+}
+
+/**
+ * Computes hillshade, slope, aspect, color relief, TRI, TPI or roughness rasters
+ * from a DEM, the library version of [gdaldem](https://gdal.org/programs/gdaldem.html).
+ *
+ * @example
+ * ```
+ * var hillshade = gdal.dem('hillshade.tif', ds, 'hillshade', ['-z', '2', '-multidirectional']);
+ * var relief = gdal.dem('', ds, 'color-relief', ['-of', 'MEM', '-alpha'], 'colors.txt');```
+ *
+ * @throws Error
+ * @method dem
+ * @static
+ * @for gdal
+ * @param {String} destination The output filename
+ * @param {gdal.Dataset} source
+ * @param {String} mode `"hillshade"`, `"slope"`, `"aspect"`, `"color-relief"`, `"TRI"`, `"TPI"` or `"roughness"`
+ * @param {String[]} [args] The command-line arguments of gdaldem
+ * @param {String} [color_file] The color configuration file, required by `"color-relief"`
+ * @return {gdal.Dataset}
+ */
+NAN_METHOD(Utils::dem) {
+  _do_dem(info, false);
+}
+
+/**
+ * Asynchronously computes hillshade, slope, aspect, color relief, TRI, TPI or roughness rasters
+ * from a DEM, the library version of [gdaldem](https://gdal.org/programs/gdaldem.html).
+ *
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ * The operation can be aborted with an
+ * [AbortSignal](https://developer.mozilla.org/en-US/docs/Web/API/AbortSignal), the Promise is then
+ * rejected with an `AbortError`.
+ *
+ * @throws Error
+ * @method demAsync
+ * @static
+ * @for gdal
+ * @param {String} destination The output filename
+ * @param {gdal.Dataset} source
+ * @param {String} mode `"hillshade"`, `"slope"`, `"aspect"`, `"color-relief"`, `"TRI"`, `"TPI"` or `"roughness"`
+ * @param {String[]} [args] The command-line arguments of gdaldem
+ * @param {String} [color_file] The color configuration file, required by `"color-relief"`
+ * @param {Object} [options]
+ * @param {AbortSignal} [options.signal] Aborts the operation when signaled
+ * @param {ProgressCb} [options.progress_cb] Called with the completion ratio, between 0 and 1
+ * @param {requestCallback<gdal.Dataset>} [callback] Promisifiable callback, always the last parameter, can be
+ * specified even if certain optional parameters are omitted
+ * @return {Promise<gdal.Dataset>}
+ */
+NAN_METHOD(Utils::demAsync) {
+  _do_dem(info, true);
+}
+
+#ifdef HAVE_GDAL_UTILS
+struct DEMWindowResult {
+  std::vector<GByte> data;
+  GDALDataType type = GDT_Unknown;
+  int bands = 0;
+};
+
+/*
+ * Reads the window with one pixel of padding on each side into a MEM dataset,
+ * the padding gives the 3x3 kernels the real neighbours of the edge pixels
+ */
+static GDALDataset *readPaddedWindow(GDALRasterBand *band, int x, int y, int width, int height, int padding[2]) {
+  int x0 = std::max(0, x - 1), y0 = std::max(0, y - 1);
+  int x1 = std::min(band->GetXSize(), x + width + 1), y1 = std::min(band->GetYSize(), y + height + 1);
+  int w = x1 - x0, h = y1 - y0;
+  padding[0] = x - x0;
+  padding[1] = y - y0;
+
+  GDALDriver *mem_driver = GetGDALDriverManager()->GetDriverByName("MEM");
+  if (!mem_driver) {
+    CPLError(CE_Failure, CPLE_AppDefined, "MEM driver is not available");
+    return nullptr;
+  }
+  GDALDataset *window = mem_driver->Create("", w, h, 1, GDT_Float32, NULL);
+  if (!window) return nullptr;
+
+  GDALDataset *parent = band->GetDataset();
+  double gt[6];
+  if (parent && parent->GetGeoTransform(gt) == CE_None) {
+    gt[0] += x0 * gt[1] + y0 * gt[2];
+    gt[3] += x0 * gt[4] + y0 * gt[5];
+    window->SetGeoTransform(gt);
+    window->SetProjection(parent->GetProjectionRef());
+  }
+  int has_nodata;
+  double nodata = band->GetNoDataValue(&has_nodata);
+  if (has_nodata) window->GetRasterBand(1)->SetNoDataValue(nodata);
+
+  std::vector<float> buffer((size_t)w * h);
+  CPLErr err = band->RasterIO(GF_Read, x0, y0, w, h, buffer.data(), w, h, GDT_Float32, 0, 0, NULL);
+  if (err == CE_None)
+    err = window->GetRasterBand(1)->RasterIO(GF_Write, 0, 0, w, h, buffer.data(), w, h, GDT_Float32, 0, 0, NULL);
+  if (err != CE_None) {
+    GDALClose(window);
+    return nullptr;
+  }
+  return window;
+}
+#endif
+
+/**
+ * Low level demWindow for both synchronous and asynchronous execution.
+ */
+static void _do_dem_window(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async) {
+  Nan::HandleScope scope;
+  NODE_UTILS_UNSUPPORTED
+#ifdef HAVE_GDAL_UTILS
+  RasterBand *band;
+  std::string mode, color_file;
+  int x, y, width, height;
+  StringList args;
+
+  NODE_ARG_WRAPPED(0, "source", RasterBand, band);
+  NODE_ARG_STR(1, "mode", mode);
+  NODE_ARG_INT(2, "x", x);
+  NODE_ARG_INT(3, "y", y);
+  NODE_ARG_INT(4, "width", width);
+  NODE_ARG_INT(5, "height", height);
+  if (!parseArgs(info, 6, args)) return;
+  NODE_ARG_OPT_STR(7, "color_file", color_file);
+  if (mode == "color-relief" && color_file.empty()) {
+    Nan::ThrowError("color-relief requires a color_file");
+    return;
+  }
+
+  GDALRasterBand *gdal_band = band->get();
+  if (
+    x < 0 || y < 0 || width < 1 || height < 1 || x + width > gdal_band->GetXSize() ||
+    y + height > gdal_band->GetYSize()) {
+    Nan::ThrowRangeError("Invalid window");
+    return;
+  }
+
+  // the window is always processed in memory
+  char **argv = CSLDuplicate(args.get());
+  argv = CSLAddString(argv, "-of");
+  argv = CSLAddString(argv, "MEM");
+  std::shared_ptr<GDALDEMProcessingOptions> options(
+    GDALDEMProcessingOptionsNew(argv, NULL), GDALDEMProcessingOptionsFree);
+  CSLDestroy(argv);
+  if (!options) {
+    NODE_THROW_LAST_CPLERR();
+    return;
+  }
+
+  uv_mutex_t *async_lock = band->async_lock;
+  std::shared_ptr<DEMWindowResult> r = std::make_shared<DEMWindowResult>();
+
+  AsyncGDALWorker::Job doit = [gdal_band, async_lock, mode, color_file, x, y, width, height, options, r](
+                                GDALProgressFunc pfnProgress, void *pProgressArg) {
+    int padding[2];
+    // only the source band is shared, the processing works on private MEM datasets
+    uv_mutex_lock(async_lock);
+    GDALDataset *window = readPaddedWindow(gdal_band, x, y, width, height, padding);
+    uv_mutex_unlock(async_lock);
+    if (!window) return CE_Failure;
+
+    GDALDEMProcessingOptionsSetProgress(options.get(), pfnProgress, pProgressArg);
+    GDALDatasetH hOut = GDALDEMProcessing(
+      "",
+      (GDALDatasetH)window,
+      mode.c_str(),
+      color_file.empty() ? NULL : color_file.c_str(),
+      options.get(),
+      NULL);
+    GDALClose(window);
+    if (!hOut) return CE_Failure;
+
+    // pixel interleaved, as expected by image encoders for the color-relief RGB(A) output
+    GDALDataset *out = (GDALDataset *)hOut;
+    r->bands = out->GetRasterCount();
+    r->type = out->GetRasterBand(1)->GetRasterDataType();
+    int size = GDALGetDataTypeSizeBytes(r->type);
+    r->data.resize((size_t)width * height * r->bands * size);
+    CPLErr err = out->RasterIO(
+      GF_Read,
+      padding[0],
+      padding[1],
+      width,
+      height,
+      r->data.data(),
+      width,
+      height,
+      r->type,
+      r->bands,
+      NULL,
+      (GSpacing)size * r->bands,
+      (GSpacing)size * r->bands * width,
+      size,
+      NULL);
+    GDALClose(hOut);
+    return err;
+  };
+
+  AsyncGDALWorker::Result rval = [r, width, height]() {
+    Nan::EscapableHandleScope scope;
+    Local<Value> array = TypedArray::New(r->type, (unsigned int)width * height * r->bands);
+    if (array.IsEmpty() || !array->IsObject()) return scope.Escape(array);
+    void *data = TypedArray::Validate(array.As<Object>(), r->type, width * height * r->bands);
+    if (data) memcpy(data, r->data.data(), r->data.size());
+    return scope.Escape(array);
+  };
+
+  if (async) {
+    Nan::Callback *callback, *progress_cb = NULL;
+    NODE_ARG_CB(10, "callback", callback);
+    NODE_ARG_CB_OPT(9, "progress_cb", progress_cb);
+    AsyncGDALWorker *worker =
+      new AsyncGDALWorker(callback, "node-gdal:DEMProcessingWindow", info[8], progress_cb, doit, rval);
+    worker->persist(band->handle());
+    Nan::AsyncQueueWorker(worker);
+    return;
+  }
+
+  CPLErrorReset();
+  if (doit(NULL, NULL) != CE_None) {
+    NODE_THROW_LAST_CPLERR();
+    return;
+  }
+  info.GetReturnValue().Set(rval());
+#endif
+}
+
+/**
+ * Computes hillshade, slope, aspect, color relief, TRI, TPI or roughness
+ * values for a single window of a DEM band, straight into a TypedArray.
+ *
+ * The window is read with one pixel of padding on each side, so tiles
+ * computed separately join without seams. The pixels on the edges of the
+ * raster itself are computed only with `-compute_edges`. The array holds
+ * one value per pixel, or the pixel-interleaved RGB(A) bytes for `"color-relief"`.
+ *
+ * @example
+ * ```
+ * var tile = gdal.demWindow(band, 'hillshade', 256, 512, 256, 256, ['-z', '2']);```
+ *
+ * @throws Error
+ * @method demWindow
+ * @static
+ * @for gdal
+ * @param {gdal.RasterBand} source
+ * @param {String} mode `"hillshade"`, `"slope"`, `"aspect"`, `"color-relief"`, `"TRI"`, `"TPI"` or `"roughness"`
+ * @param {Integer} x
+ * @param {Integer} y
+ * @param {Integer} width
+ * @param {Integer} height
+ * @param {String[]} [args] The command-line arguments of gdaldem
+ * @param {String} [color_file] The color configuration file, required by `"color-relief"`
+ * @return {TypedArray} A `Uint8Array` for `"hillshade"` and `"color-relief"`, a `Float32Array` otherwise
+ */
+NAN_METHOD(Utils::demWindow) {
+  _do_dem_window(info, false);
+}
+
+/**
+ * Asynchronously computes hillshade, slope, aspect, color relief, TRI, TPI or roughness
+ * values for a single window of a DEM band, straight into a TypedArray.
+ *
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ * The operation can be aborted with an
+ * [AbortSignal](https://developer.mozilla.org/en-US/docs/Web/API/AbortSignal), the Promise is then
+ * rejected with an `AbortError`.
+ *
+ * @throws Error
+ * @method demWindowAsync
+ * @static
+ * @for gdal
+ * @param {gdal.RasterBand} source
+ * @param {String} mode `"hillshade"`, `"slope"`, `"aspect"`, `"color-relief"`, `"TRI"`, `"TPI"` or `"roughness"`
+ * @param {Integer} x
+ * @param {Integer} y
+ * @param {Integer} width
+ * @param {Integer} height
+ * @param {String[]} [args] The command-line arguments of gdaldem
+ * @param {String} [color_file] The color configuration file, required by `"color-relief"`
+ * @param {Object} [options]
+ * @param {AbortSignal} [options.signal] Aborts the operation when signaled
+ * @param {ProgressCb} [options.progress_cb] Called with the completion ratio, between 0 and 1
+ * @param {requestCallback<TypedArray>} [callback] Promisifiable callback, always the last parameter, can be
+ * specified even if certain optional parameters are omitted
+ * @return {Promise<TypedArray>}
+ */
+NAN_METHOD(Utils::demWindowAsync) {
+  _do_dem_window(info, true);
+}
+
+} // namespace node_gdal
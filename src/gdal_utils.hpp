@@ -0,0 +1,41 @@
+#ifndef __GDAL_UTILS_H__
+#define __GDAL_UTILS_H__
+
+// node
+#include <node.h>
+#include <node_object_wrap.h>
+
+// nan
+#include "nan-wrapper.h"
+
+// gdal
+#include <gdal_priv.h>
+
+using namespace v8;
+using namespace node;
+
+// Library versions of the command-line utilities from gdal_utils.h
+// https://gdal.org/api/gdal_utils.html
+
+namespace node_gdal {
+namespace Utils {
+
+void Initialize(Local<Object> target);
+
+NAN_METHOD(translate);
+NAN_METHOD(translateAsync);
+NAN_METHOD(warp);
+NAN_METHOD(warpAsync);
+NAN_METHOD(buildVRT);
+NAN_METHOD(buildVRTAsync);
+NAN_METHOD(vectorTranslate);
+NAN_METHOD(vectorTranslateAsync);
+NAN_METHOD(dem);
+NAN_METHOD(demAsync);
+NAN_METHOD(demWindow);
+NAN_METHOD(demWindowAsync);
+
+} // namespace Utils
+} // namespace node_gdal
+
+#endif
@@ -3,12 +3,25 @@
 #include "gdal_dataset.hpp"
 #include "gdal_spatial_reference.hpp"
 #include "utils/warp_options.hpp"
+#include "async/async_worker.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace node_gdal {
 
 void Warper::Initialize(Local<Object> target) {
   Nan::SetMethod(target, "reprojectImage", reprojectImage);
+  Nan::SetMethod(target, "reprojectImageAsync", reprojectImageAsync);
   Nan::SetMethod(target, "suggestedWarpOutput", suggestedWarpOutput);
+  Nan::SetMethod(target, "buildTilePyramid", buildTilePyramid);
+  Nan::SetMethod(target, "buildTilePyramidAsync", buildTilePyramidAsync);
 }
 
 /**
@@ -163,41 +176,15 @@ CPLErr GDALReprojectImageMulti(
 }
 
 /**
- * Reprojects a dataset.
- *
- * @throws Error
- * @method reprojectImage
- * @static
- * @for gdal
- * @param {object} options
- * @param {gdal.Dataset} options.src
- * @param {gdal.Dataset} options.dst
- * @param {gdal.SpatialReference} options.s_srs
- * @param {gdal.SpatialReference} options.t_srs
- * @param {String} [options.resampling] Resampling algorithm ({{#crossLink
- * "Constants (GRA)"}}available options{{/crossLink}})
- * @param {gdal.Geometry} [options.cutline] Must be in src dataset pixel
- * coordinates. Use CoordinateTransformation to convert between georeferenced
- * coordinates and pixel coordinates
- * @param {Integer[]} [options.srcBands]
- * @param {Integer[]} [options.dstBands]
- * @param {Integer} [options.srcAlphaBand]
- * @param {Integer} [options.dstAlphaBand]
- * @param {Number} [options.srcNodata]
- * @param {Number} [options.dstNodata]
- * @param {Integer} [options.memoryLimit]
- * @param {Number} [options.maxError]
- * @param {Boolean} [options.multi]
- * @param {string[]|object} [options.options] Warp options (see:
- * [reference](http://www.gdal.org/structGDALWarpOptions.html#a0ed77f9917bb96c7a9aabd73d4d06e08))
+ * Low level reprojection for both synchronous and asynchronous execution.
  */
-NAN_METHOD(Warper::reprojectImage) {
+static void _do_reprojectImage(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async) {
   Nan::HandleScope scope;
 
   Local<Object> obj;
   Local<Value> prop;
 
-  WarpOptions options;
+  std::shared_ptr<WarpOptions> options = std::make_shared<WarpOptions>();
   GDALWarpOptions *opts;
   std::string s_srs_str;
   std::string t_srs_str;
@@ -207,10 +194,10 @@ NAN_METHOD(Warper::reprojectImage) {
 
   NODE_ARG_OBJECT(0, "Warp options", obj);
 
-  if (options.parse(obj)) {
+  if (options->parse(obj)) {
     return; // error parsing options object
   } else {
-    opts = options.get();
+    opts = options->get();
   }
   if (!opts->hDstDS) {
     Nan::ThrowTypeError("dst Dataset must be provided");
@@ -231,38 +218,66 @@ NAN_METHOD(Warper::reprojectImage) {
     Nan::ThrowError("Error converting t_srs to WKT");
     return;
   }
-
-  CPLErr err;
-
-  if (options.useMultithreading()) {
-    err = GDALReprojectImageMulti(
-      opts->hSrcDS,
-      s_srs_wkt,
-      opts->hDstDS,
-      t_srs_wkt,
-      opts->eResampleAlg,
-      opts->dfWarpMemoryLimit,
-      maxError,
-      NULL,
-      NULL,
-      opts);
-  } else {
-    err = GDALReprojectImage(
-      opts->hSrcDS,
-      s_srs_wkt,
-      opts->hDstDS,
-      t_srs_wkt,
-      opts->eResampleAlg,
-      opts->dfWarpMemoryLimit,
-      maxError,
-      NULL,
-      NULL,
-      opts);
-  }
-
+  std::string s_wkt = s_srs_wkt;
+  std::string t_wkt = t_srs_wkt;
   CPLFree(s_srs_wkt);
   CPLFree(t_srs_wkt);
 
+  Local<Value> src_obj = Nan::Get(obj, Nan::New("src").ToLocalChecked()).ToLocalChecked();
+  Local<Value> dst_obj = Nan::Get(obj, Nan::New("dst").ToLocalChecked()).ToLocalChecked();
+  std::vector<uv_mutex_t *> locks = {
+    Nan::ObjectWrap::Unwrap<Dataset>(src_obj.As<Object>())->async_lock,
+    Nan::ObjectWrap::Unwrap<Dataset>(dst_obj.As<Object>())->async_lock};
+
+  AsyncGDALWorker::Job doit = [options, s_wkt, t_wkt, maxError, locks](
+                                GDALProgressFunc pfnProgress, void *pProgressArg) mutable {
+    GDALWarpOptions *opts = options->get();
+    CPLErr err;
+
+    AsyncGDALWorker::lock(locks);
+    if (options->useMultithreading()) {
+      err = GDALReprojectImageMulti(
+        opts->hSrcDS,
+        s_wkt.c_str(),
+        opts->hDstDS,
+        t_wkt.c_str(),
+        opts->eResampleAlg,
+        opts->dfWarpMemoryLimit,
+        maxError,
+        pfnProgress,
+        pProgressArg,
+        opts);
+    } else {
+      err = GDALReprojectImage(
+        opts->hSrcDS,
+        s_wkt.c_str(),
+        opts->hDstDS,
+        t_wkt.c_str(),
+        opts->eResampleAlg,
+        opts->dfWarpMemoryLimit,
+        maxError,
+        pfnProgress,
+        pProgressArg,
+        opts);
+    }
+    AsyncGDALWorker::unlock(locks);
+
+    return err;
+  };
+
+  if (async) {
+    Nan::Callback *callback, *progress_cb = NULL;
+    NODE_ARG_CB(3, "callback", callback);
+    NODE_ARG_CB_OPT(2, "progress_cb", progress_cb);
+    AsyncGDALWorker *worker = new AsyncGDALWorker(callback, "node-gdal:ReprojectImage", info[1], progress_cb, doit);
+    worker->persist(src_obj);
+    worker->persist(dst_obj);
+    if (opts->hCutline) worker->persist(Nan::Get(obj, Nan::New("cutline").ToLocalChecked()).ToLocalChecked());
+    Nan::AsyncQueueWorker(worker);
+    return;
+  }
+
+  CPLErr err = doit(NULL, NULL);
   if (err) {
     NODE_THROW_CPLERR(err);
     return;
@@ -271,6 +286,86 @@ NAN_METHOD(Warper::reprojectImage) {
   return;
 }
 
+/**
+ * Reprojects a dataset.
+ *
+ * @throws Error
+ * @method reprojectImage
+ * @static
+ * @for gdal
+ * @param {object} options
+ * @param {gdal.Dataset} options.src
+ * @param {gdal.Dataset} options.dst
+ * @param {gdal.SpatialReference} options.s_srs
+ * @param {gdal.SpatialReference} options.t_srs
+ * @param {String} [options.resampling] Resampling algorithm ({{#crossLink
+ * "Constants (GRA)"}}available options{{/crossLink}})
+ * @param {gdal.Geometry} [options.cutline] Must be in src dataset pixel
+ * coordinates. Use CoordinateTransformation to convert between georeferenced
+ * coordinates and pixel coordinates
+ * @param {Integer[]} [options.srcBands]
+ * @param {Integer[]} [options.dstBands]
+ * @param {Integer} [options.srcAlphaBand]
+ * @param {Integer} [options.dstAlphaBand]
+ * @param {Number} [options.srcNodata]
+ * @param {Number} [options.dstNodata]
+ * @param {Integer} [options.memoryLimit]
+ * @param {Number} [options.maxError]
+ * @param {Boolean} [options.multi] Overlap the I/O and the computation with ChunkAndWarpMulti
+ * @param {Integer|String} [options.numThreads] Number of threads of the warping kernel (`NUM_THREADS` warp option),
+ * `"ALL_CPUS"` to use all the available CPUs
+ * @param {string[]|object} [options.options] Warp options (see:
+ * [reference](http://www.gdal.org/structGDALWarpOptions.html#a0ed77f9917bb96c7a9aabd73d4d06e08))
+ */
+NAN_METHOD(Warper::reprojectImage) {
+  _do_reprojectImage(info, false);
+}
+
+/**
+ * Asynchronously reprojects a dataset.
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved on completion.
+ * The operation can be aborted with an
+ * [AbortSignal](https://developer.mozilla.org/en-US/docs/Web/API/AbortSignal), the Promise is then
+ * rejected with an `AbortError`.
+ *
+ * @throws Error
+ * @method reprojectImageAsync
+ * @static
+ * @for gdal
+ * @param {object} options
+ * @param {gdal.Dataset} options.src
+ * @param {gdal.Dataset} options.dst
+ * @param {gdal.SpatialReference} options.s_srs
+ * @param {gdal.SpatialReference} options.t_srs
+ * @param {String} [options.resampling] Resampling algorithm ({{#crossLink
+ * "Constants (GRA)"}}available options{{/crossLink}})
+ * @param {gdal.Geometry} [options.cutline] Must be in src dataset pixel
+ * coordinates. Use CoordinateTransformation to convert between georeferenced
+ * coordinates and pixel coordinates
+ * @param {Integer[]} [options.srcBands]
+ * @param {Integer[]} [options.dstBands]
+ * @param {Integer} [options.srcAlphaBand]
+ * @param {Integer} [options.dstAlphaBand]
+ * @param {Number} [options.srcNodata]
+ * @param {Number} [options.dstNodata]
+ * @param {Integer} [options.memoryLimit]
+ * @param {Number} [options.maxError]
+ * @param {Boolean} [options.multi] Overlap the I/O and the computation with ChunkAndWarpMulti
+ * @param {Integer|String} [options.numThreads] Number of threads of the warping kernel (`NUM_THREADS` warp option),
+ * `"ALL_CPUS"` to use all the available CPUs
+ * @param {string[]|object} [options.options] Warp options (see:
+ * [reference](http://www.gdal.org/structGDALWarpOptions.html#a0ed77f9917bb96c7a9aabd73d4d06e08))
+ * @param {AbortSignal} [options.signal] Aborts the operation when signaled
+ * @param {ProgressCb} [options.progress_cb] Called with the completion ratio, between 0 and 1
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter, can be specified even if
+ * certain optional parameters are omitted
+ * @return {Promise<void>}
+ */
+NAN_METHOD(Warper::reprojectImageAsync) {
+  _do_reprojectImage(info, true);
+}
+
 /**
  * Used to determine the bounds and resolution of the output virtual file which
  * should be large enough to include all the input image.
@@ -400,4 +495,587 @@ NAN_METHOD(Warper::suggestedWarpOutput) {
   info.GetReturnValue().Set(result);
 }
 
+// Web Mercator tiling scheme of the XYZ directories and the MBTiles files
+static const double MERCATOR_ORIGIN = 20037508.342789244;
+static const int TILE_SIZE = 256;
+// the tiles are warped by chunks of up to CHUNK_TILES x CHUNK_TILES tiles
+static const int CHUNK_TILES = 8;
+
+struct TileRange {
+  int x0, y0, x1, y1;
+};
+
+struct TileChunk {
+  int zoom;
+  int tx, ty;
+  int nx, ny;
+};
+
+struct TilePyramid {
+  std::string output;
+  bool mbtiles;
+  bool png;
+  std::string merc_wkt;
+  GDALResampleAlg resampling;
+  // the color bands, the tiles have an additional alpha band in PNG
+  std::vector<int> src_bands;
+  int src_alpha;
+  int out_bands;
+  // empty when the source has no nodata value
+  std::vector<double> src_nodata;
+  int min_zoom, max_zoom;
+};
+
+static double tileExtent(int zoom) {
+  return 2 * MERCATOR_ORIGIN / (double)(1 << zoom);
+}
+
+// the tiles at zoom covering the extent (xmin, ymin, xmax, ymax), y increases southwards
+static TileRange tileRange(const double *extent, int zoom) {
+  double size = tileExtent(zoom);
+  int last = (1 << zoom) - 1;
+  auto clamp = [last](double v) { return (int)std::min(std::max(v, 0.0), (double)last); };
+  TileRange range;
+  range.x0 = clamp(floor((extent[0] + MERCATOR_ORIGIN) / size));
+  range.x1 = std::max(range.x0, clamp(ceil((extent[2] + MERCATOR_ORIGIN) / size) - 1));
+  range.y0 = clamp(floor((MERCATOR_ORIGIN - extent[3]) / size));
+  range.y1 = std::max(range.y0, clamp(ceil((MERCATOR_ORIGIN - extent[1]) / size) - 1));
+  return range;
+}
+
+static const char *overviewResampling(GDALResampleAlg alg) {
+  switch (alg) {
+    case GRA_Bilinear: return "BILINEAR";
+    case GRA_Cubic: return "CUBIC";
+    case GRA_CubicSpline: return "CUBICSPLINE";
+    case GRA_Lanczos: return "LANCZOS";
+    case GRA_Average: return "AVERAGE";
+    case GRA_Mode: return "MODE";
+    default: return "NEAREST";
+  }
+}
+
+/*
+ * Warps a chunk of tiles into a new MEM dataset, NULL on error
+ */
+static GDALDataset *warpTileChunk(GDALDataset *src, const TilePyramid &pyramid, const TileChunk &chunk) {
+  GDALDriver *mem_driver = GetGDALDriverManager()->GetDriverByName("MEM");
+  if (!mem_driver) {
+    CPLError(CE_Failure, CPLE_AppDefined, "MEM driver is not available");
+    return NULL;
+  }
+  int width = chunk.nx * TILE_SIZE, height = chunk.ny * TILE_SIZE;
+  GDALDataset *dst = mem_driver->Create("", width, height, pyramid.out_bands, GDT_Byte, NULL);
+  if (!dst) return NULL;
+  double size = tileExtent(chunk.zoom);
+  double gt[6] = {
+    -MERCATOR_ORIGIN + chunk.tx * size, size / TILE_SIZE, 0, MERCATOR_ORIGIN - chunk.ty * size, 0, -size / TILE_SIZE};
+  dst->SetGeoTransform(gt);
+  dst->SetProjection(pyramid.merc_wkt.c_str());
+
+  void *transformer = GDALCreateGenImgProjTransformer(src, NULL, dst, pyramid.merc_wkt.c_str(), FALSE, 0, 1);
+  if (!transformer) {
+    GDALClose(dst);
+    return NULL;
+  }
+
+  GDALWarpOptions *options = GDALCreateWarpOptions();
+  options->hSrcDS = src;
+  options->hDstDS = dst;
+  options->eResampleAlg = pyramid.resampling;
+  options->pfnTransformer = GDALApproxTransform;
+  options->pTransformerArg = GDALCreateApproxTransformer(GDALGenImgProjTransform, transformer, 0.125);
+  options->nBandCount = (int)pyramid.src_bands.size();
+  options->panSrcBands = (int *)CPLMalloc(sizeof(int) * options->nBandCount);
+  options->panDstBands = (int *)CPLMalloc(sizeof(int) * options->nBandCount);
+  for (int i = 0; i < options->nBandCount; i++) {
+    options->panSrcBands[i] = pyramid.src_bands[i];
+    options->panDstBands[i] = i + 1;
+  }
+  options->nSrcAlphaBand = pyramid.src_alpha;
+  if (pyramid.png) options->nDstAlphaBand = pyramid.out_bands;
+  if (!pyramid.src_nodata.empty()) {
+    options->padfSrcNoDataReal = (double *)CPLMalloc(sizeof(double) * options->nBandCount);
+    options->padfSrcNoDataImag = (double *)CPLCalloc(options->nBandCount, sizeof(double));
+    for (int i = 0; i < options->nBandCount; i++) options->padfSrcNoDataReal[i] = pyramid.src_nodata[i];
+  }
+  options->papszWarpOptions = CSLSetNameValue(options->papszWarpOptions, "INIT_DEST", "0");
+
+  GDALWarpOperation operation;
+  CPLErr err = operation.Initialize(options);
+  if (err == CE_None) err = operation.ChunkAndWarpImage(0, 0, width, height);
+
+  GDALDestroyApproxTransformer(options->pTransformerArg);
+  GDALDestroyGenImgProjTransformer(transformer);
+  GDALDestroyWarpOptions(options);
+  if (err != CE_None) {
+    GDALClose(dst);
+    return NULL;
+  }
+  return dst;
+}
+
+/*
+ * Whether a pooled handle has the georeferencing of the main handle,
+ * the one reopened from the file does not see what was set in memory
+ */
+static bool sameGeoreferencing(GDALDataset *reader, bool has_gt, const double *gt, const std::string &wkt) {
+  double reader_gt[6];
+  bool reader_has_gt = reader->GetGeoTransform(reader_gt) == CE_None;
+  if (reader_has_gt != has_gt) return false;
+  if (has_gt)
+    for (int i = 0; i < 6; i++)
+      if (reader_gt[i] != gt[i]) return false;
+  const char *reader_wkt = reader->GetProjectionRef();
+  return wkt == (reader_wkt ? reader_wkt : "");
+}
+
+/*
+ * Encodes the tiles of a warped chunk in the z/x/y directory tree,
+ * the fully transparent tiles are skipped
+ */
+static bool writeTileFiles(GDALDataset *warped, const TilePyramid &pyramid, const TileChunk &chunk) {
+  GDALDriver *mem_driver = GetGDALDriverManager()->GetDriverByName("MEM");
+  GDALDriver *driver = GetGDALDriverManager()->GetDriverByName(pyramid.png ? "PNG" : "JPEG");
+  if (!mem_driver || !driver) {
+    CPLError(CE_Failure, CPLE_AppDefined, "%s driver is not available", pyramid.png ? "PNG" : "JPEG");
+    return false;
+  }
+  size_t plane = TILE_SIZE * TILE_SIZE;
+  std::vector<GByte> tile(plane * pyramid.out_bands);
+  for (int j = 0; j < chunk.ny; j++) {
+    for (int i = 0; i < chunk.nx; i++) {
+      CPLErr err = GDALDatasetRasterIO(
+        (GDALDatasetH)warped,
+        GF_Read,
+        i * TILE_SIZE,
+        j * TILE_SIZE,
+        TILE_SIZE,
+        TILE_SIZE,
+        tile.data(),
+        TILE_SIZE,
+        TILE_SIZE,
+        GDT_Byte,
+        pyramid.out_bands,
+        NULL,
+        0,
+        0,
+        0);
+      if (err != CE_None) return false;
+      if (pyramid.png) {
+        const GByte *alpha = tile.data() + plane * (pyramid.out_bands - 1);
+        if (std::all_of(alpha, alpha + plane, [](GByte a) { return a == 0; })) continue;
+      }
+
+      GDALDataset *mem = mem_driver->Create("", TILE_SIZE, TILE_SIZE, pyramid.out_bands, GDT_Byte, NULL);
+      if (!mem) return false;
+      err = GDALDatasetRasterIO(
+        (GDALDatasetH)mem,
+        GF_Write,
+        0,
+        0,
+        TILE_SIZE,
+        TILE_SIZE,
+        tile.data(),
+        TILE_SIZE,
+        TILE_SIZE,
+        GDT_Byte,
+        pyramid.out_bands,
+        NULL,
+        0,
+        0,
+        0);
+      GDALDataset *out = NULL;
+      if (err == CE_None) {
+        std::string path = pyramid.output + "/" + std::to_string(chunk.zoom) + "/" + std::to_string(chunk.tx + i) +
+          "/" + std::to_string(chunk.ty + j) + (pyramid.png ? ".png" : ".jpg");
+        out = driver->CreateCopy(path.c_str(), mem, FALSE, NULL, NULL, NULL);
+      }
+      GDALClose(mem);
+      if (!out) return false;
+      GDALClose(out);
+    }
+  }
+  return true;
+}
+
+/*
+ * Copies a warped chunk at its place in the MBTiles dataset
+ */
+static bool writeMBTilesChunk(
+  GDALDataset *warped,
+  const TilePyramid &pyramid,
+  const TileChunk &chunk,
+  const TileRange &origin,
+  GDALDataset *mbtiles,
+  std::mutex &mbtiles_lock) {
+  int width = chunk.nx * TILE_SIZE, height = chunk.ny * TILE_SIZE;
+  std::vector<GByte> data((size_t)width * height * pyramid.out_bands);
+  CPLErr err = GDALDatasetRasterIO(
+    (GDALDatasetH)warped,
+    GF_Read,
+    0,
+    0,
+    width,
+    height,
+    data.data(),
+    width,
+    height,
+    GDT_Byte,
+    pyramid.out_bands,
+    NULL,
+    0,
+    0,
+    0);
+  if (err != CE_None) return false;
+  std::lock_guard<std::mutex> guard(mbtiles_lock);
+  err = GDALDatasetRasterIO(
+    (GDALDatasetH)mbtiles,
+    GF_Write,
+    (chunk.tx - origin.x0) * TILE_SIZE,
+    (chunk.ty - origin.y0) * TILE_SIZE,
+    width,
+    height,
+    data.data(),
+    width,
+    height,
+    GDT_Byte,
+    pyramid.out_bands,
+    NULL,
+    0,
+    0,
+    0);
+  return err == CE_None;
+}
+
+/**
+ * Low level tile pyramid generation for both synchronous and asynchronous execution.
+ */
+static void _do_build_tile_pyramid(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async) {
+  Nan::HandleScope scope;
+
+  Dataset *ds;
+  Local<Object> obj;
+  std::shared_ptr<TilePyramid> pyramid = std::make_shared<TilePyramid>();
+  std::string format = "PNG";
+  int threads = 1;
+
+  NODE_ARG_WRAPPED(0, "src", Dataset, ds);
+  NODE_ARG_OBJECT(1, "options", obj);
+  pyramid->min_zoom = 0;
+  NODE_INT_FROM_OBJ_OPT(obj, "minZoom", pyramid->min_zoom);
+  NODE_INT_FROM_OBJ(obj, "maxZoom", pyramid->max_zoom);
+  NODE_STR_FROM_OBJ(obj, "output", pyramid->output);
+  NODE_STR_FROM_OBJ_OPT(obj, "format", format);
+  NODE_INT_FROM_OBJ_OPT(obj, "threads", threads);
+
+  GDALDataset *raw = ds->getDataset();
+  if (!raw) {
+    Nan::ThrowError("src dataset must be a raster dataset");
+    return;
+  }
+  if (pyramid->min_zoom < 0 || pyramid->max_zoom > 30 || pyramid->min_zoom > pyramid->max_zoom) {
+    Nan::ThrowRangeError("The zoom levels must verify 0 <= minZoom <= maxZoom <= 30");
+    return;
+  }
+  if (threads < 1) {
+    Nan::ThrowRangeError("threads must be a positive integer");
+    return;
+  }
+  if (format != "PNG" && format != "JPEG") {
+    Nan::ThrowError("format must be \"PNG\" or \"JPEG\"");
+    return;
+  }
+  pyramid->png = format == "PNG";
+  pyramid->mbtiles = EQUAL(CPLGetExtension(pyramid->output.c_str()), "mbtiles");
+
+  pyramid->resampling = GRA_Bilinear;
+  if (Nan::HasOwnProperty(obj, Nan::New("resampling").ToLocalChecked()).FromMaybe(false)) {
+    WarpOptions warp_options;
+    if (warp_options.parseResamplingAlg(Nan::Get(obj, Nan::New("resampling").ToLocalChecked()).ToLocalChecked()))
+      return; // error parsing the resampling algorithm
+    pyramid->resampling = warp_options.get()->eResampleAlg;
+  }
+
+  if (!raw->GetProjectionRef() || !*raw->GetProjectionRef()) {
+    Nan::ThrowError("src dataset has no spatial reference");
+    return;
+  }
+  OGRSpatialReference merc;
+  char *merc_wkt = NULL;
+  if (merc.importFromEPSG(3857) != OGRERR_NONE || merc.exportToWkt(&merc_wkt) != OGRERR_NONE) {
+    CPLFree(merc_wkt);
+    Nan::ThrowError("Failed creating the Web Mercator spatial reference");
+    return;
+  }
+  pyramid->merc_wkt = merc_wkt;
+  CPLFree(merc_wkt);
+
+  // an alpha band is either marked as such or the last band of a gray+alpha or RGBA dataset
+  int band_count = raw->GetRasterCount();
+  pyramid->src_alpha = 0;
+  for (int i = 1; i <= band_count; i++) {
+    GDALRasterBand *band = raw->GetRasterBand(i);
+    if (band->GetRasterDataType() != GDT_Byte) {
+      Nan::ThrowError("Tiles can only be built from Byte bands");
+      return;
+    }
+    if (band->GetColorInterpretation() == GCI_AlphaBand) pyramid->src_alpha = i;
+  }
+  if (!pyramid->src_alpha && (band_count == 2 || band_count == 4)) pyramid->src_alpha = band_count;
+  for (int i = 1; i <= band_count; i++)
+    if (i != pyramid->src_alpha) pyramid->src_bands.push_back(i);
+  if (pyramid->src_bands.size() != 1 && pyramid->src_bands.size() != 3) {
+    Nan::ThrowError("src dataset must have 1 (gray) or 3 (RGB) color bands");
+    return;
+  }
+  pyramid->out_bands = (int)pyramid->src_bands.size() + (pyramid->png ? 1 : 0);
+
+  bool has_nodata = false;
+  for (int b : pyramid->src_bands) {
+    int success;
+    double nodata = raw->GetRasterBand(b)->GetNoDataValue(&success);
+    pyramid->src_nodata.push_back(success ? nodata : -1.1e20);
+    if (success) has_nodata = true;
+  }
+  if (!has_nodata) pyramid->src_nodata.clear();
+
+  uv_mutex_t *async_lock = ds->async_lock;
+  std::shared_ptr<ReaderPool> reader_pool = ds->reader_pool;
+
+  AsyncGDALWorker::Job doit = [raw, async_lock, reader_pool, pyramid, threads](
+                                GDALProgressFunc pfnProgress, void *pProgressArg) {
+    // the extent of the source in Web Mercator
+    uv_mutex_lock(async_lock);
+    double src_gt[6];
+    bool src_has_gt = raw->GetGeoTransform(src_gt) == CE_None;
+    const char *src_wkt = raw->GetProjectionRef();
+    std::string src_srs = src_wkt ? src_wkt : "";
+    void *transformer = GDALCreateGenImgProjTransformer(raw, NULL, NULL, pyramid->merc_wkt.c_str(), FALSE, 0, 1);
+    double gt[6], extent[4];
+    int w, h;
+    CPLErr err = transformer
+      ? GDALSuggestedWarpOutput2(raw, GDALGenImgProjTransform, transformer, gt, &w, &h, extent, 0)
+      : CE_Failure;
+    if (transformer) GDALDestroyGenImgProjTransformer(transformer);
+    uv_mutex_unlock(async_lock);
+    if (err != CE_None) return err;
+
+    // the directory tree is built by the XYZ scheme, an MBTiles file gets the maximum zoom level
+    // and the lower ones are its overviews
+    std::vector<TileChunk> chunks;
+    std::vector<TileRange> ranges;
+    for (int z = pyramid->mbtiles ? pyramid->max_zoom : pyramid->min_zoom; z <= pyramid->max_zoom; z++) {
+      TileRange range = tileRange(extent, z);
+      ranges.push_back(range);
+      for (int ty = range.y0; ty <= range.y1; ty += CHUNK_TILES) {
+        for (int tx = range.x0; tx <= range.x1; tx += CHUNK_TILES) {
+          TileChunk chunk = {
+            z, tx, ty, std::min(CHUNK_TILES, range.x1 - tx + 1), std::min(CHUNK_TILES, range.y1 - ty + 1)};
+          chunks.push_back(chunk);
+        }
+      }
+    }
+
+    GDALDataset *mbtiles = NULL;
+    TileRange origin = ranges.back();
+    if (pyramid->mbtiles) {
+      GDALDriver *driver = GetGDALDriverManager()->GetDriverByName("MBTiles");
+      if (!driver) {
+        CPLError(CE_Failure, CPLE_AppDefined, "MBTiles driver is not available");
+        return CE_Failure;
+      }
+      GIntBig width = (GIntBig)(origin.x1 - origin.x0 + 1) * TILE_SIZE;
+      GIntBig height = (GIntBig)(origin.y1 - origin.y0 + 1) * TILE_SIZE;
+      if (width > INT_MAX || height > INT_MAX) {
+        CPLError(CE_Failure, CPLE_AppDefined, "The MBTiles dataset is too large at zoom level %d", pyramid->max_zoom);
+        return CE_Failure;
+      }
+      std::string tile_format = std::string("TILE_FORMAT=") + (pyramid->png ? "PNG" : "JPEG");
+      const char *co[] = {tile_format.c_str(), NULL};
+      mbtiles = driver->Create(
+        pyramid->output.c_str(), (int)width, (int)height, pyramid->out_bands, GDT_Byte, const_cast<char **>(co));
+      if (!mbtiles) return CE_Failure;
+      double size = tileExtent(pyramid->max_zoom);
+      double mb_gt[6] = {
+        -MERCATOR_ORIGIN + origin.x0 * size, size / TILE_SIZE, 0, MERCATOR_ORIGIN - origin.y0 * size, 0,
+        -size / TILE_SIZE};
+      if (mbtiles->SetProjection(pyramid->merc_wkt.c_str()) != CE_None || mbtiles->SetGeoTransform(mb_gt) != CE_None) {
+        GDALClose(mbtiles);
+        return CE_Failure;
+      }
+    } else {
+      VSIMkdir(pyramid->output.c_str(), 0755);
+      for (size_t i = 0; i < ranges.size(); i++) {
+        std::string zoom_dir = pyramid->output + "/" + std::to_string(pyramid->min_zoom + i);
+        VSIMkdir(zoom_dir.c_str(), 0755);
+        for (int tx = ranges[i].x0; tx <= ranges[i].x1; tx++)
+          VSIMkdir((zoom_dir + "/" + std::to_string(tx)).c_str(), 0755);
+      }
+    }
+
+    // the overviews of an MBTiles file are a quarter of the work
+    double warp_ratio = pyramid->mbtiles && pyramid->min_zoom < pyramid->max_zoom ? 0.75 : 1;
+    std::mutex err_lock, mbtiles_lock;
+    std::atomic<size_t> next(0), done(0);
+    std::atomic<bool> failed(false);
+    std::string err_msg;
+    size_t total = chunks.size();
+
+    auto scan = [&](bool report) {
+      // a read-only dataset is read through a pooled handle when one is available
+      GDALDataset *reader = reader_pool ? reader_pool->acquire() : NULL;
+      if (reader && !sameGeoreferencing(reader, src_has_gt, src_gt, src_srs)) {
+        reader_pool->release(reader);
+        reader = NULL;
+      }
+      size_t i;
+      while (!failed && (i = next++) < total) {
+        const TileChunk &chunk = chunks[i];
+        if (!reader) uv_mutex_lock(async_lock);
+        GDALDataset *warped = warpTileChunk(reader ? reader : raw, *pyramid, chunk);
+        if (!reader) uv_mutex_unlock(async_lock);
+        bool ok = warped &&
+          (mbtiles ? writeMBTilesChunk(warped, *pyramid, chunk, origin, mbtiles, mbtiles_lock)
+                   : writeTileFiles(warped, *pyramid, chunk));
+        if (warped) GDALClose(warped);
+        if (!ok) {
+          std::lock_guard<std::mutex> guard(err_lock);
+          if (!failed) err_msg = CPLGetLastErrorNo() ? CPLGetLastErrorMsg() : "Failed writing the tiles";
+          failed = true;
+        }
+        done++;
+        if (report && pfnProgress && !pfnProgress(warp_ratio * done / total, NULL, pProgressArg)) {
+          std::lock_guard<std::mutex> guard(err_lock);
+          if (!failed) err_msg = "User terminated";
+          failed = true;
+        }
+      }
+      if (reader) reader_pool->release(reader);
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads && (size_t)t < total; t++) workers.push_back(std::thread(scan, false));
+    scan(true);
+    for (std::thread &worker : workers) worker.join();
+    // the last chunks may have been completed by the other threads
+    if (!failed && pfnProgress && !pfnProgress(warp_ratio, NULL, pProgressArg)) {
+      err_msg = "User terminated";
+      failed = true;
+    }
+
+    if (failed) {
+      if (mbtiles) GDALClose(mbtiles);
+      // CPL errors are thread-local, the message of the failed thread is raised again in this one
+      CPLError(CE_Failure, CPLE_AppDefined, "%s", err_msg.c_str());
+      return CE_Failure;
+    }
+
+    err = CE_None;
+    if (mbtiles) {
+      std::vector<int> factors;
+      for (int z = pyramid->max_zoom - 1; z >= pyramid->min_zoom; z--) factors.push_back(1 << (pyramid->max_zoom - z));
+      if (!factors.empty()) {
+        void *scaled = pfnProgress ? GDALCreateScaledProgress(warp_ratio, 1, pfnProgress, pProgressArg) : NULL;
+        err = mbtiles->BuildOverviews(
+          overviewResampling(pyramid->resampling),
+          (int)factors.size(),
+          factors.data(),
+          0,
+          NULL,
+          scaled ? GDALScaledProgress : NULL,
+          scaled);
+        if (scaled) GDALDestroyScaledProgress(scaled);
+      }
+      GDALClose(mbtiles);
+    }
+    return err;
+  };
+
+  if (async) {
+    Nan::Callback *callback, *progress_cb = NULL;
+    NODE_ARG_CB(4, "callback", callback);
+    NODE_ARG_CB_OPT(3, "progress_cb", progress_cb);
+    AsyncGDALWorker *worker = new AsyncGDALWorker(callback, "node-gdal:BuildTilePyramid", info[2], progress_cb, doit);
+    worker->persist(info[0]);
+    Nan::AsyncQueueWorker(worker);
+    return;
+  }
+
+  CPLErr err = doit(NULL, NULL);
+  if (err) {
+    NODE_THROW_CPLERR(err);
+    return;
+  }
+}
+
+/**
+ * Builds a Web Mercator tile pyramid, either a directory of `z/x/y.png` (XYZ
+ * scheme) tiles or an MBTiles file when `output` ends with `.mbtiles`.
+ *
+ * Each zoom level is warped by chunks of 8x8 tiles distributed over `threads`
+ * threads, the source is read through independent handles when it is opened
+ * read-only. The fully transparent PNG tiles are not written. The lower zoom
+ * levels of an MBTiles file are built as its overviews.
+ *
+ * The source must have 1 (gray) or 3 (RGB) Byte bands and optionally an alpha band,
+ * a PNG tile has an additional alpha band.
+ *
+ * @example
+ * ```
+ * gdal.buildTilePyramid(gdal.open('ortho.tif'), {
+ *   minZoom: 10, maxZoom: 16, output: 'tiles', threads: 4
+ * });```
+ *
+ * @throws Error
+ * @method buildTilePyramid
+ * @static
+ * @for gdal
+ * @param {gdal.Dataset} src
+ * @param {Object} options
+ * @param {Integer} [options.minZoom=0]
+ * @param {Integer} options.maxZoom
+ * @param {String} options.output The directory or the `.mbtiles` file
+ * @param {String} [options.format="PNG"] `"PNG"` or `"JPEG"`
+ * @param {String} [options.resampling="Bilinear"] Resampling algorithm ({{#crossLink
+ * "Constants (GRA)"}}available options{{/crossLink}})
+ * @param {Integer} [options.threads=1] The number of threads
+ */
+NAN_METHOD(Warper::buildTilePyramid) {
+  _do_build_tile_pyramid(info, false);
+}
+
+/**
+ * Asynchronously builds a Web Mercator tile pyramid, either a directory of `z/x/y.png` (XYZ
+ * scheme) tiles or an MBTiles file when `output` ends with `.mbtiles`.
+ *
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved on completion.
+ * The operation can be aborted with an
+ * [AbortSignal](https://developer.mozilla.org/en-US/docs/Web/API/AbortSignal), the Promise is then
+ * rejected with an `AbortError`.
+ *
+ * @throws Error
+ * @method buildTilePyramidAsync
+ * @static
+ * @for gdal
+ * @param {gdal.Dataset} src
+ * @param {Object} options
+ * @param {Integer} [options.minZoom=0]
+ * @param {Integer} options.maxZoom
+ * @param {String} options.output The directory or the `.mbtiles` file
+ * @param {String} [options.format="PNG"] `"PNG"` or `"JPEG"`
+ * @param {String} [options.resampling="Bilinear"] Resampling algorithm ({{#crossLink
+ * "Constants (GRA)"}}available options{{/crossLink}})
+ * @param {Integer} [options.threads=1] The number of threads
+ * @param {AbortSignal} [options.signal] Aborts the operation when signaled
+ * @param {ProgressCb} [options.progress_cb] Called with the completion ratio, between 0 and 1
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter, can be specified even if
+ * certain optional parameters are omitted
+ * @return {Promise<void>}
+ */
+NAN_METHOD(Warper::buildTilePyramidAsync) {
+  _do_build_tile_pyramid(info, true);
+}
+
 } // namespace node_gdal
@@ -27,7 +27,10 @@ namespace Warper {
 void Initialize(Local<Object> target);
 
 NAN_METHOD(reprojectImage);
+NAN_METHOD(reprojectImageAsync);
 NAN_METHOD(suggestedWarpOutput);
+NAN_METHOD(buildTilePyramid);
+NAN_METHOD(buildTilePyramidAsync);
 
 } // namespace Warper
 } // namespace node_gdal
@@ -39,6 +39,7 @@
 #include "gdal_dataset.hpp"
 #include "gdal_driver.hpp"
 #include "gdal_rasterband.hpp"
+#include "gdal_utils.hpp"
 #include "gdal_warper.hpp"
 
 #include "gdal_coordinate_transformation.hpp"
@@ -55,6 +56,7 @@
 #include "gdal_multipolygon.hpp"
 #include "gdal_point.hpp"
 #include "gdal_polygon.hpp"
+#include "gdal_prepared_geometry.hpp"
 #include "gdal_spatial_reference.hpp"
 
 #include "gdal.hpp"
@@ -212,6 +214,8 @@ static void Init(Local<Object> target, Local<v8::Value>, void *) {
 
   Nan::SetMethod(target, "open", open);
   Nan::SetMethod(target, "openAsync", openAsync);
+  Nan::SetMethod(target, "openBuffer", openBuffer);
+  Nan::SetMethod(target, "openBufferAsync", openBufferAsync);
   Nan::SetMethod(target, "setConfigOption", setConfigOption);
   Nan::SetMethod(target, "getConfigOption", getConfigOption);
   Nan::SetMethod(target, "decToDMS", decToDMS);
@@ -220,6 +224,7 @@ static void Init(Local<Object> target, Local<v8::Value>, void *) {
 
   Warper::Initialize(target);
   Algorithms::Initialize(target);
+  Utils::Initialize(target);
 
   Driver::Initialize(target);
   Dataset::Initialize(target);
@@ -240,6 +245,7 @@ static void Init(Local<Object> target, Local<v8::Value>, void *) {
   MultiPolygon::Initialize(target);
   SpatialReference::Initialize(target);
   CoordinateTransformation::Initialize(target);
+  PreparedGeometry::Initialize(target);
 
   DatasetBands::Initialize(target);
   DatasetLayers::Initialize(target);
@@ -9,7 +9,7 @@
 // nan
 #include "../nan-wrapper.h"
 
-#include <map>
+#include <unordered_map>
 
 #include "../gdal_common.hpp"
 
@@ -54,8 +54,8 @@ template <typename K, typename W> class ObjectCache {
   static void cacheWeakCallback(const Nan::WeakCallbackInfo<ObjectCacheItem<K>> &data);
   ObjectCacheItem<K> *getItem(K *key);
   void erase(ObjectCacheItem<K> *key);
-  std::map<K *, ObjectCacheItem<K> *> cache;
-  std::map<K *, K *> aliases;
+  std::unordered_map<K *, ObjectCacheItem<K> *> cache;
+  std::unordered_map<K *, K *> aliases;
 };
 
 template <typename K, typename W> ObjectCache<K, W>::ObjectCache() : cache(), aliases() {
@@ -120,12 +120,19 @@ template <typename K, typename W> W *ObjectCache<K, W>::getWrapped(K *key) {
 template <typename K, typename W> ObjectCacheItem<K> *ObjectCache<K, W>::getItem(K *key) {
   // return handle to existing object if already wrapped
   // check by calling has() first
-  if (aliases.count(key) > 0) { key = aliases[key]; }
-  return cache[key];
+  auto it = cache.find(key);
+  if (it != cache.end()) return it->second;
+  return cache[aliases[key]];
 }
 
 template <typename K, typename W> void ObjectCache<K, W>::erase(K *key) {
-  if (has(key)) { erase(getItem(key)); }
+  auto it = cache.find(key);
+  if (it != cache.end()) {
+    erase(it->second);
+    return;
+  }
+  auto alias = aliases.find(key);
+  if (alias != aliases.end()) { erase(cache[alias->second]); }
 }
 
 template <typename K, typename W> void ObjectCache<K, W>::erase(ObjectCacheItem<K> *item) {
@@ -25,9 +25,7 @@ long PtrManager::add(OGRLayer *ptr, long parent_uid, bool is_result_set) {
   item->ptr = ptr;
   item->is_result_set = is_result_set;
   layers[item->uid] = item;
-
-  PtrManagerDatasetItem *parent = datasets[parent_uid];
-  parent->layers.push_back(item);
+  item->parent->layers.insert(item);
   return item->uid;
 }
 
@@ -37,21 +35,48 @@ long PtrManager::add(GDALRasterBand *ptr, long parent_uid) {
   item->parent = datasets[parent_uid];
   item->ptr = ptr;
   bands[item->uid] = item;
-
-  PtrManagerDatasetItem *parent = datasets[parent_uid];
-  parent->bands.push_back(item);
+  item->parent->bands.insert(item);
   return item->uid;
 }
 
-long PtrManager::add(GDALDataset *ptr, uv_mutex_t *async_lock) {
+long PtrManager::add(GDALDataset *ptr, uv_mutex_t *async_lock, std::shared_ptr<ReaderPool> reader_pool) {
   PtrManagerDatasetItem *item = new PtrManagerDatasetItem();
   item->uid = uid++;
   item->ptr = ptr;
   item->async_lock = async_lock;
+  item->reader_pool = reader_pool;
+  item->buffer = nullptr;
   datasets[item->uid] = item;
   return item->uid;
 }
 
+// the Buffer is kept alive until the dataset is disposed, then its file is deleted
+void PtrManager::attachBuffer(long uid, Local<Object> buffer, const std::string &filename) {
+  auto dataset = datasets.find(uid);
+  if (dataset == datasets.end()) return;
+  dataset->second->buffer = new Nan::Persistent<Object>(buffer);
+  dataset->second->buffer_file = filename;
+}
+
+// the dataset uid references the dataset source_uid, it is disposed when the source is
+void PtrManager::addDependency(long uid, long source_uid) {
+  auto dataset = datasets.find(uid);
+  auto source = datasets.find(source_uid);
+  if (dataset == datasets.end() || source == datasets.end()) return;
+  dataset->second->sources.insert(source->second);
+  source->second->dependents.insert(dataset->second);
+}
+
+// the dataset uses the async_lock of its sources from now on, its own lock is destroyed,
+// the shared lock outlives it since the sources dispose their dependents first
+void PtrManager::shareLock(long uid) {
+  auto dataset = datasets.find(uid);
+  if (dataset == datasets.end() || !dataset->second->async_lock) return;
+  uv_mutex_destroy(dataset->second->async_lock);
+  delete dataset->second->async_lock;
+  dataset->second->async_lock = nullptr;
+}
+
 #if GDAL_VERSION_MAJOR < 2
 long PtrManager::add(OGRDataSource *ptr) {
   PtrManagerDatasetItem *item = new PtrManagerDatasetItem();
@@ -63,19 +88,27 @@ long PtrManager::add(OGRDataSource *ptr) {
 #endif
 
 void PtrManager::dispose(long uid) {
-  if (datasets.count(uid))
-    dispose(datasets[uid]);
-  else if (layers.count(uid))
-    dispose(layers[uid]);
-  else if (bands.count(uid))
-    dispose(bands[uid]);
+  auto dataset = datasets.find(uid);
+  if (dataset != datasets.end()) {
+    dispose(dataset->second);
+    return;
+  }
+  auto layer = layers.find(uid);
+  if (layer != layers.end()) {
+    dispose(layer->second);
+    return;
+  }
+  auto band = bands.find(uid);
+  if (band != bands.end()) dispose(band->second);
 }
 
 void PtrManager::dispose(PtrManagerDatasetItem *item) {
   datasets.erase(item->uid);
 
-  while (!item->layers.empty()) { dispose(item->layers.back()); }
-  while (!item->bands.empty()) { dispose(item->bands.back()); }
+  while (!item->dependents.empty()) { dispose(*item->dependents.begin()); }
+  for (PtrManagerDatasetItem *source : item->sources) source->dependents.erase(item);
+  while (!item->layers.empty()) { dispose(*item->layers.begin()); }
+  while (!item->bands.empty()) { dispose(*item->bands.begin()); }
 
 #if GDAL_VERSION_MAJOR < 2
   if (item->ptr_datasource) {
@@ -83,6 +116,12 @@ void PtrManager::dispose(PtrManagerDatasetItem *item) {
     OGRDataSource::DestroyDataSource(item->ptr_datasource);
   }
 #endif
+  // the async operations still running keep the pool alive
+  // and close their handles when releasing them
+  if (item->reader_pool) {
+    item->reader_pool->close();
+    item->reader_pool.reset();
+  }
   if (item->async_lock) {
     uv_mutex_destroy(item->async_lock);
     delete item->async_lock;
@@ -91,6 +130,11 @@ void PtrManager::dispose(PtrManagerDatasetItem *item) {
     Dataset::dataset_cache.erase(item->ptr);
     GDALClose(item->ptr);
   }
+  if (item->buffer) {
+    VSIUnlink(item->buffer_file.c_str());
+    item->buffer->Reset();
+    delete item->buffer;
+  }
 
   delete item;
 }
@@ -98,14 +142,14 @@ void PtrManager::dispose(PtrManagerDatasetItem *item) {
 void PtrManager::dispose(PtrManagerRasterBandItem *item) {
   RasterBand::cache.erase(item->ptr);
   bands.erase(item->uid);
-  item->parent->bands.remove(item);
+  item->parent->bands.erase(item);
   delete item;
 }
 
 void PtrManager::dispose(PtrManagerLayerItem *item) {
   Layer::cache.erase(item->ptr);
   layers.erase(item->uid);
-  item->parent->layers.remove(item);
+  item->parent->layers.erase(item);
 
 #if GDAL_VERSION_MAJOR < 2
   OGRDataSource *parent_ds = item->parent->ptr_datasource;
@@ -14,8 +14,12 @@
 // ogr
 #include <ogrsf_frmts.h>
 
-#include <list>
-#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "reader_pool.hpp"
 
 using namespace v8;
 
@@ -35,10 +39,17 @@ struct PtrManagerRasterBandItem {
 
 struct PtrManagerDatasetItem {
   long uid;
-  std::list<PtrManagerLayerItem *> layers;
-  std::list<PtrManagerRasterBandItem *> bands;
+  std::unordered_set<PtrManagerLayerItem *> layers;
+  std::unordered_set<PtrManagerRasterBandItem *> bands;
+  // a VRT reads its sources through their GDALDataset, it is disposed before them
+  std::unordered_set<PtrManagerDatasetItem *> dependents;
+  std::unordered_set<PtrManagerDatasetItem *> sources;
   GDALDataset *ptr;
   uv_mutex_t *async_lock;
+  std::shared_ptr<node_gdal::ReaderPool> reader_pool;
+  // the Buffer behind the /vsimem/ file of a dataset opened by gdal.openBuffer
+  Nan::Persistent<Object> *buffer;
+  std::string buffer_file;
 #if GDAL_VERSION_MAJOR < 2
   OGRDataSource *ptr_datasource;
 #endif
@@ -50,12 +61,15 @@ namespace node_gdal {
 
 class PtrManager {
     public:
-  long add(GDALDataset *ptr, uv_mutex_t *async_lock);
+  long add(GDALDataset *ptr, uv_mutex_t *async_lock, std::shared_ptr<ReaderPool> reader_pool = nullptr);
 #if GDAL_VERSION_MAJOR < 2
   long add(OGRDataSource *ptr);
 #endif
   long add(GDALRasterBand *ptr, long parent_uid);
   long add(OGRLayer *ptr, long parent_uid, bool is_result_set);
+  void attachBuffer(long uid, Local<Object> buffer, const std::string &filename);
+  void addDependency(long uid, long source_uid);
+  void shareLock(long uid);
   void dispose(long uid);
   bool isAlive(long uid);
 
@@ -67,9 +81,9 @@ class PtrManager {
   void dispose(PtrManagerLayerItem *item);
   void dispose(PtrManagerRasterBandItem *item);
   void dispose(PtrManagerDatasetItem *item);
-  std::map<long, PtrManagerLayerItem *> layers;
-  std::map<long, PtrManagerRasterBandItem *> bands;
-  std::map<long, PtrManagerDatasetItem *> datasets;
+  std::unordered_map<long, PtrManagerLayerItem *> layers;
+  std::unordered_map<long, PtrManagerRasterBandItem *> bands;
+  std::unordered_map<long, PtrManagerDatasetItem *> datasets;
 };
 
 } // namespace node_gdal
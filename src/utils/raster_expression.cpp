@@ -0,0 +1,416 @@
+#include "raster_expression.hpp"
+
+#include <cpl_conv.h>
+
+#include <algorithm>
+#include <ctype.h>
+#include <cmath>
+#include <string.h>
+
+namespace node_gdal {
+
+struct ExpressionFunction {
+  const char *name;
+  RasterExpression::Op op;
+  int arity;
+};
+
+static const ExpressionFunction functions[] = {
+  {"where", RasterExpression::WHERE, 3}, {"abs", RasterExpression::ABS, 1},
+  {"sqrt", RasterExpression::SQRT, 1},   {"exp", RasterExpression::EXP, 1},
+  {"log", RasterExpression::LOG, 1},     {"log10", RasterExpression::LOG10, 1},
+  {"sin", RasterExpression::SIN, 1},     {"cos", RasterExpression::COS, 1},
+  {"tan", RasterExpression::TAN, 1},     {"asin", RasterExpression::ASIN, 1},
+  {"acos", RasterExpression::ACOS, 1},   {"atan", RasterExpression::ATAN, 1},
+  {"atan2", RasterExpression::ATAN2, 2}, {"floor", RasterExpression::FLOOR, 1},
+  {"ceil", RasterExpression::CEIL, 1},   {"round", RasterExpression::ROUND, 1},
+  {"min", RasterExpression::MIN, 2},     {"max", RasterExpression::MAX, 2},
+  {"pow", RasterExpression::POW, 2},     {"isnan", RasterExpression::ISNAN, 1}};
+
+#define UNARY(expr)                                                                                                    \
+  for (size_t i = 0; i < n; i++) {                                                                                     \
+    double x = a[i];                                                                                                   \
+    out[i] = (expr);                                                                                                   \
+  }                                                                                                                    \
+  break;
+
+#define BINARY(expr)                                                                                                   \
+  for (size_t i = 0; i < n; i++) {                                                                                     \
+    double x = a[i], y = b[i];                                                                                         \
+    out[i] = (expr);                                                                                                   \
+  }                                                                                                                    \
+  break;
+
+// applies one operation to n values, each case is a separate branch-free loop
+static void
+apply(RasterExpression::Op op, size_t n, double *out, const double *a, const double *b, const double *c, double value) {
+  switch (op) {
+    case RasterExpression::CONST: std::fill(out, out + n, value); break;
+    case RasterExpression::ADD: BINARY(x + y);
+    case RasterExpression::SUB: BINARY(x - y);
+    case RasterExpression::MUL: BINARY(x * y);
+    case RasterExpression::DIV: BINARY(x / y);
+    case RasterExpression::MOD: BINARY(fmod(x, y));
+    case RasterExpression::POW: BINARY(pow(x, y));
+    case RasterExpression::NEG: UNARY(-x);
+    case RasterExpression::NOT: UNARY(x == 0 ? 1.0 : 0.0);
+    case RasterExpression::LT: BINARY(x < y ? 1.0 : 0.0);
+    case RasterExpression::LE: BINARY(x <= y ? 1.0 : 0.0);
+    case RasterExpression::GT: BINARY(x > y ? 1.0 : 0.0);
+    case RasterExpression::GE: BINARY(x >= y ? 1.0 : 0.0);
+    case RasterExpression::EQ: BINARY(x == y ? 1.0 : 0.0);
+    case RasterExpression::NE: BINARY(x != y ? 1.0 : 0.0);
+    case RasterExpression::AND: BINARY((x != 0) & (y != 0) ? 1.0 : 0.0);
+    case RasterExpression::OR: BINARY((x != 0) | (y != 0) ? 1.0 : 0.0);
+    case RasterExpression::WHERE:
+      for (size_t i = 0; i < n; i++) out[i] = a[i] != 0 ? b[i] : c[i];
+      break;
+    case RasterExpression::ABS: UNARY(fabs(x));
+    case RasterExpression::SQRT: UNARY(sqrt(x));
+    case RasterExpression::EXP: UNARY(exp(x));
+    case RasterExpression::LOG: UNARY(log(x));
+    case RasterExpression::LOG10: UNARY(log10(x));
+    case RasterExpression::SIN: UNARY(sin(x));
+    case RasterExpression::COS: UNARY(cos(x));
+    case RasterExpression::TAN: UNARY(tan(x));
+    case RasterExpression::ASIN: UNARY(asin(x));
+    case RasterExpression::ACOS: UNARY(acos(x));
+    case RasterExpression::ATAN: UNARY(atan(x));
+    case RasterExpression::ATAN2: BINARY(atan2(x, y));
+    case RasterExpression::FLOOR: UNARY(floor(x));
+    case RasterExpression::CEIL: UNARY(ceil(x));
+    case RasterExpression::ROUND: UNARY(round(x));
+    case RasterExpression::MIN: BINARY(x < y ? x : y);
+    case RasterExpression::MAX: BINARY(x > y ? x : y);
+    case RasterExpression::ISNAN: UNARY(std::isnan(x) ? 1.0 : 0.0);
+  }
+}
+
+#undef UNARY
+#undef BINARY
+
+// Recursive descent parser emitting the instructions while parsing
+class ExpressionParser {
+    public:
+  struct Operand {
+    bool is_const;
+    double value;
+    int slot;
+  };
+
+  ExpressionParser(
+    const std::string &text, const std::vector<std::string> &variables, double nodata, RasterExpression *expr)
+    : text(text), pos(0), variables(variables), nodata(nodata), expr(expr) {
+  }
+
+  bool parse(Operand &result) {
+    if (!parseOr(result)) return false;
+    skipSpaces();
+    if (pos < text.size()) return fail("Unexpected character");
+    return true;
+  }
+
+  std::string error;
+
+    private:
+  const std::string &text;
+  size_t pos;
+  const std::vector<std::string> &variables;
+  double nodata;
+  RasterExpression *expr;
+
+  bool fail(const char *msg) {
+    error = std::string(msg) + " at position " + std::to_string(pos) + " in expression";
+    return false;
+  }
+
+  void skipSpaces() {
+    while (pos < text.size() && isspace((unsigned char)text[pos])) pos++;
+  }
+
+  bool accept(const char *token) {
+    skipSpaces();
+    size_t len = strlen(token);
+    if (text.compare(pos, len, token) != 0) return false;
+    pos += len;
+    return true;
+  }
+
+  int newRegister() {
+    return (int)(expr->num_variables + expr->num_registers++);
+  }
+
+  Operand constant(double value) {
+    Operand r = {true, value, -1};
+    return r;
+  }
+
+  Operand emit(RasterExpression::Op op, int arity, Operand *args) {
+    bool all_const = true;
+    for (int i = 0; i < arity; i++) all_const = all_const && args[i].is_const;
+    if (all_const) {
+      double v[3] = {0, 0, 0}, result;
+      for (int i = 0; i < arity; i++) v[i] = args[i].value;
+      apply(op, 1, &result, &v[0], &v[1], &v[2], 0);
+      return constant(result);
+    }
+
+    RasterExpression::Instruction ins = {op, 0, {0, 0, 0}, 0};
+    for (int i = 0; i < arity; i++) {
+      if (args[i].is_const) {
+        RasterExpression::Instruction fill = {RasterExpression::CONST, newRegister(), {0, 0, 0}, args[i].value};
+        expr->instructions.push_back(fill);
+        ins.args[i] = fill.dst;
+      } else {
+        ins.args[i] = args[i].slot;
+      }
+    }
+    ins.dst = newRegister();
+    expr->instructions.push_back(ins);
+    Operand r = {false, 0, ins.dst};
+    return r;
+  }
+
+  Operand emit(RasterExpression::Op op, Operand a, Operand b) {
+    Operand args[2] = {a, b};
+    return emit(op, 2, args);
+  }
+
+  bool parseOr(Operand &r) {
+    if (!parseAnd(r)) return false;
+    Operand rhs;
+    while (accept("||")) {
+      if (!parseAnd(rhs)) return false;
+      r = emit(RasterExpression::OR, r, rhs);
+    }
+    return true;
+  }
+
+  bool parseAnd(Operand &r) {
+    if (!parseEquality(r)) return false;
+    Operand rhs;
+    while (accept("&&")) {
+      if (!parseEquality(rhs)) return false;
+      r = emit(RasterExpression::AND, r, rhs);
+    }
+    return true;
+  }
+
+  bool parseEquality(Operand &r) {
+    if (!parseRelational(r)) return false;
+    Operand rhs;
+    for (;;) {
+      RasterExpression::Op op;
+      if (accept("=="))
+        op = RasterExpression::EQ;
+      else if (accept("!="))
+        op = RasterExpression::NE;
+      else
+        return true;
+      if (!parseRelational(rhs)) return false;
+      r = emit(op, r, rhs);
+    }
+  }
+
+  bool parseRelational(Operand &r) {
+    if (!parseAdditive(r)) return false;
+    Operand rhs;
+    for (;;) {
+      RasterExpression::Op op;
+      if (accept("<="))
+        op = RasterExpression::LE;
+      else if (accept(">="))
+        op = RasterExpression::GE;
+      else if (accept("<"))
+        op = RasterExpression::LT;
+      else if (accept(">"))
+        op = RasterExpression::GT;
+      else
+        return true;
+      if (!parseAdditive(rhs)) return false;
+      r = emit(op, r, rhs);
+    }
+  }
+
+  bool parseAdditive(Operand &r) {
+    if (!parseMultiplicative(r)) return false;
+    Operand rhs;
+    for (;;) {
+      RasterExpression::Op op;
+      if (accept("+"))
+        op = RasterExpression::ADD;
+      else if (accept("-"))
+        op = RasterExpression::SUB;
+      else
+        return true;
+      if (!parseMultiplicative(rhs)) return false;
+      r = emit(op, r, rhs);
+    }
+  }
+
+  bool parseMultiplicative(Operand &r) {
+    if (!parseUnary(r)) return false;
+    Operand rhs;
+    for (;;) {
+      RasterExpression::Op op;
+      if (accept("*"))
+        op = RasterExpression::MUL;
+      else if (accept("/"))
+        op = RasterExpression::DIV;
+      else if (accept("%"))
+        op = RasterExpression::MOD;
+      else
+        return true;
+      if (!parseUnary(rhs)) return false;
+      r = emit(op, r, rhs);
+    }
+  }
+
+  bool parseUnary(Operand &r) {
+    if (accept("-")) {
+      if (!parseUnary(r)) return false;
+      r = emit(RasterExpression::NEG, 1, &r);
+      return true;
+    }
+    if (accept("+")) return parseUnary(r);
+    if (accept("!")) {
+      if (!parseUnary(r)) return false;
+      r = emit(RasterExpression::NOT, 1, &r);
+      return true;
+    }
+    return parsePower(r);
+  }
+
+  // right associative and binding tighter than the unary operators: -a^b is -(a^b)
+  bool parsePower(Operand &r) {
+    if (!parsePrimary(r)) return false;
+    if (accept("^")) {
+      Operand rhs;
+      if (!parseUnary(rhs)) return false;
+      r = emit(RasterExpression::POW, r, rhs);
+    }
+    return true;
+  }
+
+  bool parsePrimary(Operand &r) {
+    skipSpaces();
+    if (pos >= text.size()) return fail("Unexpected end");
+
+    if (accept("(")) {
+      if (!parseOr(r)) return false;
+      if (!accept(")")) return fail("Expected ')'");
+      return true;
+    }
+
+    char c = text[pos];
+    if (isdigit((unsigned char)c) || c == '.') {
+      char *end;
+      double value = CPLStrtod(text.c_str() + pos, &end);
+      if (end == text.c_str() + pos) return fail("Invalid number");
+      pos = end - text.c_str();
+      r = constant(value);
+      return true;
+    }
+
+    if (!isalpha((unsigned char)c) && c != '_') return fail("Unexpected character");
+    size_t start = pos;
+    while (pos < text.size() && (isalnum((unsigned char)text[pos]) || text[pos] == '_')) pos++;
+    std::string name = text.substr(start, pos - start);
+
+    if (accept("(")) return parseCall(name, start, r);
+
+    for (size_t i = 0; i < variables.size(); i++) {
+      if (variables[i] == name) {
+        r.is_const = false;
+        r.slot = (int)i;
+        return true;
+      }
+    }
+    if (name == "nodata") {
+      r = constant(nodata);
+      return true;
+    }
+    if (name == "pi") {
+      r = constant(3.14159265358979323846);
+      return true;
+    }
+    pos = start;
+    error = "Unknown variable '" + name + "' at position " + std::to_string(pos) + " in expression";
+    return false;
+  }
+
+  bool parseCall(const std::string &name, size_t start, Operand &r) {
+    const ExpressionFunction *fn = NULL;
+    for (const ExpressionFunction &f : functions) {
+      if (name == f.name) fn = &f;
+    }
+    if (!fn) {
+      pos = start;
+      error = "Unknown function '" + name + "' at position " + std::to_string(pos) + " in expression";
+      return false;
+    }
+
+    Operand args[3];
+    int arity = 0;
+    if (!accept(")")) {
+      do {
+        if (arity == fn->arity) return fail("Too many arguments");
+        if (!parseOr(args[arity++])) return false;
+      } while (accept(","));
+      if (!accept(")")) return fail("Expected ')'");
+    }
+    if (arity != fn->arity) {
+      pos = start;
+      error = std::string(fn->name) + "() expects " + std::to_string(fn->arity) + " arguments";
+      return false;
+    }
+    r = emit(fn->op, arity, args);
+    return true;
+  }
+};
+
+RasterExpression *RasterExpression::compile(
+  const std::string &expression, const std::vector<std::string> &variables, double nodata, std::string &error) {
+  RasterExpression *expr = new RasterExpression();
+  expr->num_variables = variables.size();
+
+  ExpressionParser parser(expression, variables, nodata, expr);
+  ExpressionParser::Operand result;
+  if (!parser.parse(result)) {
+    error = parser.error;
+    delete expr;
+    return NULL;
+  }
+
+  if (result.is_const) {
+    expr->result_slot = -1;
+    expr->constant = result.value;
+  } else {
+    expr->result_slot = result.slot;
+  }
+  return expr;
+}
+
+void RasterExpression::evaluate(const double *const *inputs, size_t n, double *scratch, double *result) const {
+  if (result_slot < 0) {
+    std::fill(result, result + n, constant);
+    return;
+  }
+
+#define SLOT(s) ((size_t)(s) < num_variables ? inputs[s] : scratch + ((s)-num_variables) * CHUNK_SIZE)
+  for (const Instruction &ins : instructions) {
+    apply(
+      ins.op,
+      n,
+      const_cast<double *>(SLOT(ins.dst)),
+      SLOT(ins.args[0]),
+      SLOT(ins.args[1]),
+      SLOT(ins.args[2]),
+      ins.value);
+  }
+  const double *r = SLOT(result_slot);
+#undef SLOT
+  std::copy(r, r + n, result);
+}
+
+} // namespace node_gdal
@@ -0,0 +1,103 @@
+#ifndef __RASTER_EXPRESSION_H__
+#define __RASTER_EXPRESSION_H__
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+namespace node_gdal {
+
+// A compiled pixel-wise arithmetic expression
+//
+// The expression is parsed once into a flat list of instructions, each one
+// applying a single operation to a whole chunk of pixels: the inner loops
+// have no branches on the operation and are vectorized by the compiler.
+//
+// The operands of an instruction are slots, the first ones being the input
+// variables, followed by the registers holding the intermediate results.
+// Constant subexpressions are folded at compile time.
+//
+// Supported syntax: numbers, the variables, `nodata`, `pi`,
+// + - * / % ^ (power), unary - and !, < <= > >= == !=, && ||, parentheses
+// and the functions listed in raster_expression.cpp (where(cond, a, b), ...).
+// Comparisons and logical operators return 1 or 0.
+
+class RasterExpression {
+    public:
+  static const size_t CHUNK_SIZE = 1024;
+
+  // returns NULL and sets error when the expression is invalid
+  static RasterExpression *
+  compile(const std::string &expression, const std::vector<std::string> &variables, double nodata, std::string &error);
+
+  // number of doubles of the scratch buffer passed to evaluate()
+  size_t scratchSize() const {
+    return num_registers * CHUNK_SIZE;
+  }
+
+  // evaluates n <= CHUNK_SIZE pixels, inputs holds one pointer per variable
+  void evaluate(const double *const *inputs, size_t n, double *scratch, double *result) const;
+
+  enum Op {
+    CONST,
+    ADD,
+    SUB,
+    MUL,
+    DIV,
+    MOD,
+    POW,
+    NEG,
+    NOT,
+    LT,
+    LE,
+    GT,
+    GE,
+    EQ,
+    NE,
+    AND,
+    OR,
+    WHERE,
+    ABS,
+    SQRT,
+    EXP,
+    LOG,
+    LOG10,
+    SIN,
+    COS,
+    TAN,
+    ASIN,
+    ACOS,
+    ATAN,
+    ATAN2,
+    FLOOR,
+    CEIL,
+    ROUND,
+    MIN,
+    MAX,
+    ISNAN
+  };
+
+  struct Instruction {
+    Op op;
+    int dst;
+    int args[3];
+    double value;
+  };
+
+    private:
+  RasterExpression() : num_variables(0), num_registers(0), result_slot(0), constant(0) {
+  }
+
+  size_t num_variables;
+  size_t num_registers;
+  std::vector<Instruction> instructions;
+  // slot of the result, -1 if the whole expression is the constant
+  int result_slot;
+  double constant;
+
+  friend class ExpressionParser;
+};
+
+} // namespace node_gdal
+
+#endif
@@ -0,0 +1,119 @@
+#include "reader_pool.hpp"
+
+#include <stdlib.h>
+
+namespace node_gdal {
+
+ReaderPool::ReaderPool(GDALDataset *ds, int max_size)
+  : filename(ds->GetDescription()),
+    driver(ds->GetDriver()->GetDescription()),
+    raster_x_size(ds->GetRasterXSize()),
+    raster_y_size(ds->GetRasterYSize()),
+    raster_count(ds->GetRasterCount()),
+    max_size(max_size),
+    open_count(0),
+    closed(false),
+    handles() {
+  uv_mutex_init(&lock);
+}
+
+ReaderPool::~ReaderPool() {
+  close();
+  uv_mutex_destroy(&lock);
+}
+
+/*
+ * Returns NULL if the dataset cannot be reopened by its name:
+ * datasets opened for update, in-memory datasets, vector datasets
+ */
+ReaderPool *ReaderPool::create(GDALDataset *ds) {
+#if GDAL_VERSION_MAJOR < 2
+  return NULL;
+#else
+  if (ds->GetAccess() != GA_ReadOnly || ds->GetRasterCount() == 0 || ds->GetDriver() == nullptr) return NULL;
+  const char *filename = ds->GetDescription();
+  if (filename == nullptr || *filename == '\0') return NULL;
+  if (EQUAL(ds->GetDriver()->GetDescription(), "MEM")) return NULL;
+
+  // libuv defaults to 4 threads
+  int max_size = 4;
+  const char *threadpool_size = getenv("UV_THREADPOOL_SIZE");
+  if (threadpool_size != nullptr && atoi(threadpool_size) > 0) max_size = atoi(threadpool_size);
+
+  return new ReaderPool(ds, max_size);
+#endif
+}
+
+/*
+ * Called from the worker threads
+ */
+GDALDataset *ReaderPool::acquire() {
+#if GDAL_VERSION_MAJOR < 2
+  return NULL;
+#else
+  uv_mutex_lock(&lock);
+  if (closed) {
+    uv_mutex_unlock(&lock);
+    return NULL;
+  }
+  if (!handles.empty()) {
+    GDALDataset *handle = handles.back();
+    handles.pop_back();
+    uv_mutex_unlock(&lock);
+    return handle;
+  }
+  if (open_count >= max_size) {
+    uv_mutex_unlock(&lock);
+    return NULL;
+  }
+  open_count++;
+  uv_mutex_unlock(&lock);
+
+  // the file is opened outside of the lock, this can take some time
+  const char *allowed_drivers[] = {driver.c_str(), NULL};
+  CPLPushErrorHandler(CPLQuietErrorHandler);
+  GDALDataset *handle =
+    (GDALDataset *)GDALOpenEx(filename.c_str(), GDAL_OF_RASTER | GDAL_OF_READONLY, allowed_drivers, NULL, NULL);
+  CPLPopErrorHandler();
+  CPLErrorReset();
+
+  if (
+    handle != nullptr &&
+    (handle->GetRasterXSize() != raster_x_size || handle->GetRasterYSize() != raster_y_size ||
+     handle->GetRasterCount() != raster_count)) {
+    GDALClose(handle);
+    handle = NULL;
+  }
+
+  if (handle == nullptr) {
+    // don't try again, the main handle will be used
+    uv_mutex_lock(&lock);
+    open_count--;
+    max_size = open_count;
+    uv_mutex_unlock(&lock);
+  }
+  return handle;
+#endif
+}
+
+void ReaderPool::release(GDALDataset *handle) {
+  uv_mutex_lock(&lock);
+  if (!closed) {
+    handles.push_back(handle);
+    uv_mutex_unlock(&lock);
+    return;
+  }
+  uv_mutex_unlock(&lock);
+  GDALClose(handle);
+}
+
+void ReaderPool::close() {
+  std::vector<GDALDataset *> to_close;
+  uv_mutex_lock(&lock);
+  closed = true;
+  to_close.swap(handles);
+  uv_mutex_unlock(&lock);
+  for (GDALDataset *handle : to_close) GDALClose(handle);
+}
+
+} // namespace node_gdal
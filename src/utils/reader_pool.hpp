@@ -0,0 +1,59 @@
+#ifndef __READER_POOL_H__
+#define __READER_POOL_H__
+
+// node
+#include <node.h>
+#include <uv.h>
+
+// gdal
+#include <gdal_priv.h>
+
+#include <string>
+#include <vector>
+
+namespace node_gdal {
+
+// A pool of additional handles on a dataset opened read-only
+//
+// A GDALDataset cannot be used by several threads at the same time,
+// so every operation on a dataset is serialized by its async_lock.
+// Reading from a read-only file through independent handles is safe,
+// the async pixel reads borrow a handle from the pool and run
+// in parallel without taking the async_lock.
+//
+// The handles are opened on demand, up to UV_THREADPOOL_SIZE,
+// acquire() returns NULL when none is available and the caller
+// must then fall back to the main handle and its async_lock.
+//
+// The pool is shared by the dataset and the running async operations,
+// it is closed when the dataset is disposed, the handles still
+// borrowed at that time are closed when they are released.
+
+class ReaderPool {
+    public:
+  static ReaderPool *create(GDALDataset *ds);
+
+  GDALDataset *acquire();
+  void release(GDALDataset *handle);
+  void close();
+
+  ~ReaderPool();
+
+    private:
+  ReaderPool(GDALDataset *ds, int max_size);
+
+  uv_mutex_t lock;
+  std::string filename;
+  std::string driver;
+  int raster_x_size;
+  int raster_y_size;
+  int raster_count;
+  int max_size;
+  int open_count;
+  bool closed;
+  std::vector<GDALDataset *> handles;
+};
+
+} // namespace node_gdal
+
+#endif
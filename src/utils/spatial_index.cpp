@@ -0,0 +1,225 @@
+#include "spatial_index.hpp"
+
+#include <cpl_vsi.h>
+
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+
+namespace node_gdal {
+
+static const char SPATIAL_INDEX_MAGIC[8] = {'N', 'G', 'R', 'T', 'R', 'E', 'E', 1};
+
+struct SpatialIndexHeader {
+  char magic[8];
+  uint64_t num_items;
+  uint64_t node_size;
+};
+
+// Fast Hilbert curve algorithm by http://threadlocalmutex.com/
+// (public domain, as ported in flatbush)
+static uint32_t hilbert(uint32_t x, uint32_t y) {
+  uint32_t a = x ^ y;
+  uint32_t b = 0xFFFF ^ a;
+  uint32_t c = 0xFFFF ^ (x | y);
+  uint32_t d = x & (y ^ 0xFFFF);
+
+  uint32_t A = a | (b >> 1);
+  uint32_t B = (a >> 1) ^ a;
+  uint32_t C = ((c >> 1) ^ (b & (d >> 1))) ^ c;
+  uint32_t D = ((a & (c >> 1)) ^ (d >> 1)) ^ d;
+
+  a = A;
+  b = B;
+  c = C;
+  d = D;
+  A = ((a & (a >> 2)) ^ (b & (b >> 2)));
+  B = ((a & (b >> 2)) ^ (b & ((a ^ b) >> 2)));
+  C ^= ((a & (c >> 2)) ^ (b & (d >> 2)));
+  D ^= ((b & (c >> 2)) ^ ((a ^ b) & (d >> 2)));
+
+  a = A;
+  b = B;
+  c = C;
+  d = D;
+  A = ((a & (a >> 4)) ^ (b & (b >> 4)));
+  B = ((a & (b >> 4)) ^ (b & ((a ^ b) >> 4)));
+  C ^= ((a & (c >> 4)) ^ (b & (d >> 4)));
+  D ^= ((b & (c >> 4)) ^ ((a ^ b) & (d >> 4)));
+
+  a = A;
+  b = B;
+  c = C;
+  d = D;
+  C ^= ((a & (c >> 8)) ^ (b & (d >> 8)));
+  D ^= ((b & (c >> 8)) ^ ((a ^ b) & (d >> 8)));
+
+  a = C ^ (C >> 1);
+  b = D ^ (D >> 1);
+
+  uint32_t i0 = x ^ y;
+  uint32_t i1 = b | (0xFFFF ^ (i0 | a));
+
+  i0 = (i0 | (i0 << 8)) & 0x00FF00FF;
+  i0 = (i0 | (i0 << 4)) & 0x0F0F0F0F;
+  i0 = (i0 | (i0 << 2)) & 0x33333333;
+  i0 = (i0 | (i0 << 1)) & 0x55555555;
+
+  i1 = (i1 | (i1 << 8)) & 0x00FF00FF;
+  i1 = (i1 | (i1 << 4)) & 0x0F0F0F0F;
+  i1 = (i1 | (i1 << 2)) & 0x33333333;
+  i1 = (i1 | (i1 << 1)) & 0x55555555;
+
+  return (i1 << 1) | i0;
+}
+
+SpatialIndex::SpatialIndex(size_t num_items, uint16_t node_size)
+  : num_items(num_items), node_size(std::max<uint16_t>(node_size, 2)), level_bounds(), boxes(), indices() {
+  computeLevels();
+}
+
+void SpatialIndex::computeLevels() {
+  size_t count = num_items;
+  size_t num_nodes = num_items;
+  level_bounds.push_back(num_nodes);
+  if (num_items == 0) return;
+  do {
+    count = (count + node_size - 1) / node_size;
+    num_nodes += count;
+    level_bounds.push_back(num_nodes);
+  } while (count != 1);
+}
+
+SpatialIndex::SpatialIndex(std::vector<Item> &items, uint16_t node_size) : SpatialIndex(items.size(), node_size) {
+  if (num_items == 0) return;
+
+  OGREnvelope extent;
+  for (const Item &item : items) extent.Merge(item.envelope);
+  double width = extent.MaxX - extent.MinX;
+  double height = extent.MaxY - extent.MinY;
+
+  // sort the leaves along the Hilbert curve of their centers
+  std::vector<std::pair<uint32_t, size_t>> order(num_items);
+  const double hilbert_max = 0xFFFF;
+  for (size_t i = 0; i < num_items; i++) {
+    const OGREnvelope &e = items[i].envelope;
+    uint32_t x = width > 0 ? (uint32_t)floor(hilbert_max * ((e.MinX + e.MaxX) / 2 - extent.MinX) / width) : 0;
+    uint32_t y = height > 0 ? (uint32_t)floor(hilbert_max * ((e.MinY + e.MaxY) / 2 - extent.MinY) / height) : 0;
+    order[i] = std::make_pair(hilbert(x, y), i);
+  }
+  std::sort(order.begin(), order.end());
+
+  size_t num_nodes = level_bounds.back();
+  boxes.resize(num_nodes);
+  indices.resize(num_nodes);
+  for (size_t i = 0; i < num_items; i++) {
+    boxes[i] = items[order[i].second].envelope;
+    indices[i] = items[order[i].second].fid;
+  }
+
+  // pack every level into the parent nodes
+  size_t pos = 0;
+  size_t parent = num_items;
+  for (size_t level = 0; level + 1 < level_bounds.size(); level++) {
+    size_t end = level_bounds[level];
+    while (pos < end) {
+      OGREnvelope node;
+      indices[parent] = pos;
+      for (size_t i = 0; i < node_size && pos < end; i++, pos++) node.Merge(boxes[pos]);
+      boxes[parent++] = node;
+    }
+  }
+}
+
+/*
+ * Appends to results the fids of all the features whose envelope intersects the given envelope
+ */
+void SpatialIndex::search(const OGREnvelope &envelope, std::vector<GIntBig> &results) const {
+  if (num_items == 0) return;
+
+  std::vector<std::pair<size_t, size_t>> queue;
+  size_t node = boxes.size() - 1;
+  size_t level = level_bounds.size() - 1;
+
+  while (true) {
+    size_t end = std::min(node + node_size, level_bounds[level]);
+    for (size_t pos = node; pos < end; pos++) {
+      if (!envelope.Intersects(boxes[pos])) continue;
+      if (node < num_items) {
+        results.push_back(indices[pos]);
+      } else {
+        queue.push_back(std::make_pair((size_t)indices[pos], level - 1));
+      }
+    }
+    if (queue.empty()) break;
+    node = queue.back().first;
+    level = queue.back().second;
+    queue.pop_back();
+  }
+}
+
+bool SpatialIndex::save(const char *filename) const {
+  VSILFILE *fp = VSIFOpenL(filename, "wb");
+  if (fp == nullptr) return false;
+
+  SpatialIndexHeader header;
+  memcpy(header.magic, SPATIAL_INDEX_MAGIC, sizeof(header.magic));
+  header.num_items = num_items;
+  header.node_size = node_size;
+  bool ok = VSIFWriteL(&header, sizeof(header), 1, fp) == 1;
+  if (ok && !boxes.empty()) {
+    ok = VSIFWriteL(boxes.data(), sizeof(OGREnvelope), boxes.size(), fp) == boxes.size() &&
+      VSIFWriteL(indices.data(), sizeof(GIntBig), indices.size(), fp) == indices.size();
+  }
+  return VSIFCloseL(fp) == 0 && ok;
+}
+
+/*
+ * Returns NULL if the file cannot be read or is not a spatial index
+ */
+SpatialIndex *SpatialIndex::load(const char *filename) {
+  VSILFILE *fp = VSIFOpenL(filename, "rb");
+  if (fp == nullptr) return NULL;
+
+  SpatialIndexHeader header;
+  if (
+    VSIFReadL(&header, sizeof(header), 1, fp) != 1 ||
+    memcmp(header.magic, SPATIAL_INDEX_MAGIC, sizeof(header.magic)) != 0 || header.node_size < 2 ||
+    header.node_size > 0xFFFF) {
+    VSIFCloseL(fp);
+    return NULL;
+  }
+
+  // check the size before allocating anything
+  VSIFSeekL(fp, 0, SEEK_END);
+  vsi_l_offset file_size = VSIFTellL(fp);
+  VSIFSeekL(fp, sizeof(header), SEEK_SET);
+  if (header.num_items > (file_size - sizeof(header)) / (sizeof(OGREnvelope) + sizeof(GIntBig))) {
+    VSIFCloseL(fp);
+    return NULL;
+  }
+
+  SpatialIndex *index = new SpatialIndex(header.num_items, header.node_size);
+  size_t num_nodes = index->level_bounds.back();
+  bool ok = file_size == sizeof(header) + num_nodes * (sizeof(OGREnvelope) + sizeof(GIntBig));
+  if (ok && num_nodes > 0) {
+    index->boxes.resize(num_nodes);
+    index->indices.resize(num_nodes);
+    ok = VSIFReadL(index->boxes.data(), sizeof(OGREnvelope), num_nodes, fp) == num_nodes &&
+      VSIFReadL(index->indices.data(), sizeof(GIntBig), num_nodes, fp) == num_nodes;
+  }
+  VSIFCloseL(fp);
+
+  // the children of a node always come before it
+  for (size_t pos = index->num_items; ok && pos < num_nodes; pos++) {
+    if (index->indices[pos] < 0 || (size_t)index->indices[pos] >= pos) ok = false;
+  }
+
+  if (!ok) {
+    delete index;
+    return NULL;
+  }
+  return index;
+}
+
+} // namespace node_gdal
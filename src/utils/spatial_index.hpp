@@ -0,0 +1,56 @@
+#ifndef __SPATIAL_INDEX_H__
+#define __SPATIAL_INDEX_H__
+
+// ogr
+#include <ogrsf_frmts.h>
+
+#include <stdint.h>
+#include <vector>
+
+namespace node_gdal {
+
+// A static, packed R-tree over feature envelopes
+//
+// The envelopes are sorted along a Hilbert curve and packed bottom-up
+// in nodes of node_size entries (same layout as flatbush): all the nodes
+// live in two flat arrays, the leaves first and the root last, and a
+// node refers to its children by their position.
+//
+// The index is built once, it does not follow later changes of the layer.
+// It can be saved to and loaded from a file (any VSI path), the file uses
+// the native byte order and is meant as a local cache.
+
+class SpatialIndex {
+    public:
+  static const uint16_t DEFAULT_NODE_SIZE = 16;
+
+  struct Item {
+    OGREnvelope envelope;
+    GIntBig fid;
+  };
+
+  SpatialIndex(std::vector<Item> &items, uint16_t node_size = DEFAULT_NODE_SIZE);
+
+  void search(const OGREnvelope &envelope, std::vector<GIntBig> &results) const;
+  size_t size() const {
+    return num_items;
+  }
+
+  bool save(const char *filename) const;
+  static SpatialIndex *load(const char *filename);
+
+    private:
+  SpatialIndex(size_t num_items, uint16_t node_size);
+  void computeLevels();
+
+  size_t num_items;
+  uint16_t node_size;
+  std::vector<size_t> level_bounds;
+  std::vector<OGREnvelope> boxes;
+  // fid for the leaves, position of the first child for the other nodes
+  std::vector<GIntBig> indices;
+};
+
+} // namespace node_gdal
+
+#endif
@@ -4,74 +4,84 @@
 
 namespace node_gdal {
 
-// https://github.com/joyent/node/issues/4201#issuecomment-9837340
+// The arrays are created with the V8 API, without looking up
+// the constructors on the global object
+
+template <typename T> static Local<Value> NewView(Local<Value> buffer, size_t byte_offset, size_t length) {
+  if (buffer->IsSharedArrayBuffer()) return T::New(buffer.As<SharedArrayBuffer>(), byte_offset, length);
+  return T::New(buffer.As<ArrayBuffer>(), byte_offset, length);
+}
+
+static Local<Value> NewView(GDALDataType type, Local<Value> buffer, size_t byte_offset, size_t length) {
+  switch (type) {
+    case GDT_Byte: return NewView<Uint8Array>(buffer, byte_offset, length);
+    case GDT_Int16: return NewView<Int16Array>(buffer, byte_offset, length);
+    case GDT_UInt16: return NewView<Uint16Array>(buffer, byte_offset, length);
+    case GDT_Int32: return NewView<Int32Array>(buffer, byte_offset, length);
+    case GDT_UInt32: return NewView<Uint32Array>(buffer, byte_offset, length);
+    case GDT_Float32: return NewView<Float32Array>(buffer, byte_offset, length);
+    case GDT_Float64: return NewView<Float64Array>(buffer, byte_offset, length);
+    default: Nan::ThrowError("Unsupported array type"); return Nan::Undefined();
+  }
+}
 
 Local<Value> TypedArray::New(GDALDataType type, unsigned int length) {
   Nan::EscapableHandleScope scope;
 
-  Local<Value> val;
-  Local<Function> constructor;
-  Local<Object> global = Nan::GetCurrentContext()->Global();
-
-  const char *name;
   switch (type) {
-    case GDT_Byte: name = "Uint8Array"; break;
-    case GDT_Int16: name = "Int16Array"; break;
-    case GDT_UInt16: name = "Uint16Array"; break;
-    case GDT_Int32: name = "Int32Array"; break;
-    case GDT_UInt32: name = "Uint32Array"; break;
-    case GDT_Float32: name = "Float32Array"; break;
-    case GDT_Float64: name = "Float64Array"; break;
+    case GDT_Byte:
+    case GDT_Int16:
+    case GDT_UInt16:
+    case GDT_Int32:
+    case GDT_UInt32:
+    case GDT_Float32:
+    case GDT_Float64: break;
     default: Nan::ThrowError("Unsupported array type"); return scope.Escape(Nan::Undefined());
   }
 
-  // make ArrayBuffer
-  val = Nan::Get(global, Nan::New("ArrayBuffer").ToLocalChecked()).ToLocalChecked();
+  Local<ArrayBuffer> array_buffer =
+    ArrayBuffer::New(v8::Isolate::GetCurrent(), (size_t)length * GDALGetDataTypeSize(type) / 8);
 
-  if (val.IsEmpty() || !val->IsFunction()) {
-    Nan::ThrowError("Error getting ArrayBuffer constructor");
-    return scope.Escape(Nan::Undefined());
-  }
+  return scope.Escape(NewView(type, array_buffer, 0, length));
+}
 
-  constructor = val.As<Function>();
-  Local<Value> size = Nan::New<Integer>(length * GDALGetDataTypeSize(type) / 8);
-  Local<Value> array_buffer = Nan::NewInstance(constructor, 1, &size).ToLocalChecked();
+Local<Value> TypedArray::New(GDALDataType type, Local<Value> buffer, size_t byte_offset, unsigned int length) {
+  Nan::EscapableHandleScope scope;
 
-  if (array_buffer.IsEmpty() || !array_buffer->IsObject()) {
-    Nan::ThrowError("Error allocating ArrayBuffer");
+  size_t byte_length;
+  if (buffer->IsSharedArrayBuffer()) {
+    byte_length = buffer.As<SharedArrayBuffer>()->ByteLength();
+  } else if (buffer->IsArrayBuffer()) {
+    byte_length = buffer.As<ArrayBuffer>()->ByteLength();
+  } else {
+    Nan::ThrowTypeError("buffer must be an ArrayBuffer or a SharedArrayBuffer");
     return scope.Escape(Nan::Undefined());
   }
 
-  // make TypedArray
-  val = Nan::Get(global, Nan::New(name).ToLocalChecked()).ToLocalChecked();
-
-  if (val.IsEmpty() || !val->IsFunction()) {
-    Nan::ThrowError("Error getting typed array constructor");
+  size_t bytes_per_element = GDALGetDataTypeSize(type) / 8;
+  if (bytes_per_element == 0 || byte_offset % bytes_per_element) {
+    Nan::ThrowRangeError("offset must be a multiple of the size of the data type");
     return scope.Escape(Nan::Undefined());
   }
-
-  constructor = val.As<Function>();
-  Local<Object> array = Nan::NewInstance(constructor, 1, &array_buffer).ToLocalChecked();
-
-  if (array.IsEmpty() || !array->IsObject()) {
-    Nan::ThrowError("Error creating TypedArray");
+  if (byte_offset > byte_length) {
+    Nan::ThrowRangeError("offset is out of the bounds of the buffer");
     return scope.Escape(Nan::Undefined());
   }
 
-  Nan::Set(array, Nan::New("_gdal_type").ToLocalChecked(), Nan::New(type));
-
-  return scope.Escape(array);
+  // the view is truncated to the end of the buffer, Validate() checks its length
+  size_t available = (byte_length - byte_offset) / bytes_per_element;
+  return scope.Escape(NewView(type, buffer, byte_offset, length < available ? length : available));
 }
 
 GDALDataType TypedArray::Identify(Local<Object> obj) {
-  Nan::HandleScope scope;
-
-  Local<String> sym = Nan::New("_gdal_type").ToLocalChecked();
-  if (!Nan::HasOwnProperty(obj, sym).FromMaybe(false)) return GDT_Unknown;
-  Local<Value> val = Nan::Get(obj, sym).ToLocalChecked();
-  if (!val->IsNumber()) return GDT_Unknown;
-
-  return (GDALDataType)Nan::To<int32_t>(val).ToChecked();
+  if (obj->IsUint8Array() || obj->IsInt8Array()) return GDT_Byte;
+  if (obj->IsInt16Array()) return GDT_Int16;
+  if (obj->IsUint16Array()) return GDT_UInt16;
+  if (obj->IsInt32Array()) return GDT_Int32;
+  if (obj->IsUint32Array()) return GDT_UInt32;
+  if (obj->IsFloat32Array()) return GDT_Float32;
+  if (obj->IsFloat64Array()) return GDT_Float64;
+  return GDT_Unknown;
 }
 
 void *TypedArray::Validate(Local<Object> obj, GDALDataType type, int min_length) {
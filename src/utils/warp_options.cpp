@@ -12,6 +12,7 @@ WarpOptions::WarpOptions()
     dst_bands("dst band ids"),
     src_nodata(NULL),
     dst_nodata(NULL),
+    warp_options(NULL),
     multi(false) {
   options = GDALCreateWarpOptions();
 }
@@ -23,6 +24,7 @@ WarpOptions::~WarpOptions() {
   if (options) delete options;
   if (src_nodata) delete src_nodata;
   if (dst_nodata) delete dst_nodata;
+  if (warp_options) CSLDestroy(warp_options);
 }
 
 int WarpOptions::parseResamplingAlg(Local<Value> value) {
@@ -89,6 +91,7 @@ int WarpOptions::parseResamplingAlg(Local<Value> value) {
  *   dstNoData: double
  *   cutline: geometry
  *   blend: double
+ *   numThreads: int | string
  * }
  */
 int WarpOptions::parse(Local<Value> value) {
@@ -107,6 +110,23 @@ int WarpOptions::parse(Local<Value> value) {
 
   options->papszWarpOptions = additional_options.get();
 
+  if (Nan::HasOwnProperty(obj, Nan::New("numThreads").ToLocalChecked()).FromMaybe(false)) {
+    prop = Nan::Get(obj, Nan::New("numThreads").ToLocalChecked()).ToLocalChecked();
+    std::string num_threads;
+    if (prop->IsInt32() && Nan::To<int32_t>(prop).ToChecked() > 0) {
+      num_threads = std::to_string(Nan::To<int32_t>(prop).ToChecked());
+    } else if (prop->IsString()) {
+      num_threads = *Nan::Utf8String(prop);
+    } else if (!prop->IsUndefined() && !prop->IsNull()) {
+      Nan::ThrowTypeError("numThreads property must be a positive integer or \"ALL_CPUS\"");
+      return 1;
+    }
+    if (!num_threads.empty()) {
+      warp_options = CSLSetNameValue(CSLDuplicate(additional_options.get()), "NUM_THREADS", num_threads.c_str());
+      options->papszWarpOptions = warp_options;
+    }
+  }
+
   if (Nan::HasOwnProperty(obj, Nan::New("memoryLimit").ToLocalChecked()).FromMaybe(false)) {
     prop = Nan::Get(obj, Nan::New("memoryLimit").ToLocalChecked()).ToLocalChecked();
     if (prop->IsNumber()) {
@@ -38,6 +38,7 @@ namespace node_gdal {
 //   dstNoData: double
 //   cutline: geometry
 //   blend: double
+//   numThreads: int | string
 // }
 
 class WarpOptions {
@@ -62,6 +63,7 @@ class WarpOptions {
   IntegerList dst_bands;
   double *src_nodata;
   double *dst_nodata;
+  char **warp_options;
   bool multi;
 };
 
@@ -247,5 +247,244 @@ describe('gdal', () => {
         assert.instanceOf(geom, gdal.Polygon)
       })
     })
+    it('should drop the spatial index of the layer', () => {
+      lyr.buildSpatialIndex()
+      gdal.polygonize({ src: srcband, dst: lyr, pixValField: 0 })
+      assert.throws(() => {
+        lyr.query({ minX: 0, minY: -64, maxX: 64, maxY: 0 })
+      }, /buildSpatialIndex/)
+    })
+  })
+  describe('zonalStats()', () => {
+    let ds, band, vector, lyr
+    const addZone = (wkt) => {
+      const feature = new gdal.Feature(lyr)
+      feature.setGeometry(gdal.Geometry.fromWKT(wkt))
+      lyr.features.add(feature)
+    }
+    beforeEach(() => {
+      ds = gdal.open('temp', 'w', 'MEM', 10, 10, 1, gdal.GDT_Float32)
+      ds.geoTransform = [ 0, 1, 0, 10, 0, -1 ]
+      band = ds.bands.get(1)
+      const data = new Float32Array(100)
+      for (let i = 0; i < data.length; i++) data[i] = i % 10
+      band.pixels.write(0, 0, 10, 10, data)
+      vector = gdal.open('temp', 'w', 'Memory')
+      lyr = vector.layers.create('zones', null, gdal.Polygon)
+      addZone('POLYGON ((0 8,0 10,2 10,2 8,0 8))')
+      addZone('POLYGON ((20 20,20 30,30 30,30 20,20 20))')
+      addZone('POLYGON ((4.5 0,4.5 10,10 10,10 0,4.5 0))')
+    })
+    afterEach(() => {
+      vector.close()
+      ds.close()
+    })
+    it('should compute the statistics of each feature', () => {
+      const stats = gdal.zonalStats(band, lyr)
+      assert.lengthOf(stats, 3)
+      assert.deepInclude(stats[0], { count: 4, sum: 2, mean: 0.5, min: 0, max: 1 })
+      assert.equal(stats[1].count, 0)
+      assert.isNaN(stats[1].mean)
+      assert.deepInclude(stats[2], { count: 50, sum: 350, mean: 7, min: 5, max: 9 })
+    })
+    it('should return only the requested statistics', () => {
+      const stats = gdal.zonalStats(band, lyr, { stats: [ 'max' ] })
+      assert.deepEqual(Object.keys(stats[0]).sort(), [ 'fid', 'max' ])
+    })
+    it('should include all touched pixels', () => {
+      const stats = gdal.zonalStats(band, lyr, { allTouched: true })
+      assert.equal(stats[2].count, 60)
+      assert.equal(stats[2].min, 4)
+    })
+    it('should ignore the nodata pixels', () => {
+      band.noDataValue = 0
+      const stats = gdal.zonalStats(band, lyr)
+      assert.deepInclude(stats[0], { count: 2, sum: 2, min: 1, max: 1 })
+    })
+    it('should give the same result with several threads', () => {
+      for (let i = 0; i < 50; i++) addZone('POLYGON ((1 1,1 9,9 9,9 1,1 1))')
+      assert.deepEqual(gdal.zonalStats(band, lyr, { threads: 4 }), gdal.zonalStats(band, lyr))
+    })
+    it('should throw on invalid statistics', () => {
+      assert.throws(() => {
+        gdal.zonalStats(band, lyr, { stats: [ 'median' ] })
+      }, /stats must contain only/)
+    })
+  })
+  describe('calc()', () => {
+    let ds, a, b, dst
+    beforeEach(() => {
+      ds = gdal.open('temp', 'w', 'MEM', 100, 100, 3, gdal.GDT_Float32)
+      a = ds.bands.get(1)
+      b = ds.bands.get(2)
+      dst = ds.bands.get(3)
+      const va = new Float32Array(100 * 100)
+      const vb = new Float32Array(100 * 100)
+      for (let i = 0; i < va.length; i++) {
+        va[i] = i % 7
+        vb[i] = i % 3
+      }
+      a.pixels.write(0, 0, 100, 100, va)
+      b.pixels.write(0, 0, 100, 100, vb)
+    })
+    afterEach(() => {
+      ds.close()
+    })
+    it('should evaluate the expression on each pixel', () => {
+      dst.noDataValue = -1
+      gdal.calc({ a, b }, 'where(a+b>0,(a-b)/(a+b),nodata)', dst)
+      const va = a.pixels.read(0, 0, 100, 100)
+      const vb = b.pixels.read(0, 0, 100, 100)
+      const result = dst.pixels.read(0, 0, 100, 100)
+      for (let i = 0; i < result.length; i++) {
+        const expected = va[i] + vb[i] > 0 ? (va[i] - vb[i]) / (va[i] + vb[i]) : -1
+        assert.closeTo(result[i], expected, 1e-6)
+      }
+    })
+    it('should support the operators and functions', () => {
+      gdal.calc({ a }, '-2^2 + max(a, 3) * (a >= 1 && !(a == 4)) + abs(-1) % 2', dst)
+      const va = a.pixels.read(0, 0, 100, 100)
+      const result = dst.pixels.read(0, 0, 100, 100)
+      for (let i = 0; i < result.length; i++) {
+        assert.equal(result[i], -4 + Math.max(va[i], 3) * (va[i] >= 1 && va[i] !== 4 ? 1 : 0) + 1)
+      }
+    })
+    it('should set the pixels where an input is nodata to the nodata value of dst', () => {
+      a.noDataValue = 0
+      dst.noDataValue = -1
+      gdal.calc({ a, b }, 'a + b', dst)
+      const va = a.pixels.read(0, 0, 100, 100)
+      const result = dst.pixels.read(0, 0, 100, 100)
+      for (let i = 0; i < result.length; i++) {
+        if (va[i] === 0) assert.equal(result[i], -1)
+      }
+    })
+    it('should give the same result with several threads', () => {
+      gdal.calc({ a, b }, 'sqrt(a) * b', dst)
+      const single = dst.pixels.read(0, 0, 100, 100)
+      dst.fill(0)
+      gdal.calc({ a, b }, 'sqrt(a) * b', dst, { threads: 4 })
+      assert.deepEqual(dst.pixels.read(0, 0, 100, 100), single)
+    })
+    it('should throw on invalid expressions', () => {
+      assert.throws(() => {
+        gdal.calc({ a }, 'a + c', dst)
+      }, /Unknown variable 'c'/)
+      assert.throws(() => {
+        gdal.calc({ a }, 'where(a, 1)', dst)
+      }, /expects 3 arguments/)
+      assert.throws(() => {
+        gdal.calc({ a }, '(a + 1', dst)
+      }, /Expected '\)'/)
+    })
+    it('should throw if the sizes do not match', () => {
+      const other = gdal.open('temp', 'w', 'MEM', 10, 10, 1, gdal.GDT_Float32)
+      assert.throws(() => {
+        gdal.calc({ a: other.bands.get(1) }, 'a', dst)
+      }, /same size/)
+    })
+  })
+  describe('rasterize()', () => {
+    let ds, vector, lyr
+    beforeEach(() => {
+      ds = gdal.open('temp', 'w', 'MEM', 10, 10, 2, gdal.GDT_Float32)
+      ds.geoTransform = [ 0, 1, 0, 10, 0, -1 ]
+      vector = gdal.open('temp', 'w', 'Memory')
+      lyr = vector.layers.create('zones', null, gdal.Polygon)
+      lyr.fields.add(new gdal.FieldDefn('height', gdal.OFTReal))
+      const feature = new gdal.Feature(lyr)
+      feature.setGeometry(gdal.Geometry.fromWKT('POLYGON ((0 5,0 10,5 10,5 5,0 5))'))
+      feature.fields.set('height', 42.5)
+      lyr.features.add(feature)
+    })
+    afterEach(() => {
+      vector.close()
+      ds.close()
+    })
+    const count = (band, value) => band.pixels.read(0, 0, 10, 10).filter((v) => v === value).length
+    it('should burn the geometries into the first band', () => {
+      gdal.rasterize(ds, lyr)
+      assert.equal(count(ds.bands.get(1), 1), 25)
+      assert.equal(count(ds.bands.get(2), 1), 0)
+    })
+    it('should burn one value per band', () => {
+      gdal.rasterize(ds, [ lyr ], { burnValues: [ 3, 7 ] })
+      assert.equal(count(ds.bands.get(1), 3), 25)
+      assert.equal(count(ds.bands.get(2), 7), 25)
+    })
+    it('should burn an attribute', () => {
+      gdal.rasterize(ds, lyr, { attribute: 'height', bands: [ 2 ] })
+      assert.equal(count(ds.bands.get(2), 42.5), 25)
+    })
+    it('should add to the existing values', () => {
+      gdal.rasterize(ds, lyr, { burnValues: [ 2 ] })
+      gdal.rasterize(ds, lyr, { burnValues: [ 2 ], mergeAlg: 'ADD' })
+      assert.equal(count(ds.bands.get(1), 4), 25)
+    })
+    it('should throw if the burn values do not match the bands', () => {
+      assert.throws(() => {
+        gdal.rasterize(ds, lyr, { bands: [ 1, 2 ], burnValues: [ 1 ] })
+      }, /one value per band/)
+    })
+  })
+  describe('grid()', () => {
+    // a plane z = x + y sampled on a 5x5 lattice
+    const coords = []
+    for (let x = 0; x <= 10; x += 2.5) {
+      for (let y = 0; y <= 10; y += 2.5) coords.push(x, y, x + y)
+    }
+    const points = new Float64Array(coords)
+    it('should create a new dataset', () => {
+      const ds = gdal.grid(points, { algorithm: 'nearest', size: { x: 4, y: 4 }, bounds: [ 0, 0, 10, 10 ] })
+      assert.instanceOf(ds, gdal.Dataset)
+      assert.deepEqual(ds.geoTransform, [ 0, 2.5, 0, 10, 0, -2.5 ])
+      const band = ds.bands.get(1)
+      assert.equal(band.dataType, gdal.GDT_Float64)
+      // the nearest point of the center of the top left cell (1.25, 8.75)
+      assert.include([ 7.5, 10, 12.5 ], band.pixels.get(0, 0))
+      assert.include([ 7.5, 10, 12.5 ], band.pixels.get(3, 3))
+      ds.close()
+    })
+    it('should interpolate into an existing band', () => {
+      const ds = gdal.open('temp', 'w', 'MEM', 10, 10, 1, gdal.GDT_Float32)
+      ds.geoTransform = [ 0, 1, 0, 10, 0, -1 ]
+      const band = ds.bands.get(1)
+      assert.isUndefined(gdal.grid(points, { algorithm: 'invdist', power: 2, threads: 2 }, band))
+      const data = band.pixels.read(0, 0, 10, 10)
+      for (let i = 0; i < data.length; i++) {
+        assert.isAtLeast(data[i], 0)
+        assert.isAtMost(data[i], 20)
+      }
+      // smaller on the bottom left than on the top right
+      assert.isBelow(band.pixels.get(0, 9), band.pixels.get(9, 0))
+      ds.close()
+    })
+    it('should read the values from a layer attribute', () => {
+      const vector = gdal.open('temp', 'w', 'Memory')
+      const lyr = vector.layers.create('points', null, gdal.Point)
+      lyr.fields.add(new gdal.FieldDefn('value', gdal.OFTReal))
+      for (let i = 0; i < points.length; i += 3) {
+        const feature = new gdal.Feature(lyr)
+        feature.setGeometry(new gdal.Point(points[i], points[i + 1]))
+        feature.fields.set('value', 7)
+        lyr.features.add(feature)
+      }
+      const ds = gdal.grid(lyr, { algorithm: 'average', radius1: 5, radius2: 5, zField: 'value',
+        size: { x: 5, y: 5 }, bounds: [ 0, 0, 10, 10 ] })
+      assert.equal(ds.bands.get(1).pixels.get(2, 2), 7)
+      ds.close()
+      vector.close()
+    })
+    it('should throw on invalid arguments', () => {
+      assert.throws(() => {
+        gdal.grid(new Float64Array([ 0, 0 ]), { size: { x: 4, y: 4 }, bounds: [ 0, 0, 10, 10 ] })
+      }, /multiple of 3/)
+      assert.throws(() => {
+        gdal.grid(points, { algorithm: 'kriging', size: { x: 4, y: 4 }, bounds: [ 0, 0, 10, 10 ] })
+      }, /algorithm must be/)
+      assert.throws(() => {
+        gdal.grid(points, {})
+      }, /size and bounds/)
+    })
   })
 })
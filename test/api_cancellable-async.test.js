@@ -0,0 +1,769 @@
+const chaiAsPromised = require('chai-as-promised')
+const chai = require('chai')
+const assert = chai.assert
+const gdal = require('../lib/gdal.js')
+const fileUtils = require('./utils/file.js')
+const fs = require('fs')
+
+chai.use(chaiAsPromised)
+const expect = chai.expect
+
+/* Without this, unhandledRejections are silently ignored!!!
+*/
+process.on('unhandledRejection', (e) => {
+  console.error(e); process.exit(1)
+})
+
+// Not supported on GDAL 1.x
+if (gdal.version.split('.')[0] < 2) {
+  return
+}
+
+// minimal AbortSignal-like object
+const createSignal = () => {
+  const listeners = []
+  return {
+    aborted: false,
+    addEventListener: (type, listener) => listeners.push(listener),
+    removeEventListener: (type, listener) => {
+      const i = listeners.indexOf(listener)
+      if (i >= 0) listeners.splice(i, 1)
+    },
+    abort: function () {
+      this.aborted = true
+      listeners.forEach((listener) => listener())
+    },
+    listeners
+  }
+}
+
+const abortedSignal = () => {
+  const signal = createSignal()
+  signal.abort()
+  return signal
+}
+
+const createBand = (size) => {
+  const ds = gdal.open('temp', 'w', 'MEM', size, size, 1, gdal.GDT_Byte)
+  const band = ds.bands.get(1)
+  const data = new Uint8Array(size * size)
+  for (let i = 0; i < data.length; i++) data[i] = i % 251
+  band.pixels.write(0, 0, size, size, data)
+  return band
+}
+
+// aborts the operation from its first progress report, the input must be large enough to still be running then
+const abortWhileRunning = (run) => {
+  const signal = createSignal()
+  let reported = false
+  return expect(run({
+    signal,
+    progress_cb: () => {
+      reported = true
+      signal.abort()
+    }
+  })).to.be.rejected.then((err) => {
+    assert.equal(err.name, 'AbortError')
+    assert.isTrue(reported)
+    assert.lengthOf(signal.listeners, 0)
+  })
+}
+
+describe('Cancellable async operations', () => {
+  afterEach(gc)
+
+  describe('AbortSignal', () => {
+    it('should reject with AbortError without starting the operation if the signal is already aborted', () => {
+      const band = createBand(64)
+      return expect(gdal.sieveFilterAsync({ src: band, dst: band, threshold: 4096, signal: abortedSignal() }))
+        .to.be.rejected.then((err) => {
+          assert.equal(err.name, 'AbortError')
+          assert.equal(band.pixels.get(1, 0), 1)
+        })
+    })
+  })
+
+  describe('gdal.reprojectImageAsync()', () => {
+    let src
+    beforeEach(() => {
+      src = gdal.open(`${__dirname}/data/sample.tif`)
+    })
+    afterEach(() => {
+      try {
+        src.close()
+      } catch (err) {
+        /* ignore */
+      }
+    })
+    const options = (dst) => ({
+      src,
+      dst,
+      s_srs: src.srs,
+      t_srs: src.srs
+    })
+    const createDst = () => {
+      const dst = gdal.open('temp', 'w', 'MEM', src.rasterSize.x, src.rasterSize.y, 1, src.bands.get(1).dataType)
+      dst.srs = src.srs
+      dst.geoTransform = src.geoTransform
+      return dst
+    }
+    it('should return a Promise', () => {
+      const dst = createDst()
+      return gdal.reprojectImageAsync(options(dst)).then((r) => {
+        assert.isUndefined(r)
+        assert.equal(gdal.checksumImage(dst.bands.get(1)), gdal.checksumImage(src.bands.get(1)))
+      })
+    })
+    it('should accept a callback', (done) => {
+      const dst = createDst()
+      const signal = createSignal()
+      const result = gdal.reprojectImageAsync(Object.assign(options(dst), { signal }), (err) => {
+        try {
+          assert.isUndefined(err)
+          assert.equal(gdal.checksumImage(dst.bands.get(1)), gdal.checksumImage(src.bands.get(1)))
+          assert.lengthOf(signal.listeners, 0)
+          done()
+        } catch (e) {
+          done(e)
+        }
+      })
+      assert.isUndefined(result)
+    })
+    it('should support multithreading and report the progress', () => {
+      const dst = createDst()
+      const progress = []
+      return gdal.reprojectImageAsync(Object.assign(options(dst), {
+        multi: true,
+        numThreads: 'ALL_CPUS',
+        progress_cb: (complete) => progress.push(complete)
+      })).then(() => {
+        assert.equal(gdal.checksumImage(dst.bands.get(1)), gdal.checksumImage(src.bands.get(1)))
+        progress.forEach((complete) => {
+          assert.isAtLeast(complete, 0)
+          assert.isAtMost(complete, 1)
+        })
+      })
+    })
+    it('should throw error if numThreads is invalid', () => {
+      const dst = createDst()
+      assert.throws(() => {
+        gdal.reprojectImage(Object.assign(options(dst), { numThreads: {} }))
+      }, /numThreads/)
+    })
+    it('should stop when aborted while running', () => {
+      const big = createBand(4096).ds
+      const dst = gdal.open('temp', 'w', 'MEM', 4096, 4096, 1)
+      return abortWhileRunning((o) => gdal.reprojectImageAsync(Object.assign({
+        src: big,
+        dst,
+        s_srs: src.srs,
+        t_srs: src.srs,
+        resampling: gdal.GRA_Lanczos
+      }, o))).then(() => {
+        // the locks are released
+        assert.equal(big.bands.get(1).pixels.get(1, 0), 1)
+        dst.bands.get(1).pixels.get(0, 0)
+      })
+    })
+  })
+
+  describe('gdal.polygonizeAsync()', () => {
+    let src, dst, lyr
+    beforeEach(() => {
+      src = gdal.open('temp', 'w', 'MEM', 64, 64, 1)
+      const w = 64
+      for (let y = 0; y < 64; y++) {
+        const buf = Buffer.alloc(w)
+        buf.fill(y & 32)
+        src.bands.get(1).pixels.write(0, y, w, 1, new Uint8Array(buf))
+      }
+      dst = gdal.open('temp', 'w', 'Memory')
+      lyr = dst.layers.create('temp', null, gdal.Polygon)
+      lyr.fields.add(new gdal.FieldDefn('val', gdal.OFTInteger))
+    })
+    it('should generate polygons from a RasterBand', () =>
+      gdal.polygonizeAsync({
+        src: src.bands.get(1),
+        dst: lyr,
+        pixValField: 0,
+        connectedness: 8
+      }).then(() => {
+        assert.equal(lyr.features.count(), 2)
+      })
+    )
+    it('should stop when aborted while running', () => {
+      const band = createBand(2048)
+      return abortWhileRunning((o) => gdal.polygonizeAsync(Object.assign({ src: band, dst: lyr, pixValField: 0 }, o)))
+        .then(() => {
+          assert.isAtLeast(lyr.features.count(), 0)
+          assert.equal(band.pixels.get(1, 0), 1)
+        })
+    })
+  })
+
+  describe('gdal.contourGenerateAsync()', () => {
+    let src, dst, lyr
+    beforeEach(() => {
+      src = gdal.open('temp', 'w', 'MEM', 64, 64, 1)
+      for (let y = 0; y < 64; y++) {
+        src.bands.get(1).pixels.write(0, y, 64, 1, new Uint8Array(64).fill(y * 4))
+      }
+      dst = gdal.open('temp', 'w', 'Memory')
+      lyr = dst.layers.create('temp', null, gdal.LineString)
+      lyr.fields.add(new gdal.FieldDefn('id', gdal.OFTInteger))
+      lyr.fields.add(new gdal.FieldDefn('elev', gdal.OFTReal))
+    })
+    it('should generate contours and report progress', () => {
+      const progress = []
+      return gdal.contourGenerateAsync({
+        src: src.bands.get(1),
+        dst: lyr,
+        interval: 32,
+        idField: 0,
+        elevField: 1,
+        progress_cb: (ratio) => progress.push(ratio)
+      }).then(() => {
+        assert.isAbove(lyr.features.count(), 0)
+        lyr.features.forEach((f) => assert.equal(f.fields.get('elev') % 32, 0))
+        assert.isAbove(progress.length, 0)
+      })
+    })
+    it('should stop when aborted while running', () => {
+      const band = createBand(2048)
+      return abortWhileRunning((o) => gdal.contourGenerateAsync(Object.assign({ src: band, dst: lyr, interval: 1 }, o)))
+        .then(() => {
+          assert.isAtLeast(lyr.features.count(), 0)
+          assert.equal(band.pixels.get(1, 0), 1)
+        })
+    })
+  })
+
+  describe('gdal.fillNodataAsync()', () => {
+    it('should fill nodata values', (done) => {
+      const src = gdal.open('temp', 'w', 'MEM', 64, 64, 1)
+      const band = src.bands.get(1)
+      band.noDataValue = 33
+      band.pixels.write(0, 0, 64, 64, new Uint8Array(64 * 64).fill(128))
+      band.pixels.set(10, 10, 33)
+      band.pixels.set(40, 20, 33)
+      gdal.fillNodataAsync({ src: band, searchDist: 3 }, (err) => {
+        try {
+          assert.isUndefined(err)
+          assert.equal(band.pixels.get(10, 10), 128)
+          assert.equal(band.pixels.get(40, 20), 128)
+          done()
+        } catch (e) {
+          done(e)
+        }
+      })
+    })
+    it('should stop when aborted while running', () => {
+      const band = createBand(4096)
+      band.noDataValue = 0
+      return abortWhileRunning((o) =>
+        gdal.fillNodataAsync(Object.assign({ src: band, searchDist: 100, smoothingIterations: 4 }, o))
+      ).then(() => {
+        assert.equal(band.pixels.get(1, 0), 1)
+      })
+    })
+  })
+
+  describe('gdal.sieveFilterAsync()', () => {
+    let src, band
+    beforeEach(() => {
+      src = gdal.open('temp', 'w', 'MEM', 64, 64, 1)
+      band = src.bands.get(1)
+      band.pixels.write(5, 5, 32, 32, new Uint8Array(32 * 32).fill(20))
+      band.pixels.write(7, 7, 4, 4, new Uint8Array(4 * 4).fill(10))
+    })
+    it('should fill smaller polygons in place', () =>
+      gdal.sieveFilterAsync({
+        src: band,
+        dst: band,
+        threshold: 4 * 4 + 1,
+        connectedness: 8
+      }).then(() => {
+        assert.equal(band.pixels.get(8, 8), 20)
+      })
+    )
+    it('should stop when aborted while running', () => {
+      const big = createBand(2048)
+      return abortWhileRunning((o) => gdal.sieveFilterAsync(Object.assign({ src: big, dst: big, threshold: 1000 }, o)))
+        .then(() => {
+          big.pixels.get(0, 0)
+        })
+    })
+  })
+
+  describe('gdal.translateAsync()', () => {
+    it('should resolve with the new Dataset and report progress', () => {
+      const src = gdal.open(`${__dirname}/data/sample.tif`)
+      const progress = []
+      return gdal.translateAsync('', src, [ '-of', 'MEM' ], { progress_cb: (r) => progress.push(r) }).then((out) => {
+        assert.instanceOf(out, gdal.Dataset)
+        assert.equal(out.rasterSize.x, src.rasterSize.x)
+        assert.isAbove(progress.length, 0)
+      })
+    })
+    it('should accept a callback when the optional parameters are omitted', (done) => {
+      const src = gdal.open(`${__dirname}/data/sample.tif`)
+      gdal.translateAsync('', src, (err, out) => {
+        try {
+          assert.isUndefined(err)
+          assert.instanceOf(out, gdal.Dataset)
+          done()
+        } catch (e) {
+          done(e)
+        }
+      })
+    })
+    it('should reject on invalid arguments', () => {
+      const src = gdal.open(`${__dirname}/data/sample.tif`)
+      return expect(gdal.translateAsync('', src, [ '-of', 'NOT_A_DRIVER' ])).to.be.rejected
+    })
+    it('should stop when aborted while running', () => {
+      const src = createBand(2048).ds
+      return abortWhileRunning((o) =>
+        gdal.translateAsync('', src, [ '-of', 'MEM', '-outsize', '200%', '200%', '-r', 'lanczos' ], o)
+      ).then(() => {
+        assert.equal(src.bands.get(1).pixels.get(1, 0), 1)
+      })
+    })
+  })
+
+  describe('gdal.warpAsync()', () => {
+    it('should resolve with the warped Dataset', () => {
+      const src = gdal.open(`${__dirname}/data/sample.tif`)
+      return gdal.warpAsync('', [ src ], [ '-of', 'MEM', '-t_srs', 'EPSG:4326', '-multi' ]).then((out) => {
+        assert.instanceOf(out, gdal.Dataset)
+        assert.isTrue(out.srs.isSame(gdal.SpatialReference.fromEPSG(4326)))
+      })
+    })
+    it('should keep the sources alive when the array is emptied', () => {
+      const sources = [ createBand(512).ds ]
+      sources[0].srs = gdal.SpatialReference.fromEPSG(4326)
+      sources[0].geoTransform = [ 2, 0.001, 0, 49, 0, -0.001 ]
+      const done = gdal.warpAsync('', sources, [ '-of', 'MEM', '-t_srs', 'EPSG:3857' ])
+      sources.length = 0
+      gc()
+      return done.then((out) => {
+        assert.isAbove(gdal.checksumImage(out.bands.get(1)), 0)
+      })
+    })
+    it('should stop when aborted while running', () => {
+      const src = createBand(2048).ds
+      src.srs = gdal.SpatialReference.fromEPSG(4326)
+      src.geoTransform = [ 2, 0.001, 0, 49, 0, -0.001 ]
+      return abortWhileRunning((o) =>
+        gdal.warpAsync('', [ src ], [ '-of', 'MEM', '-t_srs', 'EPSG:3857', '-r', 'lanczos' ], o)
+      ).then(() => {
+        assert.equal(src.bands.get(1).pixels.get(1, 0), 1)
+      })
+    })
+  })
+
+  describe('gdal.buildVRTAsync()', () => {
+    it('should resolve with the VRT Dataset', () =>
+      gdal.buildVRTAsync('', [ `${__dirname}/data/sample.tif` ]).then((vrt) => {
+        assert.equal(vrt.driver.description, 'VRT')
+      })
+    )
+    it('should keep the sources alive when the array is emptied', () => {
+      const sources = [ createBand(512).ds ]
+      const done = gdal.buildVRTAsync('', sources)
+      sources.length = 0
+      gc()
+      return done.then((vrt) => {
+        gc()
+        assert.equal(vrt.bands.get(1).pixels.get(1, 0), 1)
+      })
+    })
+    it('should stop when aborted while running', () =>
+      abortWhileRunning((o) => gdal.buildVRTAsync('', new Array(2000).fill(`${__dirname}/data/sample.tif`), [], o))
+    )
+  })
+
+  describe('gdal.vectorTranslateAsync()', () => {
+    it('should resolve with the new Dataset and report progress', () => {
+      const src = gdal.open(`${__dirname}/data/park.geo.json`)
+      const progress = []
+      return gdal.vectorTranslateAsync('', src, [ '-f', 'Memory' ], {
+        progress_cb: (r) => progress.push(r)
+      }).then((out) => {
+        assert.instanceOf(out, gdal.Dataset)
+        assert.equal(out.layers.get(0).features.count(), src.layers.get(0).features.count())
+        assert.isAbove(progress.length, 0)
+      })
+    })
+    it('should stop when aborted while running', () => {
+      const src = gdal.open('temp', 'w', 'Memory')
+      const lyr = src.layers.create('temp', null, gdal.Point)
+      lyr.fields.add(new gdal.FieldDefn('id', gdal.OFTInteger))
+      lyr.features.addBatch({ fields: { id: new Int32Array(200000) } })
+      return abortWhileRunning((o) => gdal.vectorTranslateAsync('', src, [ '-f', 'Memory' ], o)).then(() => {
+        assert.equal(lyr.features.count(), 200000)
+      })
+    })
+  })
+
+  describe('gdal.demAsync()', () => {
+    it('should resolve with the new Dataset', () => {
+      const src = gdal.open(`${__dirname}/data/sample.tif`)
+      return gdal.demAsync('', src, 'aspect', [ '-of', 'MEM' ]).then((out) => {
+        assert.instanceOf(out, gdal.Dataset)
+        assert.equal(out.bands.get(1).dataType, gdal.GDT_Float32)
+      })
+    })
+    it('should stop when aborted while running', () => {
+      const src = createBand(4096).ds
+      return abortWhileRunning((o) => gdal.demAsync('', src, 'roughness', [ '-of', 'MEM' ], o)).then(() => {
+        assert.equal(src.bands.get(1).pixels.get(1, 0), 1)
+      })
+    })
+  })
+
+  describe('gdal.demWindowAsync()', () => {
+    it('should resolve with the TypedArray', () => {
+      const src = gdal.open(`${__dirname}/data/sample.tif`)
+      return gdal.demWindowAsync(src.bands.get(1), 'hillshade', 0, 0, 16, 16, [ '-compute_edges' ]).then((tile) => {
+        assert.instanceOf(tile, Uint8Array)
+        assert.lengthOf(tile, 16 * 16)
+      })
+    })
+    it('should stop when aborted while running', () => {
+      const band = createBand(4096)
+      return abortWhileRunning((o) => gdal.demWindowAsync(band, 'hillshade', 0, 0, 4096, 4096, [], o)).then(() => {
+        assert.equal(band.pixels.get(1, 0), 1)
+      })
+    })
+  })
+
+  describe('gdal.Dataset.buildOverviewsAsync()', () => {
+    it('should build the overviews', () => {
+      const file = `${__dirname}/data/temp/overviews.${String(Math.random()).substring(2)}.tmp.tif`
+      const ds = gdal.open(file, 'w', 'GTiff', 64, 64, 1)
+      return ds.buildOverviewsAsync('NEAREST', [ 2, 4 ]).then(() => {
+        assert.equal(ds.bands.get(1).overviews.count(), 2)
+        ds.close()
+      })
+    })
+    it('should accept a callback when the optional parameters are omitted', (done) => {
+      const file = `${__dirname}/data/temp/overviews.${String(Math.random()).substring(2)}.tmp.tif`
+      const ds = gdal.open(file, 'w', 'GTiff', 64, 64, 1)
+      ds.buildOverviewsAsync('NEAREST', [ 2 ], (err) => {
+        try {
+          assert.isUndefined(err)
+          assert.equal(ds.bands.get(1).overviews.count(), 1)
+          ds.close()
+          done()
+        } catch (e) {
+          done(e)
+        }
+      })
+    })
+    it('should stop when aborted while running', () => {
+      const file = `${__dirname}/data/temp/overviews.${String(Math.random()).substring(2)}.tmp.tif`
+      const ds = gdal.open(file, 'w', 'GTiff', 4096, 4096, 1)
+      ds.bands.get(1).pixels.write(0, 0, 4096, 4096, createBand(4096).pixels.read(0, 0, 4096, 4096))
+      return abortWhileRunning((o) => ds.buildOverviewsAsync('CUBIC', [ 2, 4, 8, 16 ], undefined, o)).then(() => {
+        assert.equal(ds.bands.get(1).pixels.get(1, 0), 1)
+        ds.close()
+      })
+    })
+  })
+
+  describe('gdal.Dataset.rasterIOAsync()', () => {
+    const createRGB = () => {
+      const ds = gdal.open('temp', 'w', 'MEM', 64, 64, 3, gdal.GDT_Byte)
+      ds.bands.forEach((band) => {
+        band.fill(band.id * 10)
+      })
+      return ds
+    }
+    it('should return the pixel-interleaved data', () => {
+      const ds = createRGB()
+      return ds.rasterIOAsync(0, 0, 64, 64).then((data) => {
+        assert.instanceOf(data, Uint8Array)
+        assert.equal(data.length, 64 * 64 * 3)
+        assert.deepEqual(Array.from(data.subarray(data.length - 3)), [ 10, 20, 30 ])
+      })
+    })
+    it('should accept a callback when the optional parameters are omitted', (done) => {
+      const ds = createRGB()
+      const data = new Uint8Array(4 * 4 * 3)
+      ds.rasterIOAsync(0, 0, 4, 4, data, (err, result) => {
+        try {
+          assert.isUndefined(err)
+          assert.equal(result, data)
+          assert.equal(data[1], 20)
+          done()
+        } catch (e) {
+          done(e)
+        }
+      })
+    })
+    it('should stop when aborted while running', () => {
+      const file = `${__dirname}/data/temp/rasterio.${String(Math.random()).substring(2)}.tmp.tif`
+      const data = createBand(4096).pixels.read(0, 0, 4096, 4096)
+      const created = gdal.drivers.get('GTiff').create(file, 4096, 4096, 3, gdal.GDT_Byte, [ 'COMPRESS=DEFLATE' ])
+      created.bands.forEach((band) => band.pixels.write(0, 0, 4096, 4096, data))
+      created.close()
+      // reopened to read the compressed blocks instead of the block cache
+      const ds = gdal.open(file)
+      return abortWhileRunning((o) => ds.rasterIOAsync(0, 0, 4096, 4096, null, o)).then(() => {
+        assert.equal(ds.bands.get(3).pixels.get(1, 0), 1)
+        ds.close()
+      })
+    })
+  })
+
+  describe('gdal.RasterBand.computeStatisticsAsync()', () => {
+    it('should return the statistics', () => {
+      const band = createBand(64)
+      return band.computeStatisticsAsync(false).then((stats) => {
+        const sync = band.computeStatistics(false)
+        assert.deepEqual(stats, sync)
+        assert.equal(stats.min, 0)
+        assert.equal(stats.max, 250)
+      })
+    })
+    it('should accept a callback', (done) => {
+      const band = createBand(64)
+      band.computeStatisticsAsync(false, (err, stats) => {
+        try {
+          assert.isUndefined(err)
+          assert.equal(stats.max, 250)
+          done()
+        } catch (e) {
+          done(e)
+        }
+      })
+    })
+    it('should stop when aborted while running', () => {
+      const band = createBand(4096)
+      return abortWhileRunning((o) => band.computeStatisticsAsync(false, o)).then(() => {
+        assert.equal(band.pixels.get(1, 0), 1)
+      })
+    })
+    it('should be cancellable while running', () => {
+      const band = createBand(4096)
+      const signal = createSignal()
+      const p = band.computeStatisticsAsync(false, { signal })
+      signal.abort()
+      return expect(p).to.be.rejected.then((err) => {
+        assert.equal(err.name, 'AbortError')
+      })
+    })
+  })
+
+  describe('gdal.RasterBand.getHistogramAsync()', () => {
+    it('should return the histogram', () => {
+      const band = createBand(64)
+      return band.getHistogramAsync({ buckets: 251, min: -0.5, max: 250.5 }).then((histogram) => {
+        assert.deepEqual(histogram, band.getHistogram({ buckets: 251, min: -0.5, max: 250.5 }))
+        assert.lengthOf(histogram.buckets, 251)
+        assert.equal(histogram.buckets.reduce((a, b) => a + b), 64 * 64)
+      })
+    })
+    it('should accept a callback', (done) => {
+      const band = createBand(64)
+      band.getHistogramAsync((err, histogram) => {
+        try {
+          assert.isUndefined(err)
+          assert.lengthOf(histogram.buckets, 256)
+          done()
+        } catch (e) {
+          done(e)
+        }
+      })
+    })
+    it('should stop when aborted while running', () => {
+      const band = createBand(4096)
+      return abortWhileRunning((o) => band.getHistogramAsync(o)).then(() => {
+        assert.equal(band.pixels.get(1, 0), 1)
+      })
+    })
+  })
+
+  describe('gdal.RasterBand.getDefaultHistogramAsync()', () => {
+    it('should compute the default histogram', () => {
+      const band = createBand(64)
+      const progress = []
+      return band.getDefaultHistogramAsync({ progress_cb: (r) => progress.push(r) }).then((histogram) => {
+        assert.lengthOf(histogram.buckets, 256)
+        assert.equal(histogram.buckets[0], band.getHistogram().buckets[0])
+        assert.isAbove(progress.length, 0)
+      })
+    })
+    it('should stop when aborted while running', () => {
+      const band = createBand(4096)
+      return abortWhileRunning((o) => band.getDefaultHistogramAsync(o)).then(() => {
+        assert.equal(band.pixels.get(1, 0), 1)
+      })
+    })
+  })
+
+  describe('gdal.zonalStatsAsync()', () => {
+    let ds, band, vector, lyr
+    beforeEach(() => {
+      ds = gdal.open('temp', 'w', 'MEM', 64, 64, 1, gdal.GDT_Byte)
+      ds.geoTransform = [ 0, 1, 0, 64, 0, -1 ]
+      band = ds.bands.get(1)
+      band.fill(3)
+      vector = gdal.open('temp', 'w', 'Memory')
+      lyr = vector.layers.create('zones', null, gdal.Polygon)
+      for (let i = 0; i < 8; i++) {
+        const feature = new gdal.Feature(lyr)
+        const x0 = i * 8
+        const x1 = x0 + 8
+        feature.setGeometry(gdal.Geometry.fromWKT(`POLYGON ((${x0} 0,${x0} 8,${x1} 8,${x1} 0,${x0} 0))`))
+        lyr.features.add(feature)
+      }
+    })
+    it('should resolve with the statistics and report progress', () => {
+      const progress = []
+      return gdal.zonalStatsAsync(band, lyr, { threads: 2, progress_cb: (r) => progress.push(r) }).then((stats) => {
+        assert.lengthOf(stats, 8)
+        stats.forEach((s) => assert.deepInclude(s, { count: 64, sum: 192, mean: 3 }))
+        assert.isAbove(progress.length, 0)
+      })
+    })
+    it('should stop when aborted while running', () => {
+      const big = gdal.open('temp', 'w', 'MEM', 4096, 4096, 1, gdal.GDT_Byte)
+      big.geoTransform = [ 0, 1, 0, 4096, 0, -1 ]
+      const zones = vector.layers.create('big', null, gdal.Polygon)
+      const features = []
+      for (let y = 0; y < 4096; y += 128) {
+        for (let x = 0; x < 4096; x += 128) {
+          features.push({ geometry: gdal.Geometry.fromWKT(
+            `POLYGON ((${x} ${y},${x} ${y + 128},${x + 128} ${y + 128},${x + 128} ${y},${x} ${y}))`) })
+        }
+      }
+      zones.features.addBatch(features)
+      return abortWhileRunning((o) => gdal.zonalStatsAsync(big.bands.get(1), zones, o)).then(() => {
+        assert.equal(zones.features.count(), 1024)
+        big.bands.get(1).pixels.get(0, 0)
+      })
+    })
+  })
+
+  describe('gdal.calcAsync()', () => {
+    it('should compute the band and report progress', () => {
+      const ds = gdal.open('temp', 'w', 'MEM', 512, 512, 2, gdal.GDT_Float32)
+      ds.bands.get(1).fill(3)
+      const progress = []
+      return gdal.calcAsync({ a: ds.bands.get(1) }, 'a * 2', ds.bands.get(2), {
+        threads: 2,
+        progress_cb: (r) => progress.push(r)
+      }).then(() => {
+        assert.equal(ds.bands.get(2).pixels.get(100, 100), 6)
+        assert.isAbove(progress.length, 0)
+      })
+    })
+    it('should stop when aborted while running', () => {
+      const ds = gdal.open('temp', 'w', 'MEM', 4096, 4096, 2, gdal.GDT_Float32)
+      ds.bands.get(1).fill(3)
+      return abortWhileRunning((o) => gdal.calcAsync({ a: ds.bands.get(1) }, 'a * 2 + a / 3', ds.bands.get(2), o))
+        .then(() => {
+          assert.equal(ds.bands.get(1).pixels.get(0, 0), 3)
+        })
+    })
+  })
+
+  describe('gdal.rasterizeAsync()', () => {
+    let ds, vector, lyr
+    beforeEach(() => {
+      ds = gdal.open('temp', 'w', 'MEM', 256, 256, 1, gdal.GDT_Byte)
+      ds.geoTransform = [ 0, 1, 0, 256, 0, -1 ]
+      vector = gdal.open('temp', 'w', 'Memory')
+      lyr = vector.layers.create('zones', null, gdal.Polygon)
+      const feature = new gdal.Feature(lyr)
+      feature.setGeometry(gdal.Geometry.fromWKT('POLYGON ((0 0,0 128,128 128,128 0,0 0))'))
+      lyr.features.add(feature)
+    })
+    it('should burn the geometries and report progress', () => {
+      const progress = []
+      return gdal.rasterizeAsync(ds, lyr, { burnValues: [ 9 ], progress_cb: (r) => progress.push(r) }).then(() => {
+        assert.equal(ds.bands.get(1).pixels.get(10, 200), 9)
+        assert.equal(ds.bands.get(1).pixels.get(200, 10), 0)
+        assert.isAbove(progress.length, 0)
+      })
+    })
+    it('should keep the layers alive when the array is emptied', () => {
+      const layers = [ (() => {
+        const other = gdal.open('temp', 'w', 'Memory').layers.create('zones', null, gdal.Polygon)
+        const feature = new gdal.Feature(other)
+        feature.setGeometry(gdal.Geometry.fromWKT('POLYGON ((0 0,0 128,128 128,128 0,0 0))'))
+        other.features.add(feature)
+        return other
+      })() ]
+      const done = gdal.rasterizeAsync(ds, layers, { burnValues: [ 5 ] })
+      layers.length = 0
+      gc()
+      return done.then(() => {
+        assert.equal(ds.bands.get(1).pixels.get(10, 200), 5)
+      })
+    })
+    it('should stop when aborted while running', () => {
+      const big = gdal.open('temp', 'w', 'MEM', 4096, 4096, 1, gdal.GDT_Byte)
+      big.geoTransform = [ 0, 1, 0, 4096, 0, -1 ]
+      const features = []
+      for (let i = 0; i < 4096; i += 4) {
+        features.push({ geometry: gdal.Geometry.fromWKT(`POLYGON ((0 ${i},${i} 4096,4096 ${4096 - i},0 ${i}))`) })
+      }
+      lyr.features.addBatch(features)
+      return abortWhileRunning((o) => gdal.rasterizeAsync(big, lyr, Object.assign({ allTouched: true }, o)))
+        .then(() => {
+          big.bands.get(1).pixels.get(0, 0)
+        })
+    })
+  })
+
+  describe('gdal.gridAsync()', () => {
+    const points = new Float64Array([ 0, 0, 1, 100, 0, 2, 0, 100, 3, 100, 100, 4, 50, 50, 5 ])
+    const options = { algorithm: 'invdist', size: { x: 128, y: 128 }, bounds: [ 0, 0, 100, 100 ] }
+    it('should interpolate the points and report progress', () => {
+      const progress = []
+      return gdal.gridAsync(points, Object.assign({ progress_cb: (r) => progress.push(r) }, options)).then((ds) => {
+        assert.instanceOf(ds, gdal.Dataset)
+        assert.equal(ds.rasterSize.x, 128)
+        assert.isAbove(progress.length, 0)
+        ds.close()
+      })
+    })
+    it('should stop when aborted while running', () => {
+      const many = new Float64Array(3 * 2000)
+      for (let i = 0; i < many.length; i++) many[i] = (i * 7919) % 100
+      return abortWhileRunning((o) =>
+        gdal.gridAsync(many, Object.assign({}, options, { size: { x: 512, y: 512 } }, o)))
+    })
+  })
+
+  describe('gdal.buildTilePyramidAsync()', () => {
+    let src
+    beforeEach(() => {
+      src = gdal.open('temp', 'w', 'MEM', 1024, 1024, 3, gdal.GDT_Byte)
+      src.srs = gdal.SpatialReference.fromEPSG(4326)
+      src.geoTransform = [ 2, 0.001, 0, 49, 0, -0.001 ]
+    })
+    const tempName = () => `${__dirname}/data/temp/tiles.${String(Math.random()).substring(2)}.tmp`
+    it('should write the tiles and report progress', () => {
+      const progress = []
+      const output = tempName()
+      return gdal.buildTilePyramidAsync(src, { minZoom: 6, maxZoom: 9, output, threads: 4,
+        progress_cb: (r) => progress.push(r) }).then(() => {
+        assert.isTrue(fs.existsSync(`${output}/9`))
+        assert.isAbove(progress.length, 0)
+        assert.equal(progress[progress.length - 1], 1)
+      })
+    })
+    it('should stop when aborted while running', () => {
+      const output = tempName()
+      return abortWhileRunning((o) =>
+        gdal.buildTilePyramidAsync(src, Object.assign({ maxZoom: 12, output, threads: 2 }, o))
+      ).then(() => {
+        src.bands.get(1).pixels.get(0, 0)
+      })
+    })
+  })
+})
@@ -31,4 +31,78 @@ describe('gdal.CoordinateTransformation', () => {
     assert.closeTo(pt.x, 1564201.4044502454, 0.1)
     assert.closeTo(pt.y, 3370263.469590679, 0.1)
   })
+  describe('transformArrays()', () => {
+    const create = () => new gdal.CoordinateTransformation(
+      gdal.SpatialReference.fromProj4('+init=epsg:4326'),
+      gdal.SpatialReference.fromProj4('+init=epsg:32632')
+    )
+    it('should transform the arrays in place', () => {
+      const ct = create()
+      const xs = new Float64Array([ 20, 10 ])
+      const ys = new Float64Array([ 30, 45 ])
+      const mask = ct.transformArrays(xs, ys)
+      assert.instanceOf(mask, Uint8Array)
+      assert.deepEqual(Array.from(mask), [ 1, 1 ])
+      const expected = ct.transformPoint(10, 45)
+      assert.closeTo(xs[0], 1564201.4044502454, 0.1)
+      assert.closeTo(ys[0], 3370263.469590679, 0.1)
+      assert.closeTo(xs[1], expected.x, 1e-6)
+      assert.closeTo(ys[1], expected.y, 1e-6)
+    })
+    it('should give the same results with several threads', () => {
+      const ct = create()
+      const n = 200000
+      const xs = new Float64Array(n), ys = new Float64Array(n), zs = new Float64Array(n)
+      for (let i = 0; i < n; i++) {
+        xs[i] = 5 + (i % 100) / 10
+        ys[i] = 40 + (i % 300) / 30
+      }
+      const xs2 = xs.slice(), ys2 = ys.slice()
+      ct.transformArrays(xs, ys, zs)
+      const mask = ct.transformArrays(xs2, ys2, undefined, { threads: 4 })
+      assert.equal(mask.length, n)
+      assert.isTrue(mask.every((v) => v === 1))
+      assert.deepEqual(xs2, xs)
+      assert.deepEqual(ys2, ys)
+    })
+    it('should throw on invalid arguments', () => {
+      const ct = create()
+      assert.throws(() => ct.transformArrays([ 1 ], [ 2 ]), /Float64Array/)
+      assert.throws(() => ct.transformArrays(new Float64Array(2), new Float64Array(3)), /same length/)
+      assert.throws(() => ct.transformArrays(new Float64Array(2), new Float64Array(2), null, { threads: 0 }),
+        /threads/)
+    })
+  })
+  describe('transformInterleaved()', () => {
+    const create = () => new gdal.CoordinateTransformation(
+      gdal.SpatialReference.fromProj4('+init=epsg:4326'),
+      gdal.SpatialReference.fromProj4('+init=epsg:32632')
+    )
+    it('should transform 2D coordinates in place', () => {
+      const ct = create()
+      const coords = new Float64Array([ 20, 30, 10, 45 ])
+      const mask = ct.transformInterleaved(coords)
+      assert.deepEqual(Array.from(mask), [ 1, 1 ])
+      const expected = ct.transformPoint(10, 45)
+      assert.closeTo(coords[0], 1564201.4044502454, 0.1)
+      assert.closeTo(coords[1], 3370263.469590679, 0.1)
+      assert.closeTo(coords[2], expected.x, 1e-6)
+      assert.closeTo(coords[3], expected.y, 1e-6)
+    })
+    it('should transform 3D coordinates in place', () => {
+      const ct = create()
+      const coords = new Float64Array([ 20, 30, 100, 10, 45, 200 ])
+      const mask = ct.transformInterleaved(coords, 3, { threads: 2 })
+      assert.deepEqual(Array.from(mask), [ 1, 1 ])
+      assert.closeTo(coords[0], 1564201.4044502454, 0.1)
+      assert.closeTo(coords[1], 3370263.469590679, 0.1)
+      assert.closeTo(coords[2], 100, 1e-6)
+      assert.closeTo(coords[5], 200, 1e-6)
+    })
+    it('should throw on invalid dimensions', () => {
+      const ct = create()
+      assert.throws(() => ct.transformInterleaved(new Float64Array(4), 4), /dimensions/)
+      assert.throws(() => ct.transformInterleaved(new Float64Array(5), 2), /multiple/)
+    })
+  })
 })
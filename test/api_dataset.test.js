@@ -668,6 +668,65 @@ describe('gdal.Dataset', () => {
         })
       })
     })
+    describe('rasterIO()', () => {
+      const createRGB = () => {
+        const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 3, gdal.GDT_Byte)
+        ds.bands.forEach((band) => {
+          band.fill(band.id * 10)
+        })
+        return ds
+      }
+      it('should return a pixel-interleaved TypedArray', () => {
+        const ds = createRGB()
+        const data = ds.rasterIO(0, 0, 4, 2)
+        assert.instanceOf(data, Uint8Array)
+        assert.equal(data.length, 4 * 2 * 3)
+        assert.deepEqual(Array.from(data.subarray(0, 6)), [ 10, 20, 30, 10, 20, 30 ])
+      })
+      it('should read the given bands in the given order', () => {
+        const ds = createRGB()
+        const data = ds.rasterIO(0, 0, 2, 2, null, { bands: [ 3, 1 ] })
+        assert.equal(data.length, 2 * 2 * 2)
+        assert.deepEqual(Array.from(data.subarray(0, 4)), [ 30, 10, 30, 10 ])
+      })
+      it('should support band-sequential spacing', () => {
+        const ds = createRGB()
+        const data = ds.rasterIO(0, 0, 2, 2, null, { pixel_space: 1, line_space: 2, band_space: 4 })
+        assert.deepEqual(Array.from(data), [ 10, 10, 10, 10, 20, 20, 20, 20, 30, 30, 30, 30 ])
+      })
+      it('should convert to the given data type', () => {
+        const ds = createRGB()
+        const data = ds.rasterIO(0, 0, 2, 2, null, { data_type: gdal.GDT_Float32 })
+        assert.instanceOf(data, Float32Array)
+        assert.equal(data[2], 30)
+      })
+      it('should read in place into a SharedArrayBuffer at the given offset', () => {
+        const ds = createRGB()
+        const shared = new SharedArrayBuffer(8 + 2 * 2 * 3)
+        const data = ds.rasterIO(0, 0, 2, 2, shared, { offset: 8 })
+        assert.equal(data.buffer, shared)
+        assert.deepEqual(Array.from(new Uint8Array(shared, 8, 3)), [ 10, 20, 30 ])
+      })
+      it('should throw if the array is too small', () => {
+        const ds = createRGB()
+        assert.throws(() => {
+          ds.rasterIO(0, 0, 4, 4, new Uint8Array(4 * 4 * 2))
+        }, /Array length must be greater than.*/)
+      })
+      it('should throw if invalid band given', () => {
+        const ds = createRGB()
+        assert.throws(() => {
+          ds.rasterIO(0, 0, 4, 4, null, { bands: [ 4 ] })
+        }, /invalid band id/)
+      })
+      it('should throw if dataset already closed', () => {
+        const ds = createRGB()
+        ds.close()
+        assert.throws(() => {
+          ds.rasterIO(0, 0, 4, 4)
+        })
+      })
+    })
   })
   describe('setGCPs()', () => {
     it('should update gcps', () => {
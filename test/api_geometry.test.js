@@ -34,6 +34,65 @@ describe('gdal.Geometry', () => {
         coordinates: [ 1, 2, 3 ]
       })
     })
+    it('should return the same result as toJSON() for all geometry types', () => {
+      [
+        'LINESTRING (0 0,1 1,2 0)',
+        'LINESTRING (0 0 1,1 1 2)',
+        'POLYGON ((0 0,10 0,10 10,0 10,0 0),(1 1,2 1,2 2,1 1))',
+        'POLYGON EMPTY',
+        'MULTIPOINT (0 0,1 1)',
+        'MULTILINESTRING ((0 0,1 1),(2 2,3 3))',
+        'MULTIPOLYGON (((0 0,1 0,1 1,0 0)),((5 5,6 5,6 6,5 5)))',
+        'GEOMETRYCOLLECTION (POINT (1 2),LINESTRING (0 0,1 1),GEOMETRYCOLLECTION (POINT (3 4)))'
+      ].forEach((wkt) => {
+        const geom = gdal.Geometry.fromWKT(wkt)
+        assert.deepEqual(geom.toObject(), JSON.parse(geom.toJSON()), wkt)
+      })
+    })
+    it('should return null for an empty point', () => {
+      assert.isNull(new gdal.Point().toObject())
+    })
+  })
+  describe('fromGeoJsonObject()', () => {
+    it('should return valid result', () => {
+      const point2d = gdal.Geometry.fromGeoJsonObject({ type: 'Point', coordinates: [ 2, 1 ] })
+      assert.instanceOf(point2d, gdal.Point)
+      assert.equal(point2d.x, 2)
+      assert.equal(point2d.y, 1)
+      const point3d = gdal.Geometry.fromGeoJsonObject({ type: 'Point', coordinates: [ 2, 1, 3 ] })
+      assert.equal(point3d.wkbType, gdal.wkbPoint25D)
+      assert.equal(point3d.z, 3)
+    })
+    it('should be the inverse of toObject() for all geometry types', () => {
+      [
+        'LINESTRING (0 0,1 1,2 0)',
+        'LINESTRING Z (0 0 1,1 1 2)',
+        'POLYGON ((0 0,10 0,10 10,0 10,0 0),(1 1,2 1,2 2,1 1))',
+        'MULTIPOINT (0 0,1 1)',
+        'MULTILINESTRING ((0 0,1 1),(2 2,3 3))',
+        'MULTIPOLYGON (((0 0,1 0,1 1,0 0)),((5 5,6 5,6 6,5 5)))',
+        'GEOMETRYCOLLECTION (POINT (1 2),LINESTRING (0 0,1 1),GEOMETRYCOLLECTION (POINT (3 4)))'
+      ].forEach((wkt) => {
+        const geom = gdal.Geometry.fromWKT(wkt)
+        const result = gdal.Geometry.fromGeoJsonObject(geom.toObject())
+        assert.equal(result.wkbType, geom.wkbType, wkt)
+        assert.equal(result.toWKT(), geom.toWKT())
+      })
+    })
+    it('should throw on invalid GeoJSON', () => {
+      assert.throws(() => {
+        gdal.Geometry.fromGeoJsonObject({ type: 'Curve', coordinates: [] })
+      }, /unsupported geometry type/)
+      assert.throws(() => {
+        gdal.Geometry.fromGeoJsonObject({ type: 'LineString', coordinates: [ [ 0, 0 ], [ 1 ] ] })
+      }, /at least two elements/)
+      assert.throws(() => {
+        gdal.Geometry.fromGeoJsonObject({ type: 'Polygon', coordinates: [ [ [ 0, 'a' ] ] ] })
+      }, /must be numbers/)
+      assert.throws(() => {
+        gdal.Geometry.fromGeoJsonObject({ type: 'GeometryCollection' })
+      }, /geometries must be an array/)
+    })
   })
   describe('toKML()', () => {
     it('should return valid result', () => {
@@ -226,6 +285,43 @@ describe('gdal.Geometry', () => {
           assert.equal(point_outer.intersects(square), false)
         })
       })
+      describe('prepare()', () => {
+        it('should return a PreparedGeometry', () => {
+          assert.instanceOf(square.prepare(), gdal.PreparedGeometry)
+        })
+        it('should give the same results as the unprepared predicates', () => {
+          const prepared = square.prepare()
+          assert.equal(prepared.contains(point_inner), true)
+          assert.equal(prepared.contains(point_outer), false)
+          assert.equal(prepared.intersects(point_inner), true)
+          assert.equal(prepared.intersects(point_outer), false)
+          assert.equal(prepared.contains(new gdal.Point(10, 5)), false)
+          assert.equal(prepared.intersects(new gdal.Point(10, 5)), true)
+        })
+        it('should test batches of points', () => {
+          const prepared = square.prepare()
+          const points = new Float64Array([ 5, 5, 0, 20, 10, 5, -1, -1 ])
+          const intersects = prepared.intersectsPoints(points)
+          assert.instanceOf(intersects, Uint8Array)
+          assert.deepEqual(Array.from(intersects), [ 1, 0, 1, 0 ])
+          assert.deepEqual(Array.from(prepared.containsPoints(points)), [ 1, 0, 0, 0 ])
+          assert.deepEqual(Array.from(prepared.containsPoints(new Float64Array([ 5, 5, 1, 0, 20, 2 ]), 3)), [ 1, 0 ])
+        })
+        it('should throw on invalid points', () => {
+          const prepared = square.prepare()
+          assert.throws(() => prepared.intersectsPoints([ 5, 5 ]), /Float64Array/)
+          assert.throws(() => prepared.intersectsPoints(new Float64Array(3)), /multiple/)
+        })
+        it('should not be affected by later changes to the geometry', () => {
+          const geom = square.clone()
+          const prepared = geom.prepare()
+          geom.empty()
+          assert.equal(prepared.contains(point_inner), true)
+        })
+        it('should not be constructable directly', () => {
+          assert.throws(() => new gdal.PreparedGeometry(), /prepare/)
+        })
+      })
       describe('equals()', () => {
         it('should return correct result', () => {
           assert.equal(point_inner.equals(square), false)
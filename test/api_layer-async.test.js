@@ -0,0 +1,77 @@
+const chaiAsPromised = require('chai-as-promised')
+const chai = require('chai')
+const assert = chai.assert
+const gdal = require('../lib/gdal.js')
+
+chai.use(chaiAsPromised)
+
+// Not supported on GDAL 1.x
+if (gdal.version.split('.')[0] < 2) {
+  return
+}
+
+describe('gdal.LayerFeatures', () => {
+  afterEach(gc)
+
+  describe('nextAsync()', () => {
+    it('should return an array of Features w/Promise', () => {
+      const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+      const layer = ds.layers.get(0)
+      return layer.features.nextAsync(2).then((features) => {
+        assert.isArray(features)
+        assert.lengthOf(features, 2)
+        assert.instanceOf(features[0], gdal.Feature)
+        assert.instanceOf(features[1], gdal.Feature)
+        assert.notEqual(features[0].fid, features[1].fid)
+      })
+    })
+    it('should return an array of Features w/cb', (done) => {
+      const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+      const layer = ds.layers.get(0)
+      layer.features.nextAsync((e, features) => {
+        try {
+          assert.isUndefined(e)
+          assert.lengthOf(features, 1)
+          assert.instanceOf(features[0], gdal.Feature)
+          done()
+        } catch (err) {
+          done(err)
+        }
+      })
+    })
+    it('should share the iterator with next()', () => {
+      const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+      const layer = ds.layers.get(0)
+      const f0 = layer.features.first()
+      return layer.features.nextAsync(1).then((features) => {
+        assert.equal(features[0].fid, f0.fid + 1)
+      })
+    })
+    it('should return all the features and then an empty array', () => {
+      const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+      const layer = ds.layers.get(0)
+      const count = layer.features.count()
+      return layer.features.nextAsync(count + 10).then((features) => {
+        assert.lengthOf(features, count)
+        return layer.features.nextAsync(10)
+      }).then((features) => {
+        assert.lengthOf(features, 0)
+      })
+    })
+    it('should throw error if count is not positive', () => {
+      const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+      const layer = ds.layers.get(0)
+      assert.throws(() => {
+        layer.features.nextAsync(0, () => undefined)
+      }, /count must be greater than 0/)
+    })
+    it('should throw error if dataset is destroyed', () => {
+      const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+      const layer = ds.layers.get(0)
+      ds.close()
+      assert.throws(() => {
+        layer.features.nextAsync(1, () => undefined)
+      }, /already destroyed/)
+    })
+  })
+})
@@ -1,6 +1,7 @@
 const gdal = require('../lib/gdal.js')
 const assert = require('chai').assert
 const fileUtils = require('./utils/file.js')
+const fs = require('fs')
 
 describe('gdal.Layer', () => {
   afterEach(gc)
@@ -255,6 +256,90 @@ describe('gdal.Layer', () => {
       })
     })
 
+    describe('buildSpatialIndex()', () => {
+      const intersects = (a, b) => a.minX <= b.maxX && a.maxX >= b.minX && a.minY <= b.maxY && a.maxY >= b.minY
+      const bruteForce = (layer, envelope) => {
+        const fids = []
+        layer.features.forEach((f) => {
+          const geom = f.getGeometry()
+          if (geom && intersects(geom.getEnvelope(), envelope)) fids.push(f.fid)
+        })
+        return fids.sort((a, b) => a - b)
+      }
+      const envelopes = [
+        { minX: -111, minY: 41, maxX: -104, maxY: 43 },
+        { minX: -108, minY: 42, maxX: -107.5, maxY: 42.5 },
+        { minX: -110.2, minY: 44.1, maxX: -110.1, maxY: 44.2 },
+        { minX: 0, minY: 0, maxX: 1, maxY: 1 }
+      ]
+      it('should index all the features', () => {
+        prepare_dataset_layer_test('r', (dataset, layer) => {
+          assert.equal(layer.buildSpatialIndex(), layer.features.count())
+        })
+      })
+      it('should return the same ids as a full scan', () => {
+        prepare_dataset_layer_test('r', (dataset, layer) => {
+          layer.buildSpatialIndex({ node_size: 4 })
+          envelopes.forEach((envelope) => {
+            const fids = layer.query(new gdal.Envelope(envelope)).sort((a, b) => a - b)
+            assert.deepEqual(fids, bruteForce(layer, envelope))
+          })
+          assert.lengthOf(layer.query(envelopes[3]), 0)
+        })
+      })
+      it('should return features', () => {
+        prepare_dataset_layer_test('r', (dataset, layer) => {
+          layer.buildSpatialIndex()
+          const features = layer.query(envelopes[1], { features: true })
+          assert.isAbove(features.length, 0)
+          features.forEach((f) => {
+            assert.instanceOf(f, gdal.Feature)
+            assert.isTrue(intersects(f.getGeometry().getEnvelope(), envelopes[1]))
+          })
+        })
+      })
+      it('should be saved and loaded', () => {
+        prepare_dataset_layer_test('r', (dataset, layer) => {
+          const file = `${__dirname}/data/temp/spatial_index.${String(Math.random()).substring(2)}.tmp.idx`
+          const count = layer.buildSpatialIndex()
+          const expected = layer.query(envelopes[0]).sort((a, b) => a - b)
+          layer.saveSpatialIndex(file)
+          const layer2 = gdal.open(dataset.description).layers.get(0)
+          assert.equal(layer2.loadSpatialIndex(file), count)
+          assert.deepEqual(layer2.query(envelopes[0]).sort((a, b) => a - b), expected)
+          fs.unlinkSync(file)
+        })
+      })
+      it('should throw when loading an invalid file', () => {
+        prepare_dataset_layer_test('r', (dataset, layer) => {
+          assert.throws(() => {
+            layer.loadSpatialIndex(`${__dirname}/data/park.geo.json`)
+          }, /Failed to load/)
+        })
+      })
+      it('should restart the reading of the layer', () => {
+        prepare_dataset_layer_test('r', (dataset, layer) => {
+          const first = layer.features.first().fid
+          layer.features.next()
+          layer.buildSpatialIndex()
+          assert.equal(layer.features.next().fid, first)
+        })
+      })
+      it('should be dropped when a feature is added', () => {
+        prepare_dataset_layer_test('w', (dataset, layer) => {
+          const feature = new gdal.Feature(layer)
+          feature.setGeometry(new gdal.Point(1, 2))
+          layer.features.add(feature)
+          layer.buildSpatialIndex()
+          assert.lengthOf(layer.query({ minX: 0, minY: 0, maxX: 2, maxY: 2 }), 1)
+          layer.features.add(feature)
+          assert.throws(() => {
+            layer.query({ minX: 0, minY: 0, maxX: 2, maxY: 2 })
+          }, /buildSpatialIndex/)
+        })
+      })
+    })
+
     describe('setSpatialFilter()', () => {
       it('should accept 4 numbers', () => {
         prepare_dataset_layer_test('r', (dataset, layer) => {
@@ -468,6 +553,114 @@ describe('gdal.Layer', () => {
           })
         })
       })
+      describe('readBatch()', () => {
+        it('should return the features in columnar form', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            const batch = layer.features.readBatch({ batchSize: 100 })
+            assert.equal(batch.count, layer.features.count())
+            assert.instanceOf(batch.fids, Float64Array)
+            assert.equal(batch.fids.length, batch.count)
+            assert.deepEqual(Object.keys(batch.fields), layer.fields.getNames())
+
+            const name = batch.fields.name
+            assert.equal(name.type, 'string')
+            assert.instanceOf(name.offsets, Uint32Array)
+            assert.equal(name.offsets.length, batch.count + 1)
+            assert.equal(name.valid.length, batch.count)
+
+            const geometry = batch.geometry
+            assert.equal(geometry.offsets.length, batch.count + 1)
+            for (let i = 0; i < batch.count; i++) {
+              const feature = layer.features.get(batch.fids[i])
+              assert.equal(
+                name.data.toString('utf8', name.offsets[i], name.offsets[i + 1]),
+                feature.fields.get('name')
+              )
+              assert.isTrue(
+                geometry.data
+                  .slice(geometry.offsets[i], geometry.offsets[i + 1])
+                  .equals(feature.getGeometry().toWKB('LSB'))
+              )
+            }
+          })
+        })
+        it('should share the iterator with next()', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            const count = layer.features.count()
+            layer.features.next()
+            const b1 = layer.features.readBatch({ batchSize: 5 })
+            assert.equal(b1.count, 5)
+            assert.equal(b1.fids[0], 1)
+            const b2 = layer.features.readBatch({ batchSize: count })
+            assert.equal(b2.count, count - 6)
+            assert.equal(b2.fids[0], 6)
+            assert.equal(layer.features.readBatch().count, 0)
+          })
+        })
+        it('should read everything with the largest batchSize', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            const count = layer.features.count()
+            layer.features.first()
+            const batch = layer.features.readBatch({ batchSize: 2147483647 })
+            assert.equal(batch.count, count - 1)
+            assert.equal(layer.features.readBatch().count, 0)
+          })
+        })
+        it('should only export the requested fields', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            const batch = layer.features.readBatch({
+              fields: [ 'state_abbr', 'name' ],
+              geometry: false
+            })
+            assert.deepEqual(Object.keys(batch.fields), [ 'state_abbr', 'name' ])
+            assert.isNull(batch.geometry)
+          })
+        })
+        it('should export numeric fields to TypedArrays', () => {
+          prepare_dataset_layer_test('w', (dataset, layer) => {
+            layer.fields.add(new gdal.FieldDefn('int', gdal.OFTInteger))
+            layer.fields.add(new gdal.FieldDefn('real', gdal.OFTReal))
+            for (let i = 0; i < 3; i++) {
+              const feature = new gdal.Feature(layer)
+              feature.fields.set({ int: i * 2, real: i + 0.5 })
+              feature.setGeometry(new gdal.Point(i, i))
+              layer.features.add(feature)
+            }
+            layer.features.first()
+            const batch = layer.features.readBatch()
+            assert.equal(batch.count, 3)
+            assert.equal(batch.fields.int.type, 'integer')
+            assert.instanceOf(batch.fields.int.data, Int32Array)
+            assert.deepEqual(Array.from(batch.fields.int.data), [ 0, 2, 4 ])
+            assert.equal(batch.fields.real.type, 'real')
+            assert.instanceOf(batch.fields.real.data, Float64Array)
+            assert.deepEqual(Array.from(batch.fields.real.data), [ 0.5, 1.5, 2.5 ])
+            assert.deepEqual(Array.from(batch.fields.real.valid), [ 1, 1, 1 ])
+          })
+        })
+        it('should throw error if a field does not exist', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            assert.throws(() => {
+              layer.features.readBatch({ fields: [ 'nope' ] })
+            }, /does not exist/)
+          })
+        })
+        it('should throw error if batchSize is not positive', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            assert.throws(() => {
+              layer.features.readBatch({ batchSize: 0 })
+            }, RangeError)
+          })
+        })
+        it('should throw error if dataset is destroyed', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            dataset.close()
+            assert.throws(() => {
+              layer.features.readBatch()
+            }, /already destroyed/)
+          })
+        })
+      })
       describe('forEach()', () => {
         it('should pass each feature to the callback', () => {
           prepare_dataset_layer_test('r', (dataset, layer) => {
@@ -529,6 +722,138 @@ describe('gdal.Layer', () => {
         })
       })
 
+      describe('addBatch()', () => {
+        const addFields = (layer) => {
+          layer.fields.add(new gdal.FieldDefn('name', gdal.OFTString))
+          layer.fields.add(new gdal.FieldDefn('int', gdal.OFTInteger))
+          layer.fields.add(new gdal.FieldDefn('real', gdal.OFTReal))
+        }
+        it('should add features from columns', () => {
+          prepare_dataset_layer_test('w', (dataset, layer) => {
+            addFields(layer)
+            const n = layer.features.addBatch({
+              fields: {
+                name: [ 'a', 'b', null ],
+                int: new Int32Array([ 1, 2, 3 ]),
+                real: new Float64Array([ 0.5, 1.5, 2.5 ])
+              },
+              geometry: [ new gdal.Point(0, 1), null, new gdal.Point(2, 3) ]
+            })
+            assert.equal(n, 3)
+            assert.equal(layer.features.count(), 3)
+            const f = layer.features.get(0)
+            assert.deepEqual(f.fields.toObject(), { name: 'a', int: 1, real: 0.5 })
+            assert.equal(f.getGeometry().x, 0)
+            assert.isNull(layer.features.get(1).getGeometry())
+            assert.isNull(layer.features.get(2).fields.get('name'))
+            assert.equal(layer.features.get(2).fields.get('int'), 3)
+          })
+        })
+        it('should add features from an array of objects', () => {
+          prepare_dataset_layer_test('w', (dataset, layer) => {
+            addFields(layer)
+            const n = layer.features.addBatch(
+              [
+                { name: 'a', int: 1, geometry: new gdal.Point(1, 2) },
+                { real: 2.5 },
+                { name: 'c', int: 3 }
+              ],
+              { transactionSize: 2 }
+            )
+            assert.equal(n, 3)
+            assert.equal(layer.features.count(), 3)
+            assert.equal(layer.features.get(0).fields.get('name'), 'a')
+            assert.equal(layer.features.get(0).getGeometry().y, 2)
+            assert.equal(layer.features.get(1).fields.get('real'), 2.5)
+            assert.equal(layer.features.get(2).fields.get('int'), 3)
+          })
+        })
+        it('should accept the output of readBatch()', () => {
+          prepare_dataset_layer_test('r', (src_dataset, src_layer) => {
+            const batch = src_layer.features.readBatch({
+              fields: [ 'name' ],
+              geometry: false
+            })
+            prepare_dataset_layer_test('w', (dataset, layer) => {
+              layer.fields.add(new gdal.FieldDefn('name', gdal.OFTString))
+              assert.equal(layer.features.addBatch(batch), batch.count)
+              assert.equal(layer.features.count(), src_layer.features.count())
+              const f = layer.features.get(3)
+              const src = src_layer.features.get(3)
+              assert.equal(f.fields.get('name'), src.fields.get('name'))
+            })
+          })
+        })
+        it('should throw error if a field does not exist', () => {
+          prepare_dataset_layer_test('w', (dataset, layer) => {
+            assert.throws(() => {
+              layer.features.addBatch({ fields: { nope: [ 1 ] } })
+            }, /does not exist/)
+          })
+        })
+        it('should throw error if a column is too short', () => {
+          prepare_dataset_layer_test('w', (dataset, layer) => {
+            addFields(layer)
+            assert.throws(() => {
+              layer.features.addBatch({ fields: { int: [ 1, 2 ], real: [ 1 ] } })
+            }, RangeError)
+          })
+        })
+        it('should throw error if layer doesnt support creating features', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            assert.throws(() => {
+              layer.features.addBatch([ { name: 'a' } ])
+            }, /read-only/)
+          })
+        })
+        it('should throw error if the offsets are not increasing or out of the data', () => {
+          prepare_dataset_layer_test('w', (dataset, layer) => {
+            addFields(layer)
+            const data = new Uint8Array(20)
+            assert.throws(() => {
+              layer.features.addBatch({ fields: { name: { offsets: new Uint32Array([ 0, 1000, 10 ]), data } } })
+            }, /Invalid column/)
+            assert.throws(() => {
+              layer.features.addBatch({ fields: { name: { offsets: new Uint32Array([ 0, 10, 21 ]), data } } })
+            }, /Invalid column/)
+            assert.throws(() => {
+              layer.features.addBatch({ geometry: { offsets: new Uint32Array([ 5, 0 ]), data } })
+            }, /Geometry column/)
+            assert.equal(layer.features.count(), 0)
+          })
+        })
+        it('should throw error if the geometry of a row is not a Geometry', () => {
+          prepare_dataset_layer_test('w', (dataset, layer) => {
+            addFields(layer)
+            assert.throws(() => {
+              layer.features.addBatch([ { name: 'a', geometry: 'POINT (0 0)' } ])
+            }, /must be a Geometry/)
+            assert.equal(layer.features.count(), 0)
+          })
+        })
+        it('should throw the exceptions of the getters', () => {
+          prepare_dataset_layer_test('w', (dataset, layer) => {
+            addFields(layer)
+            const row = { get name() {
+              throw new Error('getter error')
+            } }
+            assert.throws(() => {
+              layer.features.addBatch([ row ])
+            }, /getter error/)
+            assert.equal(layer.features.count(), 0)
+          })
+        })
+        it('should not deadlock if a getter uses the layer', () => {
+          prepare_dataset_layer_test('w', (dataset, layer) => {
+            addFields(layer)
+            const rows = [ 0, 1 ].map(() => ({ get int() {
+              return layer.features.count()
+            } }))
+            assert.equal(layer.features.addBatch(rows, { transactionSize: 1 }), 2)
+            assert.equal(layer.features.get(1).fields.get('int'), 1)
+          })
+        })
+      })
       describe('set()', () => {
         let f0, f1, f1_new, layer, dataset
         beforeEach(() => {
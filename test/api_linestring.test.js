@@ -181,6 +181,53 @@ describe('gdal.LineString', () => {
           assert.equal(pt.z, 3)
         })
       })
+      describe('setFromArray()', () => {
+        it('should replace the points with 2D coordinates', () => {
+          const line = new gdal.LineString()
+          line.points.add(5, 5, 5)
+          line.points.setFromArray(new Float64Array([ 0, 1, 2, 3, 4, 5 ]), 2)
+          assert.equal(line.points.count(), 3)
+          assert.equal(line.points.get(2).x, 4)
+          assert.equal(line.points.get(2).y, 5)
+          assert.equal(line.coordinateDimension, 2)
+        })
+        it('should replace the points with 3D coordinates', () => {
+          const line = new gdal.LineString()
+          line.points.setFromArray(new Float64Array([ 0, 1, 2, 3, 4, 5 ]), 3)
+          assert.equal(line.points.count(), 2)
+          const pt = line.points.get(1)
+          assert.equal(pt.x, 3)
+          assert.equal(pt.y, 4)
+          assert.equal(pt.z, 5)
+        })
+        it('should throw on invalid arguments', () => {
+          const line = new gdal.LineString()
+          assert.throws(() => line.points.setFromArray([ 0, 1 ]), /Float64Array/)
+          assert.throws(() => line.points.setFromArray(new Float64Array(3), 2), /multiple/)
+          assert.throws(() => line.points.setFromArray(new Float64Array(4), 4), /dimensions/)
+        })
+      })
+      describe('toArray()', () => {
+        it('should return the coordinates as a Float64Array', () => {
+          const line = new gdal.LineString()
+          line.points.add(1, 2, 3)
+          line.points.add(4, 5, 6)
+          const coords = line.points.toArray()
+          assert.instanceOf(coords, Float64Array)
+          assert.deepEqual(Array.from(coords), [ 1, 2, 3, 4, 5, 6 ])
+          assert.deepEqual(Array.from(line.points.toArray(2)), [ 1, 2, 4, 5 ])
+        })
+        it('should round-trip with setFromArray()', () => {
+          const n = 10000
+          const coords = new Float64Array(n * 2)
+          for (let i = 0; i < coords.length; i++) coords[i] = i / 3
+          const line = new gdal.LineString()
+          line.points.setFromArray(coords)
+          assert.equal(line.points.count(), n)
+          assert.deepEqual(line.points.toArray(), coords)
+          assert.deepEqual(Array.from(line.points.toArray(3).subarray(0, 6)), [ 0, 1 / 3, 0, 2 / 3, 1, 0 ])
+        })
+      })
       describe('resize()', () => {
         it('should adjust the number of points', () => {
           const line = new gdal.LineString()
@@ -81,6 +81,32 @@ describe('gdal.RasterBand', () => {
           })
         })
       })
+      describe('readAsync() on a read-only dataset', () => {
+        it('should return the same data as the synchronous reads when running in parallel', () => {
+          const ds = gdal.open(`${__dirname}/data/sample.tif`)
+          const band = ds.bands.get(1)
+          const windows = []
+          for (let i = 0; i < 16; i++) windows.push([ 40 * i, 30 * i, 64, 64 ])
+          const expected = windows.map((win) => band.pixels.read(win[0], win[1], win[2], win[3]))
+          return Promise.all(windows.map((win) => band.pixels.readAsync(win[0], win[1], win[2], win[3])))
+            .then((results) => {
+              results.forEach((data, i) => assert.deepEqual(data, expected[i]))
+            })
+        })
+        it('should read from several datasets opened on the same file', () => {
+          const ds1 = gdal.open(`${__dirname}/data/sample.tif`)
+          const ds2 = gdal.open(`${__dirname}/data/sample.tif`)
+          return Promise.all([
+            ds1.bands.get(1).pixels.readAsync(190, 290, 20, 30),
+            ds2.bands.get(1).pixels.readAsync(190, 290, 20, 30)
+          ]).then((results) => {
+            assert.deepEqual(results[0], results[1])
+            assert.equal(results[0][10 * 20 + 10], 10)
+            ds1.close()
+            ds2.close()
+          })
+        })
+      })
       describe('readAsync() w/Promise', () => {
         it('should return a TypedArray', () => {
           gdal.openAsync(`${__dirname}/data/sample.tif`).then((ds) => {
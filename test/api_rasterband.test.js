@@ -560,6 +560,83 @@ describe('gdal.RasterBand', () => {
             band.pixels.read(1, 1, 20, 30, data)
             assert.equal(data[0], 30)
           })
+          it('should read in place into a SharedArrayBuffer at the given offset and stride', () => {
+            const ds = gdal.open(
+              'temp',
+              'w',
+              'MEM',
+              256,
+              256,
+              1,
+              gdal.GDT_Int16
+            )
+            const band = ds.bands.get(1)
+            band.pixels.set(1, 1, 30)
+            band.pixels.set(2, 1, 40)
+            const shared = new SharedArrayBuffer(4 + 20 * 30 * 4)
+            const result = band.pixels.read(1, 1, 20, 30, shared, {
+              offset: 4,
+              pixel_space: 4
+            })
+            assert.instanceOf(result, Int16Array)
+            assert.equal(result.buffer, shared)
+            assert.equal(result.byteOffset, 4)
+            const view = new Int16Array(shared)
+            assert.equal(view[2], 30)
+            assert.equal(view[3], 0)
+            assert.equal(view[4], 40)
+          })
+          it('should use "data_type" when reading into an ArrayBuffer', () => {
+            const ds = gdal.open(
+              'temp',
+              'w',
+              'MEM',
+              256,
+              256,
+              1,
+              gdal.GDT_Byte
+            )
+            const band = ds.bands.get(1)
+            band.pixels.set(1, 1, 30)
+            const buffer = new ArrayBuffer(20 * 30 * 8)
+            const result = band.pixels.read(1, 1, 20, 30, buffer, {
+              data_type: gdal.GDT_Float64
+            })
+            assert.instanceOf(result, Float64Array)
+            assert.equal(new Float64Array(buffer)[0], 30)
+          })
+          it('should throw error if the offset is misaligned', () => {
+            const ds = gdal.open(
+              'temp',
+              'w',
+              'MEM',
+              256,
+              256,
+              1,
+              gdal.GDT_Int16
+            )
+            const band = ds.bands.get(1)
+            const shared = new SharedArrayBuffer(1 + 20 * 30 * 2)
+            assert.throws(() => {
+              band.pixels.read(0, 0, 20, 30, shared, { offset: 1 })
+            }, /offset must be a multiple/)
+          })
+          it('should throw error if the buffer is too small after the offset', () => {
+            const ds = gdal.open(
+              'temp',
+              'w',
+              'MEM',
+              256,
+              256,
+              1,
+              gdal.GDT_Byte
+            )
+            const band = ds.bands.get(1)
+            const shared = new SharedArrayBuffer(20 * 30)
+            assert.throws(() => {
+              band.pixels.read(0, 0, 20, 30, shared, { offset: 8 })
+            }, /Array length must be greater than.*/)
+          })
         })
         describe('w/options', () => {
           describe('"buffer_width", "buffer_height"', () => {
@@ -1144,5 +1221,115 @@ describe('gdal.RasterBand', () => {
         })
       })
     })
+    describe('getHistogram()', () => {
+      it('should count the pixel values', () => {
+        const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Byte)
+        const band = ds.bands.get(1)
+        band.fill(5)
+        band.pixels.write(0, 0, 4, 4, new Uint8Array(16).fill(200))
+        const histogram = band.getHistogram()
+        assert.equal(histogram.min, -0.5)
+        assert.equal(histogram.max, 255.5)
+        assert.lengthOf(histogram.buckets, 256)
+        assert.equal(histogram.buckets[5], 256 - 16)
+        assert.equal(histogram.buckets[200], 16)
+      })
+      it('should support custom buckets', () => {
+        const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Byte)
+        const band = ds.bands.get(1)
+        band.fill(5)
+        band.pixels.write(0, 0, 4, 4, new Uint8Array(16).fill(200))
+        const histogram = band.getHistogram({ min: 0, max: 100, buckets: 2 })
+        assert.deepEqual(histogram.buckets, [ 256 - 16, 0 ])
+        const clamped = band.getHistogram({ min: 0, max: 100, buckets: 2, include_out_of_range: true })
+        assert.deepEqual(clamped.buckets, [ 256 - 16, 16 ])
+      })
+      it('should throw error on invalid bounds', () => {
+        const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Byte)
+        const band = ds.bands.get(1)
+        assert.throws(() => {
+          band.getHistogram({ min: 10, max: 0 })
+        })
+      })
+      it('should throw error if dataset already closed', () => {
+        const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Byte)
+        const band = ds.bands.get(1)
+        ds.close()
+        assert.throws(() => {
+          band.getHistogram()
+        })
+      })
+    })
+    describe('getDefaultHistogram() / setDefaultHistogram()', () => {
+      it('should store and return the default histogram', () => {
+        const file = `/vsimem/histogram_${String(Math.random()).substring(2)}.tif`
+        const ds = gdal.open(file, 'w', 'GTiff', 16, 16, 1, gdal.GDT_Byte)
+        const band = ds.bands.get(1)
+        assert.isNull(band.getDefaultHistogram({ force: false }))
+        band.setDefaultHistogram(0, 10, [ 1, 2, 3 ])
+        const histogram = band.getDefaultHistogram({ force: false })
+        assert.equal(histogram.min, 0)
+        assert.equal(histogram.max, 10)
+        assert.deepEqual(histogram.buckets, [ 1, 2, 3 ])
+        ds.close()
+      })
+      it('should compute the histogram when forced', () => {
+        const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Byte)
+        const band = ds.bands.get(1)
+        band.fill(5)
+        const histogram = band.getDefaultHistogram()
+        assert.lengthOf(histogram.buckets, 256)
+        assert.equal(histogram.buckets[5], 256)
+      })
+      it('should throw error if dataset already closed', () => {
+        const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Byte)
+        const band = ds.bands.get(1)
+        ds.close()
+        assert.throws(() => {
+          band.setDefaultHistogram(0, 10, [ 1, 2, 3 ])
+        })
+      })
+    })
+    describe('scanning a dataset opened read-only', () => {
+      // the read-only handle is scanned by several threads, the handle opened for update by GDAL
+      const createFile = () => {
+        const file = `/vsimem/scan_${String(Math.random()).substring(2)}.tif`
+        const ds = gdal.open(file, 'w', 'GTiff', 300, 200, 1, gdal.GDT_Float32)
+        const band = ds.bands.get(1)
+        band.noDataValue = -1000
+        const data = new Float32Array(300 * 200)
+        for (let i = 0; i < data.length; i++) data[i] = i % 7 ? Math.sin(i) * 100 : -1000
+        band.pixels.write(0, 0, 300, 200, data)
+        ds.close()
+        return file
+      }
+      it('should compute the same statistics', () => {
+        const file = createFile()
+        const expected = gdal.open(file, 'r+').bands.get(1).computeStatistics(false)
+        const band = gdal.open(file).bands.get(1)
+        const stats = band.computeStatistics(false)
+        assert.equal(stats.min, expected.min)
+        assert.equal(stats.max, expected.max)
+        assert.closeTo(stats.mean, expected.mean, 1e-9)
+        assert.closeTo(stats.std_dev, expected.std_dev, 1e-9)
+        assert.equal(band.getMetadata().STATISTICS_VALID_PERCENT, '85.71')
+      })
+      it('should compute the same histogram', () => {
+        const file = createFile()
+        const options = { min: -50, max: 50, buckets: 37, include_out_of_range: true }
+        const expected = gdal.open(file, 'r+').bands.get(1).getHistogram(options)
+        const band = gdal.open(file).bands.get(1)
+        assert.deepEqual(band.getHistogram(options), expected)
+        return band.getHistogramAsync(options).then((histogram) => {
+          assert.deepEqual(histogram, expected)
+        })
+      })
+      it('should compute and store the same default histogram', () => {
+        const expected = gdal.open(createFile(), 'r+').bands.get(1).getDefaultHistogram()
+        const band = gdal.open(createFile()).bands.get(1)
+        assert.deepEqual(band.getDefaultHistogram(), expected)
+        assert.deepEqual(band.getDefaultHistogram({ force: false }), expected)
+      })
+    })
   })
 })
@@ -0,0 +1,175 @@
+const gdal = require('../lib/gdal.js')
+const assert = require('chai').assert
+const fs = require('fs')
+
+// The library versions of the utilities appeared in GDAL 2.1
+const [ major, minor ] = gdal.version.split('.').map(Number)
+if (major < 2 || (major === 2 && minor < 1)) {
+  return
+}
+
+describe('gdal', () => {
+  afterEach(gc)
+
+  let src
+  beforeEach(() => {
+    src = gdal.open(`${__dirname}/data/sample.tif`)
+  })
+  afterEach(() => {
+    src.close()
+  })
+
+  describe('translate()', () => {
+    it('should convert a dataset', () => {
+      const out = gdal.translate('', src, [ '-of', 'MEM', '-outsize', '50%', '50%', '-ot', 'Float32' ])
+      assert.instanceOf(out, gdal.Dataset)
+      assert.equal(out.driver.description, 'MEM')
+      assert.equal(out.rasterSize.x, Math.round(src.rasterSize.x / 2))
+      assert.equal(out.bands.get(1).dataType, gdal.GDT_Float32)
+      out.close()
+    })
+    it('should write a file', () => {
+      const file = `/vsimem/translate.${String(Math.random()).substring(2)}.tif`
+      const out = gdal.translate(file, src, [ '-co', 'COMPRESS=DEFLATE' ])
+      assert.equal(out.description, file)
+      assert.equal(out.bands.get(1).pixels.get(10, 10), src.bands.get(1).pixels.get(10, 10))
+      out.close()
+      gdal.open(file).close()
+    })
+    it('should throw on invalid arguments', () => {
+      assert.throws(() => gdal.translate('', src, [ '-of', 'MEM', '-invalid-option' ]))
+      assert.throws(() => gdal.translate('', null), /Dataset/)
+      assert.throws(() => gdal.translate('', src, '-of MEM'), /array/)
+    })
+    it('should keep the source of a VRT alive', () => {
+      const vrt = (() => gdal.translate('', gdal.translate('', src, [ '-of', 'MEM' ]), [ '-of', 'VRT' ]))()
+      gc()
+      assert.equal(vrt.bands.get(1).pixels.get(10, 10), src.bands.get(1).pixels.get(10, 10))
+      vrt.close()
+    })
+  })
+
+  describe('warp()', () => {
+    it('should reproject a dataset', () => {
+      const out = gdal.warp('', [ src ], [ '-of', 'MEM', '-t_srs', 'EPSG:4326' ])
+      assert.instanceOf(out, gdal.Dataset)
+      assert.isTrue(out.srs.isSame(gdal.SpatialReference.fromEPSG(4326)))
+      out.close()
+    })
+    it('should warp into an existing dataset', () => {
+      const dst = gdal.open('temp', 'w', 'MEM', 64, 64, 1, src.bands.get(1).dataType)
+      dst.srs = src.srs
+      dst.geoTransform = src.geoTransform
+      const out = gdal.warp(dst, src, [ '-multi', '-wo', 'NUM_THREADS=2' ])
+      assert.strictEqual(out, dst)
+      assert.equal(dst.bands.get(1).pixels.get(10, 10), src.bands.get(1).pixels.get(10, 10))
+      dst.close()
+    })
+  })
+
+  describe('buildVRT()', () => {
+    it('should build a VRT from datasets', () => {
+      const vrt = gdal.buildVRT('', [ src ])
+      assert.equal(vrt.driver.description, 'VRT')
+      assert.equal(vrt.rasterSize.x, src.rasterSize.x)
+      assert.equal(vrt.bands.get(1).pixels.get(10, 10), src.bands.get(1).pixels.get(10, 10))
+      vrt.close()
+    })
+    it('should close the VRT with its sources', () => {
+      const mem = gdal.translate('', src, [ '-of', 'MEM' ])
+      const vrt = gdal.buildVRT('', [ mem ])
+      assert.equal(vrt.bands.get(1).pixels.get(10, 10), src.bands.get(1).pixels.get(10, 10))
+      mem.close()
+      assert.throws(() => vrt.bands.get(1), /already been destroyed/)
+    })
+    it('should reject in-memory sources from different Datasets', () => {
+      const a = gdal.translate('', src, [ '-of', 'MEM' ])
+      const b = gdal.translate('', src, [ '-of', 'MEM' ])
+      assert.throws(() => gdal.buildVRT('', [ a, b ]), /same Dataset/)
+      const vrt = gdal.buildVRT('', [ a, a ])
+      assert.equal(vrt.rasterSize.x, src.rasterSize.x)
+      a.close()
+      b.close()
+    })
+    it('should build a VRT from filenames', () => {
+      const vrt = gdal.buildVRT('', [ `${__dirname}/data/sample.tif` ], [ '-resolution', 'highest' ])
+      assert.equal(vrt.rasterSize.y, src.rasterSize.y)
+      vrt.close()
+    })
+  })
+
+  describe('vectorTranslate()', () => {
+    let vector
+    beforeEach(() => {
+      vector = gdal.open(`${__dirname}/data/park.geo.json`)
+    })
+    afterEach(() => {
+      vector.close()
+    })
+    it('should convert a vector dataset', () => {
+      const out = gdal.vectorTranslate('', vector, [ '-f', 'Memory' ])
+      assert.instanceOf(out, gdal.Dataset)
+      assert.equal(out.layers.count(), 1)
+      assert.equal(out.layers.get(0).features.count(), vector.layers.get(0).features.count())
+      out.close()
+    })
+    it('should append to an existing dataset', () => {
+      const dst = gdal.open('temp', 'w', 'Memory')
+      const out = gdal.vectorTranslate(dst, vector, [ '-nln', 'parks' ])
+      assert.strictEqual(out, dst)
+      assert.equal(dst.layers.get('parks').features.count(), vector.layers.get(0).features.count())
+      dst.close()
+    })
+    it('should apply a SQL filter', () => {
+      const out = gdal.vectorTranslate('', vector, [ '-f', 'Memory', '-where', '1 = 0' ])
+      assert.equal(out.layers.get(0).features.count(), 0)
+      out.close()
+    })
+  })
+
+  describe('dem()', () => {
+    it('should compute a hillshade', () => {
+      const out = gdal.dem('', src, 'hillshade', [ '-of', 'MEM', '-z', '2' ])
+      assert.instanceOf(out, gdal.Dataset)
+      assert.deepEqual(out.rasterSize, src.rasterSize)
+      assert.equal(out.bands.get(1).dataType, gdal.GDT_Byte)
+      out.close()
+    })
+    it('should require a color file for color-relief', () => {
+      assert.throws(() => {
+        gdal.dem('', src, 'color-relief', [ '-of', 'MEM' ])
+      }, /color_file/)
+    })
+  })
+
+  describe('demWindow()', () => {
+    it('should match the processing of the whole dataset', () => {
+      const full = gdal.dem('', src, 'slope', [ '-of', 'MEM' ])
+      const expected = full.bands.get(1).pixels.read(10, 20, 32, 16)
+      const tile = gdal.demWindow(src.bands.get(1), 'slope', 10, 20, 32, 16)
+      assert.instanceOf(tile, Float32Array)
+      assert.lengthOf(tile, 32 * 16)
+      for (let i = 0; i < tile.length; i++) assert.closeTo(tile[i], expected[i], 1e-4)
+      full.close()
+    })
+    it('should return pixel-interleaved colors for color-relief', () => {
+      const colors = `${__dirname}/data/temp/colors.${String(Math.random()).substring(2)}.tmp.txt`
+      fs.writeFileSync(colors, '0 0 0 255\n255 255 0 0\n')
+      try {
+        const tile = gdal.demWindow(src.bands.get(1), 'color-relief', 0, 0, 8, 8, [], colors)
+        assert.instanceOf(tile, Uint8Array)
+        assert.lengthOf(tile, 8 * 8 * 3)
+      } finally {
+        fs.unlinkSync(colors)
+      }
+    })
+    it('should throw on an invalid window', () => {
+      assert.throws(() => {
+        gdal.demWindow(src.bands.get(1), 'slope', -1, 0, 8, 8)
+      }, RangeError)
+      assert.throws(() => {
+        gdal.demWindow(src.bands.get(1), 'slope', 0, 0, src.rasterSize.x + 1, 8)
+      }, RangeError)
+    })
+  })
+})
@@ -1,5 +1,6 @@
 const gdal = require('../lib/gdal.js')
 const assert = require('chai').assert
+const fs = require('fs')
 
 describe('gdal', () => {
   afterEach(gc)
@@ -607,4 +608,89 @@ describe('gdal', () => {
       it.skip("should throw error if GDAL can't create transformer (skipped)", () => {})
     }
   })
+
+  describe('buildTilePyramid()', () => {
+    let src
+    beforeEach(() => {
+      // a 256x256 gray image in the north of France
+      src = gdal.open('temp', 'w', 'MEM', 256, 256, 1, gdal.GDT_Byte)
+      src.srs = gdal.SpatialReference.fromEPSG(4326)
+      src.geoTransform = [ 2, 0.001, 0, 49, 0, -0.001 ]
+      src.bands.get(1).fill(100)
+    })
+    afterEach(() => {
+      src.close()
+    })
+    const tempName = () => `${__dirname}/data/temp/tiles.${String(Math.random()).substring(2)}.tmp`
+    it('should write a z/x/y directory of tiles', () => {
+      const output = tempName()
+      gdal.buildTilePyramid(src, { minZoom: 8, maxZoom: 10, output, threads: 2 })
+      assert.deepEqual(fs.readdirSync(output).sort(), [ '10', '8', '9' ])
+      // 2.0 to 2.256 degrees of longitude
+      assert.deepEqual(fs.readdirSync(`${output}/10`).sort(), [ '517', '518' ])
+      const x = fs.readdirSync(`${output}/8`)[0]
+      const tile = gdal.open(`${output}/8/${x}/${fs.readdirSync(`${output}/8/${x}`)[0]}`)
+      assert.equal(tile.driver.description, 'PNG')
+      assert.deepEqual(tile.rasterSize, { x: 256, y: 256 })
+      // gray + alpha
+      assert.equal(tile.bands.count(), 2)
+      const gray = tile.bands.get(1).pixels.read(0, 0, 256, 256)
+      const alpha = tile.bands.get(2).pixels.read(0, 0, 256, 256)
+      assert.include(alpha, 0)
+      assert.include(alpha, 255)
+      for (let i = 0; i < alpha.length; i++) if (alpha[i] === 255) assert.equal(gray[i], 100)
+      tile.close()
+    })
+    it('should read a file opened read-only', () => {
+      const file = `${tempName()}.tif`
+      gdal.drivers.get('GTiff').createCopy(file, src).close()
+      const ds = gdal.open(file)
+      const output = tempName()
+      gdal.buildTilePyramid(ds, { minZoom: 10, maxZoom: 10, output, threads: 2 })
+      assert.deepEqual(fs.readdirSync(`${output}/10`).sort(), [ '517', '518' ])
+      ds.close()
+    })
+    it('should use the georeferencing set on a read-only dataset', () => {
+      const file = `${tempName()}.png`
+      const plain = gdal.open('temp', 'w', 'MEM', 256, 256, 1, gdal.GDT_Byte)
+      plain.bands.get(1).fill(100)
+      gdal.drivers.get('PNG').createCopy(file, plain).close()
+      plain.close()
+      const ds = gdal.openBuffer(fs.readFileSync(file))
+      ds.srs = src.srs
+      ds.geoTransform = src.geoTransform
+      const output = tempName()
+      gdal.buildTilePyramid(ds, { minZoom: 10, maxZoom: 10, output, threads: 2 })
+      assert.deepEqual(fs.readdirSync(`${output}/10`).sort(), [ '517', '518' ])
+      ds.close()
+    })
+    it('should write JPEG tiles', () => {
+      const output = tempName()
+      gdal.buildTilePyramid(src, { maxZoom: 3, output, format: 'JPEG' })
+      assert.deepEqual(fs.readdirSync(output).sort(), [ '0', '1', '2', '3' ])
+      assert.isTrue(fs.existsSync(`${output}/0/0/0.jpg`))
+    })
+    it('should write an MBTiles file', () => {
+      const output = `${tempName()}.mbtiles`
+      gdal.buildTilePyramid(src, { minZoom: 9, maxZoom: 11, output, resampling: 'Average' })
+      const mbtiles = gdal.open(output)
+      assert.equal(mbtiles.driver.description, 'MBTiles')
+      assert.equal(mbtiles.bands.get(1).overviews.count(), 2)
+      mbtiles.close()
+    })
+    it('should throw on invalid arguments', () => {
+      assert.throws(() => {
+        gdal.buildTilePyramid(src, { minZoom: 5, maxZoom: 4, output: tempName() })
+      }, /zoom levels/)
+      assert.throws(() => {
+        gdal.buildTilePyramid(src, { maxZoom: 4, output: tempName(), format: 'WEBP' })
+      }, /format must be/)
+      const float = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Float32)
+      float.srs = src.srs
+      assert.throws(() => {
+        gdal.buildTilePyramid(float, { maxZoom: 4, output: tempName() })
+      }, /Byte bands/)
+      float.close()
+    })
+  })
 })
@@ -0,0 +1,90 @@
+const gdal = require('../lib/gdal.js')
+const fs = require('fs')
+const path = require('path')
+const assert = require('chai').assert
+
+describe('Open', () => {
+  afterEach(gc)
+
+  describe('Buffer', () => {
+    const filename = path.join(__dirname, 'data/sample.tif')
+    const checksum = (ds) => gdal.checksumImage(ds.bands.get(1))
+    let expected
+    before(() => {
+      const ds = gdal.open(filename)
+      expected = checksum(ds)
+      ds.close()
+    })
+
+    it('should open the content of a Buffer', () => {
+      const ds = gdal.openBuffer(fs.readFileSync(filename))
+      assert.equal(ds.driver.description, 'GTiff')
+      assert.equal(ds.rasterSize.x, 984)
+      assert.equal(ds.rasterSize.y, 804)
+      assert.equal(checksum(ds), expected)
+      ds.close()
+    })
+
+    it('should delete the in-memory file when the dataset is closed', () => {
+      const ds = gdal.openBuffer(fs.readFileSync(filename))
+      const description = ds.description
+      assert.match(description, /^\/vsimem\//)
+      ds.close()
+      assert.throws(() => {
+        gdal.open(description)
+      }, /Error opening dataset/)
+    })
+
+    it('should keep the Buffer alive while the dataset is open', () => {
+      const ds = gdal.openBuffer(fs.readFileSync(filename))
+      gc()
+      assert.equal(checksum(ds), expected)
+      ds.close()
+    })
+
+    it('should use the given drivers', () => {
+      const ds = gdal.openBuffer(fs.readFileSync(filename), { driver: [ 'PNG', 'GTiff' ] })
+      assert.equal(ds.driver.description, 'GTiff')
+      ds.close()
+      assert.throws(() => {
+        gdal.openBuffer(fs.readFileSync(filename), { driver: 'PNG' })
+      }, /Error opening dataset/)
+      assert.throws(() => {
+        gdal.openBuffer(fs.readFileSync(filename), { driver: 'NOT_A_DRIVER' })
+      }, /Cannot find driver/)
+    })
+
+    it('should throw if the argument is not a Buffer', () => {
+      assert.throws(() => {
+        gdal.openBuffer(filename)
+      }, /must be a Buffer/)
+    })
+
+    it('should open asynchronously', () =>
+      gdal.openBufferAsync(fs.readFileSync(filename)).then((ds) => {
+        assert.equal(checksum(ds), expected)
+        ds.close()
+      })
+    )
+
+    it('should open asynchronously with a callback', (done) => {
+      gdal.openBufferAsync(fs.readFileSync(filename), { driver: 'GTiff' }, (err, ds) => {
+        try {
+          assert.notOk(err)
+          assert.equal(checksum(ds), expected)
+          ds.close()
+          done()
+        } catch (e) {
+          done(e)
+        }
+      })
+    })
+
+    it('should reject if the content cannot be opened', () =>
+      gdal.openBufferAsync(Buffer.from('not an image')).then(
+        () => assert.fail('should have been rejected'),
+        (err) => assert.match(String(err), /Error opening dataset/)
+      )
+    )
+  })
+})